@@ -125,6 +125,24 @@ serial_safe_baud:value("1000000")
 serial_safe_baud.default = "115200"
 serial_safe_baud.rmempty = false
 
+local serial_auto_baud = s:option(
+    Flag,
+    "serial_auto_baud",
+    translate("Calibrate Baud Rate"),
+    translate("Try the rates up to the Serial Baud Rate after each handshake and keep the fastest reliable one.")
+)
+serial_auto_baud.rmempty = false
+serial_auto_baud.default = "0"
+
+local serial_bond_ports = s:option(
+    Value,
+    "serial_bond_ports",
+    translate("Bonded Serial Ports"),
+    translate("Space separated extra UARTs wired to the same MCU; frames are striped over all of them at the Serial Baud Rate.")
+)
+serial_bond_ports.placeholder = "/dev/ttyS1"
+serial_bond_ports.rmempty = true
+
 local cloud_host = s:option(Value, "cloud_host", translate("Cloud Host"))
 cloud_host.placeholder = "127.0.0.1"
 cloud_host.rmempty = false
@@ -324,6 +342,11 @@ cloud_acl_option(
     "Allow digital mode",
     "Allow access to br/d/<pin>/mode."
 )
+cloud_acl_option(
+    "cloud_allow_digital_subscribe",
+    "Allow digital subscribe",
+    "Allow pin-change subscriptions via br/d/<pin>/subscribe."
+)
 cloud_acl_option(
     "cloud_allow_analog_write",
     "Allow analog write",
@@ -334,6 +357,76 @@ cloud_acl_option(
     "Allow analog read",
     "Allow reads via br/a/<pin>/read."
 )
+cloud_acl_option(
+    "cloud_allow_stream_start",
+    "Allow stream start",
+    "Allow analog sampling streams via br/stream/start."
+)
+cloud_acl_option(
+    "cloud_allow_stream_stop",
+    "Allow stream stop",
+    "Allow stopping sampling streams via br/stream/stop."
+)
+cloud_acl_option(
+    "cloud_allow_stream_aggregate",
+    "Allow stream aggregation",
+    "Allow configuring on-MCU aggregation windows via br/stream/aggregate."
+)
+cloud_acl_option(
+    "cloud_allow_telemetry_job",
+    "Allow telemetry jobs",
+    "Allow configuring report-by-exception jobs via br/telemetry/job."
+)
+cloud_acl_option(
+    "cloud_allow_reflex_rule",
+    "Allow reflex rules",
+    "Allow uploading local MCU reflex rules via br/reflex/rule."
+)
+cloud_acl_option(
+    "cloud_allow_schedule_gpio",
+    "Allow scheduled GPIO",
+    "Allow queuing time-triggered GPIO writes via br/schedule/gpio."
+)
+cloud_acl_option(
+    "cloud_allow_wave_load",
+    "Allow waveform upload",
+    "Allow uploading step sequences or PWM duty tables via br/wave/load."
+)
+cloud_acl_option(
+    "cloud_allow_wave_start",
+    "Allow waveform start",
+    "Allow starting waveform playback via br/wave/start."
+)
+cloud_acl_option(
+    "cloud_allow_wave_stop",
+    "Allow waveform stop",
+    "Allow stopping waveform playback via br/wave/stop."
+)
+cloud_acl_option(
+    "cloud_allow_i2c_begin",
+    "Allow I2C begin",
+    "Allow starting the MCU I2C master via br/i2c/begin."
+)
+cloud_acl_option(
+    "cloud_allow_i2c_end",
+    "Allow I2C end",
+    "Allow releasing the MCU I2C bus via br/i2c/end."
+)
+cloud_acl_option(
+    "cloud_allow_i2c_transfer",
+    "Allow I2C transfers",
+    "Allow raw I2C writes and reads via br/i2c/transfer."
+)
+cloud_acl_option(
+    "cloud_allow_i2c_registers",
+    "Allow I2C register batches",
+    "Allow batched register reads via br/i2c/registers."
+)
+cloud_acl_option(
+    "cloud_allow_i2c_burst",
+    "Allow I2C bursts",
+    "Allow chunked block reads via br/i2c/burst."
+)
 
 local serial_secret = s:option(Value, "serial_shared_secret", translate("Serial Shared Secret"))
 serial_secret.password = true
@@ -0,0 +1,71 @@
+/*
+ * GpioBenchmark.ino - Per-operation cost of the bridge GPIO fast path
+ *
+ * Times the Arduino digitalWrite/digitalRead/pinMode calls against the
+ * bridge::hal fast-GPIO layer used by the dispatch handlers and prints the
+ * average cost of each in nanoseconds. Needs no Linux side: open the serial
+ * monitor at 115200 baud. Results are only meaningful on boards with a
+ * direct-port pin map (hal/PinMap.h); elsewhere both columns match.
+ */
+#include <Bridge.h>
+#include <hal/PinMap.h>
+#include <hal/hal.h>
+
+namespace {
+constexpr uint8_t kPin = 13;
+constexpr uint16_t kIterations = 10000;
+
+// Average ns per call of @p op, with the empty-loop overhead removed.
+template <typename Op>
+uint32_t timeNs(Op op) {
+  uint32_t start = micros();
+  for (volatile uint16_t i = 0; i < kIterations; i = i + 1) {
+  }
+  const uint32_t overhead = micros() - start;
+  start = micros();
+  for (volatile uint16_t i = 0; i < kIterations; i = i + 1) op(i);
+  const uint32_t elapsed = micros() - start;
+  return elapsed > overhead
+             ? static_cast<uint32_t>((elapsed - overhead) * 1000ULL /
+                                     kIterations)
+             : 0U;
+}
+
+void report(const char* name, uint32_t arduino_ns, uint32_t fast_ns) {
+  Serial.print(name);
+  Serial.print(F(": arduino "));
+  Serial.print(arduino_ns);
+  Serial.print(F(" ns, fast "));
+  Serial.print(fast_ns);
+  Serial.println(F(" ns"));
+}
+}  // namespace
+
+void setup() {
+  Serial.begin(115200);
+  while (!Serial) {
+  }
+  Serial.print(F("direct ports: "));
+  Serial.println(bridge::hal::pinmap::HAS_DIRECT_PORTS ? F("yes") : F("no"));
+
+  volatile int sink = 0;
+  report("pinMode",
+         timeNs([](uint16_t i) { pinMode(kPin, (i & 1U) ? OUTPUT : INPUT); }),
+         timeNs([](uint16_t i) {
+           bridge::hal::fastPinMode(kPin, (i & 1U) ? OUTPUT : INPUT);
+         }));
+  pinMode(kPin, OUTPUT);
+  report("digitalWrite",
+         timeNs([](uint16_t i) { digitalWrite(kPin, (i & 1U) ? HIGH : LOW); }),
+         timeNs([](uint16_t i) {
+           bridge::hal::fastDigitalWrite(kPin, (i & 1U) ? HIGH : LOW);
+         }));
+  report("digitalRead",
+         timeNs([&sink](uint16_t) { sink = sink + digitalRead(kPin); }),
+         timeNs([&sink](uint16_t) {
+           sink = sink + bridge::hal::fastDigitalRead(kPin);
+         }));
+  digitalWrite(kPin, LOW);
+}
+
+void loop() {}
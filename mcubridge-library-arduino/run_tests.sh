@@ -84,7 +84,7 @@ BUILD_DIR="build-host-local"
 OBJ_DIR="${BUILD_DIR}/objs"
 mkdir -p "${OBJ_DIR}"
 
-COMMON_FLAGS="-O2 -g -Wall -DBRIDGE_HOST_TEST=1 -DUNITY_INCLUDE_DOUBLE -DBRIDGE_ENABLE_SPI=1 -DWOLFSSL_USER_SETTINGS -DETL_NO_STL -Isrc -Isrc/config -Isrc/protocol -Itests/Unity/src -I../tools/arduino_stub/include -I$ETL_PATH -I$ETL_PATH/include -I$ETL_PATH/arduino -I$WOLFSSL_PATH -I$PACKETSERIAL_PATH -I$PACKETSERIAL_PATH/src"
+COMMON_FLAGS="-O2 -g -Wall -DBRIDGE_HOST_TEST=1 -DUNITY_INCLUDE_DOUBLE -DBRIDGE_ENABLE_SPI=1 -DBRIDGE_ENABLE_LOOP_PROFILER=1 -DBRIDGE_ENABLE_I2C=1 -DBRIDGE_ENABLE_EEPROM=1 -DBRIDGE_ENABLE_FRAME_TRACE=1 -DBRIDGE_BOND_MAX_LINKS=2 -DBRIDGE_ENABLE_THREADED=1 -pthread -DWOLFSSL_USER_SETTINGS -DETL_NO_STL -Isrc -Isrc/config -Isrc/protocol -Itests/Unity/src -I../tools/arduino_stub/include -I$ETL_PATH -I$ETL_PATH/include -I$ETL_PATH/arduino -I$WOLFSSL_PATH -I$PACKETSERIAL_PATH -I$PACKETSERIAL_PATH/src"
 
 SOURCES=(
     "src/Instantiations.cpp"
@@ -96,9 +96,21 @@ SOURCES=(
     "src/services/Console.cpp"
     "src/services/DataStore.cpp"
     "src/services/Mailbox.cpp"
+    "src/services/PinEvents.cpp"
+    "src/services/Events.cpp"
+    "src/services/Sampler.cpp"
+    "src/services/Telemetry.cpp"
+    "src/services/Aggregator.cpp"
+    "src/services/Reflex.cpp"
+    "src/services/Timeline.cpp"
+    "src/services/Waveform.cpp"
+    "src/services/LoopProfiler.cpp"
     "src/services/FileSystem.cpp"
     "src/services/Process.cpp"
     "src/services/SPIService.cpp"
+    "src/services/I2CService.cpp"
+    "src/services/KVStore.cpp"
+    "src/services/FrameTrace.cpp"
     "../tools/arduino_stub/BridgeFaultInjection.cpp"
     "../tools/arduino_stub/ArduinoStubs.cpp"
     "tests/test_host_filesystem_mock.cpp"
@@ -8,17 +8,32 @@
 #include <wolfssl/wolfcrypt/types.h>
 
 #include "hal/ArchTraits.h"
+#include "hal/PinMap.h"
 #include "security/security.h"
+#include "services/Aggregator.h"
 #include "services/Console.h"
 #include "services/DataStore.h"
+#include "services/Events.h"
+#include "services/FrameTrace.h"
+#include "services/I2CService.h"
+#include "services/KVStore.h"
 #include "services/FileSystem.h"
 #include "services/Mailbox.h"
+#include "services/PinEvents.h"
 #include "services/Process.h"
+#include "services/LoopProfiler.h"
+#include "services/Reflex.h"
 #include "services/SPIService.h"
+#include "services/Sampler.h"
+#include "services/ServiceSet.h"
+#include "services/Telemetry.h"
+#include "services/Timeline.h"
+#include "services/Waveform.h"
 
 namespace etl {
 void __attribute__((weak)) handle_error(const etl::exception& e) {
-  BridgeClass::ErrorPolicy::handle(Bridge, e);
+  BridgeClass* bridge = BridgeClass::current();
+  if (bridge != nullptr) BridgeClass::ErrorPolicy::handle(*bridge, e);
 }
 }  // namespace etl
 
@@ -28,6 +43,13 @@ BridgeClass::BridgeClass(Stream& stream)
                      etl::span<uint8_t>(_rx_buffer.data(), _rx_buffer.size())),
       _tx_envelope(rpc_pb_RpcEnvelope_init_zero) {}
 
+BridgeClass::~BridgeClass() {
+#if BRIDGE_ENABLE_THREADED
+  stopTask();
+#endif
+  if (_current == this) _current = nullptr;
+}
+
 bool BridgeClass::_preDispatch(const bridge::router::CommandContext& ctx,
                                bool needs_ack, bool retransmit_on_dup) {
   if (needs_ack) {
@@ -77,6 +99,53 @@ void BridgeClass::_onCmd_GetFreeMemory(
       },
       false, true);
 }
+void BridgeClass::_onCmd_GetMemoryProfile(
+    BridgeClass& self, const bridge::router::CommandContext& ctx) {
+  self._dispatchCmd<_NoPayload>(
+      ctx,
+      [&self](const bridge::router::CommandContext& c) {
+        self._handleGetMemoryProfile(c);
+      },
+      false, true);
+}
+#if BRIDGE_ENABLE_FRAME_TRACE
+void BridgeClass::_onCmd_GetFrameTrace(
+    BridgeClass& self, const bridge::router::CommandContext& ctx) {
+  self._dispatchCmd<rpc_pb_FrameTraceQuery>(
+      ctx,
+      [&self](const bridge::router::CommandContext& c,
+              const rpc_pb_FrameTraceQuery& m) {
+        self._handleGetFrameTrace(c, m);
+      },
+      false, true);
+}
+#endif
+void BridgeClass::_onCmd_GetLinkStats(
+    BridgeClass& self, const bridge::router::CommandContext& ctx) {
+  self._dispatchCmd<rpc_pb_LinkStatsQuery>(
+      ctx,
+      [&self](const bridge::router::CommandContext& c,
+              const rpc_pb_LinkStatsQuery& m) {
+        self._handleGetLinkStats(c, m);
+      },
+      false, true);
+}
+void BridgeClass::_onCmd_LinkProbe(BridgeClass& self,
+                                   const bridge::router::CommandContext& ctx) {
+  self._dispatchCmd<rpc_pb_LinkProbe>(
+      ctx,
+      [&self](const bridge::router::CommandContext& c,
+              const rpc_pb_LinkProbe& m) { self._handleLinkProbe(c, m); },
+      false, true);
+}
+void BridgeClass::_onCmd_ClockSync(BridgeClass& self,
+                                   const bridge::router::CommandContext& ctx) {
+  self._dispatchCmd<rpc_pb_ClockSync>(
+      ctx,
+      [&self](const bridge::router::CommandContext& c,
+              const rpc_pb_ClockSync& m) { self._handleClockSync(c, m); },
+      false, true);
+}
 void BridgeClass::_onCmd_GetCapabilities(
     BridgeClass& self, const bridge::router::CommandContext& ctx) {
   self._dispatchCmd<_NoPayload>(
@@ -119,9 +188,9 @@ void BridgeClass::_onCmd_LinkSync(BridgeClass& self,
 void BridgeClass::_onCmd_SetBaudrate(
     BridgeClass& self, const bridge::router::CommandContext& ctx) {
   self._dispatchCmd<rpc_pb_SetBaudratePacket>(
-      ctx, [&self](const bridge::router::CommandContext&,
+      ctx, [&self](const bridge::router::CommandContext& c,
                    const rpc_pb_SetBaudratePacket& m) {
-        self._handleSetBaudrate(m);
+        self._handleSetBaudrate(c, m);
       });
 }
 void BridgeClass::_onCmd_EnterBootloader(
@@ -133,7 +202,8 @@ void BridgeClass::_onCmd_EnterBootloader(
       });
 }
 // Static handlers (_handleSetPinMode, _handleDigitalWrite, _handleAnalogWrite,
-// _handleConsoleWrite): []  no-capture lambda is correct (static members).
+// _handleDigitalWriteMask, _handleConsoleWrite): []  no-capture lambda is
+// correct (static members).
 void BridgeClass::_onCmd_SetPinMode(BridgeClass& self,
                                     const bridge::router::CommandContext& ctx) {
   self._dispatchCmd<rpc_pb_PinMode>(
@@ -153,6 +223,30 @@ void BridgeClass::_onCmd_AnalogWrite(
       ctx, [](const bridge::router::CommandContext&,
               const rpc_pb_AnalogWrite& m) { _handleAnalogWrite(m); });
 }
+void BridgeClass::_onCmd_DigitalWriteMask(
+    BridgeClass& self, const bridge::router::CommandContext& ctx) {
+  self._dispatchCmd<rpc_pb_DigitalWriteMask>(
+      ctx, [](const bridge::router::CommandContext&,
+              const rpc_pb_DigitalWriteMask& m) {
+        _handleDigitalWriteMask(m);
+      });
+}
+void BridgeClass::_onCmd_GpioBatch(BridgeClass& self,
+                                   const bridge::router::CommandContext& ctx) {
+  self._dispatchCmd<rpc_pb_GpioBatch>(
+      ctx, [&self](const bridge::router::CommandContext&,
+                   const rpc_pb_GpioBatch& m) { self._handleGpioBatch(m); });
+}
+#if BRIDGE_ENABLE_PIN_EVENTS
+void BridgeClass::_onCmd_PinSubscribe(
+    BridgeClass& self, const bridge::router::CommandContext& ctx) {
+  self._dispatchCmd<rpc_pb_PinSubscribe>(
+      ctx, [&self](const bridge::router::CommandContext&,
+                   const rpc_pb_PinSubscribe& m) {
+        self._handlePinSubscribe(m);
+      });
+}
+#endif
 void BridgeClass::_onCmd_ConsoleWrite(
     BridgeClass& self, const bridge::router::CommandContext& ctx) {
   self._dispatchCmd<rpc_pb_ConsoleWrite>(
@@ -177,14 +271,24 @@ void BridgeClass::_onCmd_PinRead(BridgeClass& self,
       },
       false, true);
 }
+void BridgeClass::_onCmd_DigitalReadPort(
+    BridgeClass& self, const bridge::router::CommandContext& ctx) {
+  self._dispatchCmd<rpc_pb_DigitalReadPort>(
+      ctx,
+      [&self](const bridge::router::CommandContext& c,
+              const rpc_pb_DigitalReadPort& m) {
+        self._handleDigitalReadPort(c, m);
+      },
+      false, true);
+}
 
 #if BRIDGE_ENABLE_DATASTORE
 void BridgeClass::_onCmd_DatastoreGetResp(
     BridgeClass& self, const bridge::router::CommandContext& ctx) {
   self._dispatchCmd<rpc_pb_DatastoreGetResponse>(
-      ctx, [](const bridge::router::CommandContext& c,
-              const rpc_pb_DatastoreGetResponse& m) {
-        _handleDataStoreGetResponse(c, m);
+      ctx, [&self](const bridge::router::CommandContext& c,
+                   const rpc_pb_DatastoreGetResponse& m) {
+        self._requests.complete(c.sequence_id, c.raw_command, m);
       });
 }
 #endif
@@ -245,10 +349,13 @@ void BridgeClass::_onCmd_FileRemove(BridgeClass& self,
 }
 void BridgeClass::_onCmd_FileReadResp(
     BridgeClass& self, const bridge::router::CommandContext& ctx) {
+  // One response per chunk; the empty chunk that marks EOF ends the request.
   self._dispatchCmd<rpc_pb_FileReadResponse>(
-      ctx,
-      [](const bridge::router::CommandContext& c,
-         const rpc_pb_FileReadResponse& m) { _handleFileReadResponse(c, m); });
+      ctx, [&self](const bridge::router::CommandContext& c,
+                   const rpc_pb_FileReadResponse& m) {
+        self._requests.complete(c.sequence_id, c.raw_command, m,
+                                m.content.size == 0U);
+      });
 }
 #endif
 
@@ -262,17 +369,17 @@ void BridgeClass::_onCmd_ProcessKill(
 void BridgeClass::_onCmd_ProcessRunAsyncResp(
     BridgeClass& self, const bridge::router::CommandContext& ctx) {
   self._dispatchCmd<rpc_pb_ProcessRunAsyncResponse>(
-      ctx, [](const bridge::router::CommandContext& c,
-              const rpc_pb_ProcessRunAsyncResponse& m) {
-        _handleProcessRunAsyncResponse(c, m);
+      ctx, [&self](const bridge::router::CommandContext& c,
+                   const rpc_pb_ProcessRunAsyncResponse& m) {
+        self._requests.complete(c.sequence_id, c.raw_command, m);
       });
 }
 void BridgeClass::_onCmd_ProcessPollResp(
     BridgeClass& self, const bridge::router::CommandContext& ctx) {
   self._dispatchCmd<rpc_pb_ProcessPollResponse>(
-      ctx, [](const bridge::router::CommandContext& c,
-              const rpc_pb_ProcessPollResponse& m) {
-        _handleProcessPollResponse(c, m);
+      ctx, [&self](const bridge::router::CommandContext& c,
+                   const rpc_pb_ProcessPollResponse& m) {
+        self._requests.complete(c.sequence_id, c.raw_command, m);
       });
 }
 #endif
@@ -308,6 +415,125 @@ void BridgeClass::_onCmd_SpiSetConfig(
               const rpc_pb_SpiConfig& m) { _handleSpiSetConfig(m); });
 }
 #endif
+#if BRIDGE_ENABLE_I2C
+void BridgeClass::_onCmd_I2cBegin(BridgeClass& self,
+                                  const bridge::router::CommandContext& ctx) {
+  self._dispatchCmd<rpc_pb_I2cConfig>(
+      ctx, [](const bridge::router::CommandContext&,
+              const rpc_pb_I2cConfig& m) { I2CService.begin(m); });
+}
+void BridgeClass::_onCmd_I2cEnd(BridgeClass& self,
+                                const bridge::router::CommandContext& ctx) {
+  self._dispatchCmd<_NoPayload>(
+      ctx, [](const bridge::router::CommandContext&) { I2CService.end(); });
+}
+void BridgeClass::_onCmd_I2cTransfer(
+    BridgeClass& self, const bridge::router::CommandContext& ctx) {
+  self._dispatchCmd<rpc_pb_I2cTransfer>(
+      ctx,
+      [&self](const bridge::router::CommandContext& c,
+              const rpc_pb_I2cTransfer& m) { self._handleI2cTransfer(c, m); },
+      false, true);
+}
+void BridgeClass::_onCmd_I2cReadRegisters(
+    BridgeClass& self, const bridge::router::CommandContext& ctx) {
+  self._dispatchCmd<rpc_pb_I2cReadRegisters>(
+      ctx,
+      [&self](const bridge::router::CommandContext& c,
+              const rpc_pb_I2cReadRegisters& m) {
+        self._handleI2cReadRegisters(c, m);
+      },
+      false, true);
+}
+#endif
+#if BRIDGE_ENABLE_SAMPLER
+void BridgeClass::_onCmd_StreamStart(
+    BridgeClass& self, const bridge::router::CommandContext& ctx) {
+  self._dispatchCmd<rpc_pb_StreamConfig>(
+      ctx, [&self](const bridge::router::CommandContext&,
+                   const rpc_pb_StreamConfig& m) {
+        self._handleStreamStart(m);
+      });
+}
+void BridgeClass::_onCmd_StreamStop(
+    BridgeClass& self, const bridge::router::CommandContext& ctx) {
+  self._dispatchCmd<_NoPayload>(
+      ctx, [](const bridge::router::CommandContext&) { Sampler.stop(); });
+}
+#endif
+#if BRIDGE_ENABLE_TELEMETRY
+void BridgeClass::_onCmd_TelemetryJob(
+    BridgeClass& self, const bridge::router::CommandContext& ctx) {
+  self._dispatchCmd<rpc_pb_TelemetryJob>(
+      ctx, [&self](const bridge::router::CommandContext&,
+                   const rpc_pb_TelemetryJob& m) {
+        self._handleTelemetryJob(m);
+      });
+}
+#endif
+#if BRIDGE_ENABLE_AGGREGATOR
+void BridgeClass::_onCmd_AggregateConfig(
+    BridgeClass& self, const bridge::router::CommandContext& ctx) {
+  self._dispatchCmd<rpc_pb_AggregateConfig>(
+      ctx, [&self](const bridge::router::CommandContext&,
+                   const rpc_pb_AggregateConfig& m) {
+        self._handleAggregateConfig(m);
+      });
+}
+#endif
+#if BRIDGE_ENABLE_REFLEX
+void BridgeClass::_onCmd_ReflexRule(
+    BridgeClass& self, const bridge::router::CommandContext& ctx) {
+  self._dispatchCmd<rpc_pb_ReflexRule>(
+      ctx, [&self](const bridge::router::CommandContext&,
+                   const rpc_pb_ReflexRule& m) { self._handleReflexRule(m); });
+}
+#endif
+#if BRIDGE_ENABLE_TIMELINE
+void BridgeClass::_onCmd_ScheduleGpio(
+    BridgeClass& self, const bridge::router::CommandContext& ctx) {
+  self._dispatchCmd<rpc_pb_ScheduleGpio>(
+      ctx, [&self](const bridge::router::CommandContext&,
+                   const rpc_pb_ScheduleGpio& m) {
+        self._handleScheduleGpio(m);
+      });
+}
+#endif
+#if BRIDGE_ENABLE_WAVEFORM
+void BridgeClass::_onCmd_WaveformLoad(
+    BridgeClass& self, const bridge::router::CommandContext& ctx) {
+  self._dispatchCmd<rpc_pb_WaveformLoad>(
+      ctx, [&self](const bridge::router::CommandContext&,
+                   const rpc_pb_WaveformLoad& m) {
+        self._handleWaveformLoad(m);
+      });
+}
+void BridgeClass::_onCmd_WaveformStart(
+    BridgeClass& self, const bridge::router::CommandContext& ctx) {
+  self._dispatchCmd<rpc_pb_WaveformStart>(
+      ctx, [&self](const bridge::router::CommandContext&,
+                   const rpc_pb_WaveformStart& m) {
+        self._handleWaveformStart(m);
+      });
+}
+void BridgeClass::_onCmd_WaveformStop(
+    BridgeClass& self, const bridge::router::CommandContext& ctx) {
+  self._dispatchCmd<_NoPayload>(
+      ctx, [](const bridge::router::CommandContext&) { Waveform.stop(); });
+}
+#endif
+#if BRIDGE_ENABLE_LOOP_PROFILER
+void BridgeClass::_onCmd_GetLoopProfile(
+    BridgeClass& self, const bridge::router::CommandContext& ctx) {
+  self._dispatchCmd<rpc_pb_LoopProfileQuery>(
+      ctx,
+      [&self](const bridge::router::CommandContext& c,
+              const rpc_pb_LoopProfileQuery& m) {
+        self._handleGetLoopProfile(c, m);
+      },
+      false, true);
+}
+#endif
 
 // =============================================================================
 // [ETL] Static dispatch table — sorted by command_id for O(log N) lower_bound.
@@ -336,6 +562,12 @@ const BridgeClass::DispatchEntry BridgeClass::k_dispatch_table[] = {
     {rpc::to_underlying(rpc::CommandId::CMD_ANALOG_WRITE),       &BridgeClass::_onCmd_AnalogWrite},
     {rpc::to_underlying(rpc::CommandId::CMD_DIGITAL_READ),       &BridgeClass::_onCmd_PinRead},
     {rpc::to_underlying(rpc::CommandId::CMD_ANALOG_READ),        &BridgeClass::_onCmd_PinRead},
+    {rpc::to_underlying(rpc::CommandId::CMD_DIGITAL_WRITE_MASK), &BridgeClass::_onCmd_DigitalWriteMask},
+    {rpc::to_underlying(rpc::CommandId::CMD_DIGITAL_READ_PORT),  &BridgeClass::_onCmd_DigitalReadPort},
+#if BRIDGE_ENABLE_PIN_EVENTS
+    {rpc::to_underlying(rpc::CommandId::CMD_PIN_SUBSCRIBE),      &BridgeClass::_onCmd_PinSubscribe},
+#endif
+    {rpc::to_underlying(rpc::CommandId::CMD_GPIO_BATCH),         &BridgeClass::_onCmd_GpioBatch},
     {rpc::to_underlying(rpc::CommandId::CMD_CONSOLE_WRITE),      &BridgeClass::_onCmd_ConsoleWrite},
 #if BRIDGE_ENABLE_DATASTORE
     {rpc::to_underlying(rpc::CommandId::CMD_DATASTORE_GET_RESP), &BridgeClass::_onCmd_DatastoreGetResp},
@@ -362,6 +594,43 @@ const BridgeClass::DispatchEntry BridgeClass::k_dispatch_table[] = {
     {rpc::to_underlying(rpc::CommandId::CMD_SPI_END),            &BridgeClass::_onCmd_SpiEnd},
     {rpc::to_underlying(rpc::CommandId::CMD_SPI_SET_CONFIG),     &BridgeClass::_onCmd_SpiSetConfig},
 #endif
+#if BRIDGE_ENABLE_I2C
+    {rpc::to_underlying(rpc::CommandId::CMD_I2C_BEGIN),          &BridgeClass::_onCmd_I2cBegin},
+    {rpc::to_underlying(rpc::CommandId::CMD_I2C_END),            &BridgeClass::_onCmd_I2cEnd},
+    {rpc::to_underlying(rpc::CommandId::CMD_I2C_TRANSFER),       &BridgeClass::_onCmd_I2cTransfer},
+    {rpc::to_underlying(rpc::CommandId::CMD_I2C_READ_REGISTERS), &BridgeClass::_onCmd_I2cReadRegisters},
+#endif
+#if BRIDGE_ENABLE_SAMPLER
+    {rpc::to_underlying(rpc::CommandId::CMD_STREAM_START),       &BridgeClass::_onCmd_StreamStart},
+    {rpc::to_underlying(rpc::CommandId::CMD_STREAM_STOP),        &BridgeClass::_onCmd_StreamStop},
+#endif
+#if BRIDGE_ENABLE_TELEMETRY
+    {rpc::to_underlying(rpc::CommandId::CMD_TELEMETRY_JOB),      &BridgeClass::_onCmd_TelemetryJob},
+#endif
+#if BRIDGE_ENABLE_AGGREGATOR
+    {rpc::to_underlying(rpc::CommandId::CMD_AGGREGATE_CONFIG),   &BridgeClass::_onCmd_AggregateConfig},
+#endif
+#if BRIDGE_ENABLE_REFLEX
+    {rpc::to_underlying(rpc::CommandId::CMD_REFLEX_RULE),        &BridgeClass::_onCmd_ReflexRule},
+#endif
+    {rpc::to_underlying(rpc::CommandId::CMD_CLOCK_SYNC),         &BridgeClass::_onCmd_ClockSync},
+#if BRIDGE_ENABLE_TIMELINE
+    {rpc::to_underlying(rpc::CommandId::CMD_SCHEDULE_GPIO),      &BridgeClass::_onCmd_ScheduleGpio},
+#endif
+#if BRIDGE_ENABLE_WAVEFORM
+    {rpc::to_underlying(rpc::CommandId::CMD_WAVEFORM_LOAD),      &BridgeClass::_onCmd_WaveformLoad},
+    {rpc::to_underlying(rpc::CommandId::CMD_WAVEFORM_START),     &BridgeClass::_onCmd_WaveformStart},
+    {rpc::to_underlying(rpc::CommandId::CMD_WAVEFORM_STOP),      &BridgeClass::_onCmd_WaveformStop},
+#endif
+    {rpc::to_underlying(rpc::CommandId::CMD_GET_MEMORY_PROFILE), &BridgeClass::_onCmd_GetMemoryProfile},
+#if BRIDGE_ENABLE_LOOP_PROFILER
+    {rpc::to_underlying(rpc::CommandId::CMD_GET_LOOP_PROFILE),   &BridgeClass::_onCmd_GetLoopProfile},
+#endif
+    {rpc::to_underlying(rpc::CommandId::CMD_GET_LINK_STATS),     &BridgeClass::_onCmd_GetLinkStats},
+#if BRIDGE_ENABLE_FRAME_TRACE
+    {rpc::to_underlying(rpc::CommandId::CMD_GET_FRAME_TRACE),    &BridgeClass::_onCmd_GetFrameTrace},
+#endif
+    {rpc::to_underlying(rpc::CommandId::CMD_LINK_PROBE),         &BridgeClass::_onCmd_LinkProbe},
 };
 // clang-format on
 const size_t BridgeClass::k_dispatch_table_size =
@@ -370,14 +639,32 @@ const size_t BridgeClass::k_dispatch_table_size =
 
 void BridgeClass::_dispatchCommand(const rpc_pb_RpcEnvelope& envelope) {
   const uint16_t cmd_id = envelope.command_id;
+  // Responses to our requests echo our sequence ids, not Linux's: they are
+  // never duplicates of a Linux command, and stay out of the history.
+  const bool awaited = _requests.awaits(envelope.sequence_id, cmd_id);
   auto it =
       etl::find(_rx_history.begin(), _rx_history.end(), envelope.sequence_id);
-  const bool is_duplicate = (it != _rx_history.end());
+  const bool is_duplicate = !awaited && (it != _rx_history.end());
   const bridge::router::CommandContext ctx(&envelope, cmd_id,
                                            envelope.sequence_id, is_duplicate,
                                            rpc::requires_ack(cmd_id));
 
-  if (!is_duplicate) {
+#if BRIDGE_ENABLE_FRAME_TIMESTAMPS
+  if (envelope.sent_us != 0U) {
+    _frame_timestamps = true;
+    _echo_seq = static_cast<uint16_t>(envelope.sequence_id);
+    _echo_sent_us = envelope.sent_us;
+    _echo_rx_us = _rx_frame_us;
+  }
+#endif
+  _trace(rpc_pb_FrameTraceDirection_FRAME_TRACE_RX, cmd_id,
+         envelope.sequence_id,
+         envelope.payload_type.encrypted_payload_with_tag.size,
+         is_duplicate ? rpc_pb_FrameTraceResult_FRAME_TRACE_DUPLICATE
+                      : rpc_pb_FrameTraceResult_FRAME_TRACE_OK);
+  if (is_duplicate) {
+    countLink(LinkCounter::RX_DUPLICATES);
+  } else if (!awaited) {
     if (_rx_history.full()) _rx_history.pop();
     _rx_history.push(envelope.sequence_id);
   }
@@ -398,6 +685,11 @@ void BridgeClass::_dispatchCommand(const rpc_pb_RpcEnvelope& envelope) {
     _handleStatusMalformed(ctx);
     return;
   }
+  // Linux refused one of our requests.
+  if (ctx.raw_command == rpc::to_underlying(rpc::StatusCode::STATUS_ERROR) &&
+      _requests.fail(ctx.sequence_id, bridge::RequestStatus::REJECTED)) {
+    return;
+  }
 
   using HandlerFn =
       void (*)(BridgeClass&, const bridge::router::CommandContext&);
@@ -445,9 +737,17 @@ void BridgeClass::_initializeRuntime() {
     _hardware_serial = static_cast<HardwareSerial*>(&_stream);
   else
     _hardware_serial = nullptr;
+#if BRIDGE_BOND_MAX_LINKS > 1
+  _rx_link = 0;
+  _resetBond();
+#endif
 }
 
 void BridgeClass::begin(uint32_t baudrate, const char* secret) {
+  // First, while the call chain is still shallow: everything below this
+  // frame counts towards the stack high-water mark.
+  bridge::hal::paintStack();
+  _current = this;
   _initializeRuntime();
 
   wolfCrypt_Init();
@@ -460,6 +760,14 @@ void BridgeClass::begin(uint32_t baudrate, const char* secret) {
     _shared_secret.assign(data_ptr, data_ptr + len);
   }
   bridge::hal::init();
+#if BRIDGE_ENABLE_FRAME_TRACE
+  FrameTrace.begin();
+#endif
+#if BRIDGE_ENABLE_EEPROM
+  // Mounted before the link exists so the sketch can read its settings
+  // without waiting for Linux.
+  KVStore.begin();
+#endif
   if (!_fsm.is_started()) _fsm.start();
   _fsm.receive(bridge::fsm::EvReset());
 #if BRIDGE_ENABLE_POST_TESTS
@@ -471,48 +779,211 @@ void BridgeClass::begin(uint32_t baudrate, const char* secret) {
   if constexpr (bridge::hal::CurrentArchTraits::id ==
                 bridge::hal::ArchId::ARCH_AVR)
     if (baudrate > 0 && _hardware_serial) _hardware_serial->begin(baudrate);
+  _baudrate = baudrate;
+  _fallback_baudrate = 0;
   _tx_enabled = true;
   _timers.clear();
-  _timer_ids[bridge::scheduler::TIMER_ACK_TIMEOUT] =
-      _timers.register_timer([]() { Bridge._onAckTimeout(); }, _ack_timeout_ms,
-                             etl::timer::mode::REPEATING);
-  _timer_ids[bridge::scheduler::TIMER_RX_DEDUPE] = _timers.register_timer(
-      []() { Bridge._onRxDedupe(); }, bridge::config::RX_DEDUPE_INTERVAL_MS,
+  _registerTimer<&BridgeClass::_onAckTimeout>(
+      bridge::scheduler::TIMER_ACK_TIMEOUT, _ack_timeout_ms,
+      etl::timer::mode::REPEATING);
+  _registerTimer<&BridgeClass::_onRxDedupe>(
+      bridge::scheduler::TIMER_RX_DEDUPE, bridge::config::RX_DEDUPE_INTERVAL_MS,
       etl::timer::mode::REPEATING);
-  _timer_ids[bridge::scheduler::TIMER_BAUDRATE_CHANGE] = _timers.register_timer(
-      []() { Bridge._onBaudrateChange(); },
+  _registerTimer<&BridgeClass::_onBaudrateChange>(
+      bridge::scheduler::TIMER_BAUDRATE_CHANGE,
+      bridge::config::BAUDRATE_CHANGE_DELAY_MS, etl::timer::mode::SINGLE_SHOT);
+  _registerTimer<&BridgeClass::_onBaudrateConfirmTimeout>(
+      bridge::scheduler::TIMER_BAUDRATE_CONFIRM,
       bridge::config::BAUDRATE_CHANGE_DELAY_MS, etl::timer::mode::SINGLE_SHOT);
-  _timer_ids[bridge::scheduler::TIMER_BOOTLOADER_DELAY] =
-      _timers.register_timer([]() { Bridge._onBootloaderDelay(); },
-                             bridge::config::BOOTLOADER_DELAY_MS,
-                             etl::timer::mode::SINGLE_SHOT);
+  _registerTimer<&BridgeClass::_onBootloaderDelay>(
+      bridge::scheduler::TIMER_BOOTLOADER_DELAY,
+      bridge::config::BOOTLOADER_DELAY_MS, etl::timer::mode::SINGLE_SHOT);
   // [SIL-2/H-2] Handshake response watchdog: fires EvTimeout if MPU does not
   // complete CMD_LINK_SYNC within _response_timeout_ms after a reset.
-  _timer_ids[bridge::scheduler::TIMER_HANDSHAKE_TIMEOUT] =
-      _timers.register_timer([]() { Bridge._onHandshakeTimeout(); },
-                             _response_timeout_ms,
-                             etl::timer::mode::SINGLE_SHOT);
+  _registerTimer<&BridgeClass::_onHandshakeTimeout>(
+      bridge::scheduler::TIMER_HANDSHAKE_TIMEOUT, _response_timeout_ms,
+      etl::timer::mode::SINGLE_SHOT);
   _timers.start(_timer_ids[bridge::scheduler::TIMER_HANDSHAKE_TIMEOUT]);
-  _packet_serial.setPacketHandler(
-      etl::delegate<void(etl::span<const uint8_t>)>::create<
-          BridgeClass, &BridgeClass::_handleReceivedFrame>(*this));
+  _registerTimer<&BridgeClass::_onRequestTimeout>(
+      bridge::scheduler::TIMER_REQUEST_TIMEOUT,
+      bridge::config::REQUEST_SWEEP_MS, etl::timer::mode::REPEATING);
+  _timers.start(_timer_ids[bridge::scheduler::TIMER_REQUEST_TIMEOUT]);
+  const auto on_packet = etl::delegate<void(etl::span<const uint8_t>)>::create<
+      BridgeClass, &BridgeClass::_handleReceivedFrame>(*this);
+  _packet_serial.setPacketHandler(on_packet);
+#if BRIDGE_BOND_MAX_LINKS > 1
+  for (uint8_t i = 0; i < _bond_link_count; ++i) {
+    _bond_links[i].packet_serial.setPacketHandler(on_packet);
+  }
+#endif
 }
 
+namespace {
+// Services that keep per-link state and are driven by the sketch or by
+// command handlers: enterSafeState() resets them, process() leaves them
+// alone (the mailbox gets its own profiler phase). DataStore, FileSystem and
+// Process keep theirs in _requests instead.
+using LinkServices =
+    bridge::services::ServiceSet<Console, Mailbox, SPIService>
+#if BRIDGE_ENABLE_I2C
+    ::With<I2CService>
+#endif
+    ;
+
+// Services process() polls on every pass, in this order.
+using PolledServices = bridge::services::ServiceSet<>
+#if BRIDGE_ENABLE_PIN_EVENTS
+    ::With<PinEvents>
+#endif
+#if BRIDGE_ENABLE_EVENTS
+    ::With<Events>
+#endif
+#if BRIDGE_ENABLE_TIMELINE
+    ::With<Timeline>
+#endif
+#if BRIDGE_ENABLE_WAVEFORM
+    ::With<Waveform>
+#endif
+#if BRIDGE_ENABLE_REFLEX
+    ::With<Reflex>
+#endif
+#if BRIDGE_ENABLE_SAMPLER
+    ::With<Sampler>
+#endif
+#if BRIDGE_ENABLE_TELEMETRY
+    ::With<Telemetry>
+#endif
+#if BRIDGE_ENABLE_AGGREGATOR
+    ::With<Aggregator>
+#endif
+    ;
+
+// Splits one process() pass into LoopProfiler phases; compiles to nothing
+// when the profiler is disabled.
+#if BRIDGE_ENABLE_LOOP_PROFILER
+struct PhaseClock {
+  uint32_t start = ::micros();
+  uint32_t mark = start;
+  void lap(rpc_pb_LoopPhase phase) {
+    const uint32_t now = ::micros();
+    LoopProfiler.record(phase, now - mark);
+    mark = now;
+  }
+  void finish() {
+    LoopProfiler.record(rpc_pb_LoopPhase_LOOP_PHASE_TOTAL, mark - start);
+  }
+};
+#else
+struct PhaseClock {
+  void lap(rpc_pb_LoopPhase) {}
+  void finish() {}
+};
+#endif
+}  // namespace
+
 void BridgeClass::process() {
+  _current = this;
+  PhaseClock clock;
   _watchdogTask();
+  clock.lap(rpc_pb_LoopPhase_LOOP_PHASE_WATCHDOG);
   _serialTask();
+  clock.lap(rpc_pb_LoopPhase_LOOP_PHASE_SERIAL);
   _timerTask();
+  clock.lap(rpc_pb_LoopPhase_LOOP_PHASE_TIMERS);
   if constexpr (bridge::config::ENABLE_MAILBOX) Mailbox.process();
+  clock.lap(rpc_pb_LoopPhase_LOOP_PHASE_MAILBOX);
+#if BRIDGE_ENABLE_THREADED
+  _drainSubmitted();
+#endif
+  PolledServices::process();
+  if (_services != nullptr) _services->process();
+  clock.lap(rpc_pb_LoopPhase_LOOP_PHASE_SERVICES);
+  clock.finish();
 }
 void BridgeClass::_watchdogTask() { bridge::hal::watchdog_kick(); }
 
+#if BRIDGE_ENABLE_THREADED
+bool BridgeClass::startTask() {
+  uint8_t idle = TASK_IDLE;
+  if (!_task_state.compare_exchange_strong(idle, TASK_RUNNING)) return false;
+  if (!bridge::hal::startTask(&BridgeClass::_taskEntry, this)) {
+    _task_state.store(TASK_IDLE);
+    return false;
+  }
+  return true;
+}
+
+void BridgeClass::stopTask() {
+  uint8_t running = TASK_RUNNING;
+  if (!_task_state.compare_exchange_strong(running, TASK_STOPPING)) return;
+  while (_task_state.load(etl::memory_order_acquire) != TASK_IDLE) {
+    bridge::hal::idleTask();
+  }
+}
+
+void BridgeClass::_taskEntry(void* arg) {
+  auto& self = *static_cast<BridgeClass*>(arg);
+  while (self._task_state.load(etl::memory_order_acquire) == TASK_RUNNING) {
+    // A pass with input or submissions to handle only gives way to tasks of
+    // the same priority; an idle one sleeps a tick.
+    const bool busy = self._hasTaskWork();
+    self.process();
+    if (busy) {
+      bridge::hal::yieldTask();
+    } else {
+      bridge::hal::idleTask();
+    }
+  }
+  // Last touch of the bridge: stopTask() may return, and the bridge go away,
+  // as soon as this is seen.
+  self._task_state.store(TASK_IDLE, etl::memory_order_release);
+  bridge::hal::endTask();
+}
+
+bool BridgeClass::_hasTaskWork() {
+  if (!_submitted.empty() || _stream.available() > 0) return true;
+#if BRIDGE_BOND_MAX_LINKS > 1
+  for (uint8_t i = 0; i < _bond_link_count; ++i) {
+    if (_bond_links[i].stream->available() > 0) return true;
+  }
+#endif
+  return false;
+}
+
+void BridgeClass::_drainSubmitted() {
+  for (size_t i = 0; i < bridge::config::SUBMIT_QUEUE_SIZE; ++i) {
+    const bool popped = _submitted.pop([this](Submission& s) {
+      const bool sent =
+          sendFrame(s.command_id, 0,
+                    etl::span<const uint8_t>(s.payload.data(), s.length));
+      if (s.done != nullptr) s.done->_finish(sent);
+    });
+    if (!popped) return;
+  }
+}
+#endif
+
 void BridgeClass::_serialTask() {
   _packet_serial.update(_stream);
-  const int avail = _stream.available();
+  int avail = _stream.available();
+#if BRIDGE_BOND_MAX_LINKS > 1
+  // Flow control covers the bond as a whole: the fullest link decides.
+  for (uint8_t i = 0; i < _bond_link_count; ++i) {
+    BondLink& link = _bond_links[i];
+    _rx_link = static_cast<uint8_t>(i + 1U);
+    link.packet_serial.update(*link.stream);
+    avail = etl::max(avail, link.stream->available());
+  }
+  _rx_link = 0;
+  _bond_rx.expire(::millis(), bridge::config::BOND_GAP_MS,
+                  [this](etl::span<const uint8_t> f) { _handleHeldFrame(f); });
+#endif
+  if (avail > _serial_rx_peak) _serial_rx_peak = static_cast<uint16_t>(avail);
   if (!_serial_xoff_sent &&
       avail > bridge::config::FLOW_CONTROL_XOFF_THRESHOLD) {
     signalXoff();
     _serial_xoff_sent = true;
+    countLink(LinkCounter::XOFF_EPISODES);
   } else if (_serial_xoff_sent &&
              avail < bridge::config::FLOW_CONTROL_XON_THRESHOLD) {
     signalXon();
@@ -531,6 +1002,7 @@ void BridgeClass::_timerTask() {
 }
 bool BridgeClass::isSynchronized() const { return _fsm.isSynchronized(); }
 void BridgeClass::onUnknownCommand(const bridge::router::CommandContext& ctx) {
+  if (_services != nullptr && _services->on_command(ctx)) return;
   if (_command_handler.is_valid())
     _command_handler(*ctx.envelope);
   else
@@ -539,22 +1011,58 @@ void BridgeClass::onUnknownCommand(const bridge::router::CommandContext& ctx) {
 
 void BridgeClass::enterSafeState() {
   bridge::hal::forceSafeState();
+  _trace(rpc_pb_FrameTraceDirection_FRAME_TRACE_EVENT, 0, 0, 0,
+         rpc_pb_FrameTraceResult_FRAME_TRACE_SAFE_STATE);
   _tx_enabled = false;
   _clearPendingTxQueue();
   _fsm.receive(bridge::fsm::EvReset());
-  Console.onLost();
-  DataStore.onLost();
-  Mailbox.onLost();
-  Process.onLost();
-  FileSystem.onLost();
-  SPIService.onLost();
+#if BRIDGE_ENABLE_FRAME_TIMESTAMPS
+  _frame_timestamps = false;
+#endif
+#if BRIDGE_BOND_MAX_LINKS > 1
+  _resetBond();
+#endif
+  // Before the services reset: a completion may still look at their state.
+  _requests.cancel(0, bridge::RequestStatus::LOST);
+  LinkServices::onLost();
+  PolledServices::onLost();
+  if (_services != nullptr) _services->on_lost();
 }
 
 void BridgeClass::_serialize_and_send(const rpc_pb_RpcEnvelope& env) {
   const size_t len = rpc::serialize_frame(env, _tx_frame_buffer);
-  if (len > 0)
-    _packet_serial.send(_stream,
-                        etl::span<const uint8_t>(_tx_frame_buffer.data(), len));
+  _trace(rpc_pb_FrameTraceDirection_FRAME_TRACE_TX,
+         static_cast<uint16_t>(env.command_id),
+         static_cast<uint16_t>(env.sequence_id),
+         env.payload_type.encrypted_payload_with_tag.size,
+         len > 0 ? rpc_pb_FrameTraceResult_FRAME_TRACE_OK
+                 : rpc_pb_FrameTraceResult_FRAME_TRACE_DROPPED);
+  if (len == 0) {
+    countLink(LinkCounter::TX_DROPPED);
+    return;
+  }
+  _packet_serial.send(_txStream(env.bond_seq),
+                      etl::span<const uint8_t>(_tx_frame_buffer.data(), len));
+  countLink(LinkCounter::TX_FRAMES);
+}
+
+Stream& BridgeClass::_txStream(uint32_t bond_seq) {
+#if BRIDGE_BOND_MAX_LINKS > 1
+  // Round-robin over the links Linux has sent bonded frames on.
+  if (bond_seq != 0U) {
+    for (uint8_t n = 0; n <= _bond_link_count; ++n) {
+      _bond_tx_link = (_bond_tx_link >= _bond_link_count)
+                          ? 0U
+                          : static_cast<uint8_t>(_bond_tx_link + 1U);
+      if ((_bond_active & (1U << _bond_tx_link)) != 0U) {
+        return _linkStream(_bond_tx_link);
+      }
+    }
+  }
+#else
+  (void)bond_seq;
+#endif
+  return _stream;
 }
 
 bool BridgeClass::_sendFrameRaw(const rpc_pb_RpcEnvelope& env,
@@ -576,8 +1084,12 @@ void BridgeClass::_transmit(uint16_t command_id, uint16_t sequence_id,
   if (do_encrypt) {
     if (!rpc::security::aead_encrypt_frame(raw_cmd, sequence_id, payload,
                                            _session_key, &_tx_nonce_counter,
-                                           _crypto_buffer, nonce, tag))
+                                           _crypto_buffer, nonce, tag)) {
+      countLink(LinkCounter::TX_DROPPED);
+      _trace(rpc_pb_FrameTraceDirection_FRAME_TRACE_TX, raw_cmd, sequence_id,
+             payload.size(), rpc_pb_FrameTraceResult_FRAME_TRACE_DROPPED);
       return;
+    }
     final_payload =
         etl::span<const uint8_t>(_crypto_buffer.data(), payload.size());
   }
@@ -585,6 +1097,7 @@ void BridgeClass::_transmit(uint16_t command_id, uint16_t sequence_id,
   _tx_envelope.version = rpc::PROTOCOL_VERSION;
   _tx_envelope.command_id = command_id;
   _tx_envelope.sequence_id = sequence_id;
+  _stamp(_tx_envelope);
   etl::copy_n(nonce.begin(), rpc::AEAD_NONCE_SIZE, _tx_envelope.nonce.bytes);
   _tx_envelope.nonce.size = static_cast<pb_size_t>(rpc::AEAD_NONCE_SIZE);
   const size_t pl_size = etl::min(final_payload.size(),
@@ -608,32 +1121,42 @@ void BridgeClass::_transmit(uint16_t command_id, uint16_t sequence_id,
   _serialize_and_send(_tx_envelope);
 }
 
+// Only copying the queue head is masked. Encryption, encoding and the
+// blocking stream write run with interrupts enabled: the head frame and its
+// buffer stay queued until its ack, and acks are handled on this same
+// thread (process()), so nothing frees them while _transmit() reads them.
 void BridgeClass::_flushPendingTxQueue() {
+  PendingTxFrame f = {};
   BRIDGE_ATOMIC_BLOCK {
     if (_pending_tx_queue.empty() || !_tx_enabled) return;
-    const auto& f = _pending_tx_queue.front();
+    f = _pending_tx_queue.front();
     _last_command_id = f.command_id;
     _retry_count = 0;
     _fsm.receive(bridge::fsm::EvSendCritical());
-    _transmit(f.command_id, f.sequence_id,
-              etl::span<const uint8_t>(f.buffer->data.data(), f.length));
-    _timers.start(_timer_ids[bridge::scheduler::TIMER_ACK_TIMEOUT]);
   }
+  _transmit(f.command_id, f.sequence_id,
+            etl::span<const uint8_t>(f.buffer->data.data(), f.length));
+  _timers.start(_timer_ids[bridge::scheduler::TIMER_ACK_TIMEOUT]);
 }
 
 void BridgeClass::_retransmitLastFrame() {
+  PendingTxFrame f = {};
   BRIDGE_ATOMIC_BLOCK {
     if (_pending_tx_queue.empty()) return;
-    const auto& f = _pending_tx_queue.front();
-    _transmit(f.command_id, f.sequence_id,
-              etl::span<const uint8_t>(f.buffer->data.data(), f.length));
-    _timers.start(_timer_ids[bridge::scheduler::TIMER_ACK_TIMEOUT]);
+    f = _pending_tx_queue.front();
   }
+  countLink(LinkCounter::TX_RETRANSMITS);
+  _transmit(f.command_id, f.sequence_id,
+            etl::span<const uint8_t>(f.buffer->data.data(), f.length));
+  _timers.start(_timer_ids[bridge::scheduler::TIMER_ACK_TIMEOUT]);
 }
 
 void BridgeClass::_onAckTimeout() {
   if (!_fsm.isAwaitingAck()) return;
   if (++_retry_count >= _retry_limit) {
+    countLink(LinkCounter::TX_RETRY_EXHAUSTED);
+    _trace(rpc_pb_FrameTraceDirection_FRAME_TRACE_EVENT, _last_command_id, 0,
+           0, rpc_pb_FrameTraceResult_FRAME_TRACE_RETRY_EXHAUSTED);
     _timers.stop(_timer_ids[bridge::scheduler::TIMER_ACK_TIMEOUT]);
     _fsm.receive(bridge::fsm::EvTimeout());
     _tx_enabled = false;
@@ -680,14 +1203,35 @@ void BridgeClass::_onHandshakeTimeout() {
 void BridgeClass::_onBaudrateChange() {
   if (_pending_baudrate > 0) {
     if (_hardware_serial) _hardware_serial->begin(_pending_baudrate);
+    // Without a known previous rate there is nothing to go back to.
+    if (_baudrate_confirm_ms > 0 && _baudrate > 0) {
+      _fallback_baudrate = _baudrate;
+      _timers.set_period(_timer_ids[bridge::scheduler::TIMER_BAUDRATE_CONFIRM],
+                         _baudrate_confirm_ms);
+      _timers.start(_timer_ids[bridge::scheduler::TIMER_BAUDRATE_CONFIRM]);
+    }
+    _baudrate = _pending_baudrate;
     _pending_baudrate = 0;
   }
 }
+// No valid frame arrived at the trial rate: the daemon could not reach us
+// there and has gone back to the previous one.
+void BridgeClass::_onBaudrateConfirmTimeout() {
+  if (_fallback_baudrate == 0) return;
+  if (_hardware_serial) _hardware_serial->begin(_fallback_baudrate);
+  _baudrate = _fallback_baudrate;
+  _fallback_baudrate = 0;
+}
 void BridgeClass::_onBootloaderDelay() { bridge::hal::enterBootloader(); }
 
-void BridgeClass::_handleSetBaudrate(const rpc_pb_SetBaudratePacket& msg) {
+void BridgeClass::_handleSetBaudrate(const bridge::router::CommandContext& ctx,
+                                     const rpc_pb_SetBaudratePacket& msg) {
   if (msg.baudrate == 0 || msg.baudrate == _pending_baudrate) return;
   _pending_baudrate = msg.baudrate;
+  _baudrate_confirm_ms = msg.confirm_timeout_ms;
+  // Answered at the old rate; the switch waits BAUDRATE_CHANGE_DELAY_MS so
+  // the reply leaves the UART first.
+  (void)sendFrame(rpc::CommandId::CMD_SET_BAUDRATE_RESP, ctx.sequence_id);
   _timers.start(_timer_ids[bridge::scheduler::TIMER_BAUDRATE_CHANGE]);
 }
 
@@ -707,14 +1251,16 @@ void BridgeClass::_handleSetPinMode(const rpc_pb_PinMode& m) {
                            return p.first == m.mode;
                          });
   const uint8_t m_val = (it != kPinModeMap.end()) ? it->second : INPUT;
-  pinMode(m.pin, m_val);
+  bridge::hal::fastPinMode(static_cast<uint8_t>(m.pin), m_val);
 }
 
 void BridgeClass::_handleDigitalWrite(const rpc_pb_DigitalWrite& m) {
-  digitalWrite(m.pin, (m.value == 0) ? LOW : HIGH);
+  bridge::hal::fastDigitalWrite(static_cast<uint8_t>(m.pin),
+                                (m.value == 0) ? LOW : HIGH);
 }
 void BridgeClass::_handleAnalogWrite(const rpc_pb_AnalogWrite& m) {
-  analogWrite(m.pin, static_cast<int>(m.value));  // [SIL-2/H-6] no C-cast
+  bridge::hal::fastAnalogWrite(static_cast<uint8_t>(m.pin),
+                               static_cast<int>(m.value));  // [SIL-2/H-6]
 }
 
 void BridgeClass::_handlePinReadCommon(
@@ -743,7 +1289,8 @@ void BridgeClass::_handlePinReadCommon(
 void BridgeClass::_handleDigitalRead(const bridge::router::CommandContext& ctx,
                                      const rpc_pb_PinRead& m) {
   _handlePinReadCommon(ctx, m.pin, bridge::config::DIGITAL_PINS,
-                       rpc::CommandId::CMD_DIGITAL_READ_RESP, ::digitalRead);
+                       rpc::CommandId::CMD_DIGITAL_READ_RESP,
+                       bridge::hal::fastDigitalRead);
 }
 
 void BridgeClass::_handleAnalogRead(const bridge::router::CommandContext& ctx,
@@ -751,7 +1298,8 @@ void BridgeClass::_handleAnalogRead(const bridge::router::CommandContext& ctx,
 #if defined(ARDUINO_ARCH_AVR) || defined(ARDUINO_ARCH_SAMD) || \
     defined(BRIDGE_HOST_TEST)
   _handlePinReadCommon(ctx, m.pin, bridge::config::ANALOG_PINS,
-                       rpc::CommandId::CMD_ANALOG_READ_RESP, ::analogRead);
+                       rpc::CommandId::CMD_ANALOG_READ_RESP,
+                       bridge::hal::analogRead);
 #else
   static_cast<void>(ctx);
   static_cast<void>(m);
@@ -759,17 +1307,141 @@ void BridgeClass::_handleAnalogRead(const bridge::router::CommandContext& ctx,
 #endif
 }
 
-void BridgeClass::_handleConsoleWrite(const rpc_pb_ConsoleWrite& m) {
-  Console._push(m);
+void BridgeClass::_handleDigitalWriteMask(const rpc_pb_DigitalWriteMask& m) {
+  bridge::hal::digitalWriteMask(m.mask, m.value);
 }
 
-#if BRIDGE_ENABLE_DATASTORE
-void BridgeClass::_handleDataStoreGetResponse(
-    const bridge::router::CommandContext&,
-    const rpc_pb_DatastoreGetResponse& m) {
-  DataStore._onResponse(m);
+void BridgeClass::_handleDigitalReadPort(
+    const bridge::router::CommandContext& ctx,
+    const rpc_pb_DigitalReadPort& m) {
+  rpc_pb_DigitalReadPortResponse resp =
+      rpc_pb_DigitalReadPortResponse_init_default;
+  resp.mask = m.mask & bridge::hal::pinmap::kDigitalPinMask;
+  resp.value = bridge::hal::digitalReadPort(resp.mask);
+  if (!send(rpc::CommandId::CMD_DIGITAL_READ_PORT_RESP, ctx.sequence_id, resp))
+    emitStatus(rpc::StatusCode::STATUS_ERROR);
 }
+
+void BridgeClass::_handleGpioBatch(const rpc_pb_GpioBatch& m) {
+  // Validate every op before touching a pin: a batch applies completely or
+  // not at all, so the device never sees half of a configuration.
+  const rpc_pb_GpioOp* const first = m.ops;
+  const rpc_pb_GpioOp* const last = m.ops + m.ops_count;
+  const bool valid = etl::all_of(first, last, [](const rpc_pb_GpioOp& op) {
+    if (op.pin >= bridge::config::DIGITAL_PINS) return false;
+    switch (op.op) {
+      case rpc_pb_GpioOpType_GPIO_OP_PIN_MODE:
+        return op.value <=
+               static_cast<uint32_t>(rpc_pb_PinModeType_PIN_INPUT_PULLUP);
+      case rpc_pb_GpioOpType_GPIO_OP_DIGITAL_WRITE:
+      case rpc_pb_GpioOpType_GPIO_OP_ANALOG_WRITE:
+        return true;
+      default:
+        return false;
+    }
+  });
+  if (!valid) {
+    emitStatus(rpc::StatusCode::STATUS_ERROR);
+    return;
+  }
+  // Decoding and validation ran with interrupts enabled; only the apply
+  // phase is masked so intermediate pin states are never observable.
+  BRIDGE_ATOMIC_BLOCK {
+    for (const rpc_pb_GpioOp* op = first; op != last; ++op) {
+      switch (op->op) {
+        case rpc_pb_GpioOpType_GPIO_OP_PIN_MODE: {
+          rpc_pb_PinMode pm = rpc_pb_PinMode_init_default;
+          pm.pin = op->pin;
+          pm.mode = static_cast<rpc_pb_PinModeType>(op->value);
+          _handleSetPinMode(pm);
+          break;
+        }
+        case rpc_pb_GpioOpType_GPIO_OP_ANALOG_WRITE: {
+          rpc_pb_AnalogWrite aw = rpc_pb_AnalogWrite_init_default;
+          aw.pin = op->pin;
+          aw.value = op->value;
+          _handleAnalogWrite(aw);
+          break;
+        }
+        default: {
+          rpc_pb_DigitalWrite dw = rpc_pb_DigitalWrite_init_default;
+          dw.pin = op->pin;
+          dw.value = op->value;
+          _handleDigitalWrite(dw);
+          break;
+        }
+      }
+    }
+  }
+}
+
+void BridgeClass::_handlePinSubscribe(const rpc_pb_PinSubscribe& m) {
+#if BRIDGE_ENABLE_PIN_EVENTS
+  if (!PinEvents.subscribe(m)) emitStatus(rpc::StatusCode::STATUS_ERROR);
+#else
+  static_cast<void>(m);
+#endif
+}
+
+void BridgeClass::_handleStreamStart(const rpc_pb_StreamConfig& m) {
+#if BRIDGE_ENABLE_SAMPLER
+  if (!Sampler.start(m)) emitStatus(rpc::StatusCode::STATUS_ERROR);
+#else
+  static_cast<void>(m);
 #endif
+}
+
+void BridgeClass::_handleTelemetryJob(const rpc_pb_TelemetryJob& m) {
+#if BRIDGE_ENABLE_TELEMETRY
+  if (!Telemetry.configure(m)) emitStatus(rpc::StatusCode::STATUS_ERROR);
+#else
+  static_cast<void>(m);
+#endif
+}
+
+void BridgeClass::_handleAggregateConfig(const rpc_pb_AggregateConfig& m) {
+#if BRIDGE_ENABLE_AGGREGATOR
+  if (!Aggregator.configure(m)) emitStatus(rpc::StatusCode::STATUS_ERROR);
+#else
+  static_cast<void>(m);
+#endif
+}
+
+void BridgeClass::_handleReflexRule(const rpc_pb_ReflexRule& m) {
+#if BRIDGE_ENABLE_REFLEX
+  if (!Reflex.configure(m)) emitStatus(rpc::StatusCode::STATUS_ERROR);
+#else
+  static_cast<void>(m);
+#endif
+}
+
+void BridgeClass::_handleScheduleGpio(const rpc_pb_ScheduleGpio& m) {
+#if BRIDGE_ENABLE_TIMELINE
+  if (!Timeline.schedule(m)) emitStatus(rpc::StatusCode::STATUS_ERROR);
+#else
+  static_cast<void>(m);
+#endif
+}
+
+void BridgeClass::_handleWaveformLoad(const rpc_pb_WaveformLoad& m) {
+#if BRIDGE_ENABLE_WAVEFORM
+  if (!Waveform.load(m)) emitStatus(rpc::StatusCode::STATUS_ERROR);
+#else
+  static_cast<void>(m);
+#endif
+}
+
+void BridgeClass::_handleWaveformStart(const rpc_pb_WaveformStart& m) {
+#if BRIDGE_ENABLE_WAVEFORM
+  if (!Waveform.start(m)) emitStatus(rpc::StatusCode::STATUS_ERROR);
+#else
+  static_cast<void>(m);
+#endif
+}
+
+void BridgeClass::_handleConsoleWrite(const rpc_pb_ConsoleWrite& m) {
+  Console._push(m);
+}
 
 #if BRIDGE_ENABLE_MAILBOX
 void BridgeClass::_handleMailboxPush(const bridge::router::CommandContext&,
@@ -799,26 +1471,12 @@ void BridgeClass::_handleFileRemove(const bridge::router::CommandContext&,
                                     const rpc_pb_FileRemove& m) {
   FileSystem._onRemove(m);
 }
-void BridgeClass::_handleFileReadResponse(const bridge::router::CommandContext&,
-                                          const rpc_pb_FileReadResponse& m) {
-  FileSystem._onResponse(m);
-}
 #endif
 #if BRIDGE_ENABLE_PROCESS
 void BridgeClass::_handleProcessKill(const bridge::router::CommandContext&,
                                      const rpc_pb_ProcessKill& m) {
   Process._onKillNotification(m);
 }
-void BridgeClass::_handleProcessRunAsyncResponse(
-    const bridge::router::CommandContext&,
-    const rpc_pb_ProcessRunAsyncResponse& m) {
-  Process._onRunAsyncResponse(m);
-}
-void BridgeClass::_handleProcessPollResponse(
-    const bridge::router::CommandContext&,
-    const rpc_pb_ProcessPollResponse& m) {
-  Process._onPollResponse(m);
-}
 #endif
 #if BRIDGE_ENABLE_SPI
 void BridgeClass::_handleSpiSetConfig(const rpc_pb_SpiConfig& m) {
@@ -855,6 +1513,36 @@ void BridgeClass::_handleSpiTransfer(const bridge::router::CommandContext& ctx,
     emitStatus(rpc::StatusCode::STATUS_ERROR);
 }
 #endif
+#if BRIDGE_ENABLE_I2C
+// Bus errors travel in the response status so Linux can tell a missing
+// device from a timeout; STATUS_ERROR only means the reply was not sent.
+void BridgeClass::_handleI2cTransfer(const bridge::router::CommandContext& ctx,
+                                     const rpc_pb_I2cTransfer& m) {
+  rpc_pb_I2cTransferResponse resp = rpc_pb_I2cTransferResponse_init_default;
+  if (m.read_len > sizeof(resp.data.bytes)) {
+    resp.status = rpc_pb_I2cStatus_I2C_DATA_TOO_LONG;
+  } else {
+    resp.status = I2CService.transfer(
+        static_cast<uint8_t>(m.address),
+        etl::span<const uint8_t>(m.write.bytes, m.write.size),
+        etl::span<uint8_t>(resp.data.bytes, m.read_len), m.hold);
+    if (resp.status == rpc_pb_I2cStatus_I2C_OK)
+      resp.data.size = static_cast<pb_size_t>(m.read_len);
+  }
+  if (!send(rpc::CommandId::CMD_I2C_TRANSFER_RESP, ctx.sequence_id, resp))
+    emitStatus(rpc::StatusCode::STATUS_ERROR);
+}
+void BridgeClass::_handleI2cReadRegisters(
+    const bridge::router::CommandContext& ctx,
+    const rpc_pb_I2cReadRegisters& m) {
+  rpc_pb_I2cReadRegistersResponse resp =
+      rpc_pb_I2cReadRegistersResponse_init_default;
+  I2CService.readRegisters(m, resp);
+  if (!send(rpc::CommandId::CMD_I2C_READ_REGISTERS_RESP, ctx.sequence_id,
+            resp))
+    emitStatus(rpc::StatusCode::STATUS_ERROR);
+}
+#endif
 
 void BridgeClass::_handleStatusMalformed(
     const bridge::router::CommandContext&) {
@@ -911,6 +1599,14 @@ void BridgeClass::_handleLinkReset(const bridge::router::CommandContext& ctx) {
     }
   }
   _fsm.receive(bridge::fsm::EvReset());
+#if BRIDGE_ENABLE_FRAME_TIMESTAMPS
+  // A new daemon may not stamp its frames: wait for it to show it does.
+  _frame_timestamps = false;
+#endif
+#if BRIDGE_BOND_MAX_LINKS > 1
+  // Likewise for bonding: the daemon numbers its frames from 0 again.
+  _resetBond();
+#endif
   // [SIL-2/H-2] Restart the handshake watchdog with the (possibly updated)
   // _response_timeout_ms. If the MPU does not complete CMD_LINK_SYNC within
   // this window, _onHandshakeTimeout() will drive the FSM to FAULT.
@@ -925,6 +1621,9 @@ void BridgeClass::_handleGetCapabilities(
     const bridge::router::CommandContext& ctx) {
   rpc_pb_Capabilities resp = rpc_pb_Capabilities_init_default;
   bridge::hal::fillCapabilities(resp);
+#if BRIDGE_BOND_MAX_LINKS > 1
+  resp.bond_links = 1U + _bond_link_count;
+#endif
   (void)send(rpc::CommandId::CMD_GET_CAPABILITIES_RESP, ctx.sequence_id, resp);
 }
 
@@ -955,6 +1654,106 @@ void BridgeClass::_handleGetFreeMemory(
   (void)send(rpc::CommandId::CMD_GET_FREE_MEMORY_RESP, ctx.sequence_id, resp);
 }
 
+void BridgeClass::_handleGetMemoryProfile(
+    const bridge::router::CommandContext& ctx) {
+  rpc_pb_MemoryProfile resp = rpc_pb_MemoryProfile_init_default;
+  uint16_t ram = 0, data = 0, bss = 0, heap = 0;
+  bridge::hal::ramSections(ram, data, bss, heap);
+  uint16_t peak = 0, headroom = 0;
+  bridge::hal::stackUsage(peak, headroom);
+  resp.ram_size = ram;
+  resp.data_size = data;
+  resp.bss_size = bss;
+  resp.heap_size = heap;
+  resp.stack_peak = peak;
+  resp.stack_headroom = headroom;
+  resp.free_now = bridge::hal::getFreeMemory();
+  BRIDGE_ATOMIC_BLOCK { resp.tx_queue_peak = _tx_queue_peak; }
+  resp.console_rx_peak = Console.rxPeak();
+  resp.console_tx_peak = Console.txPeak();
+#if BRIDGE_ENABLE_PIN_EVENTS
+  BRIDGE_ATOMIC_BLOCK { resp.pin_event_peak = PinEvents.ringPeak(); }
+#endif
+#if BRIDGE_ENABLE_TIMELINE
+  resp.timeline_peak = Timeline.peak();
+#endif
+#if BRIDGE_ENABLE_EVENTS
+  resp.event_ring_peak = Events.ringPeak();
+#endif
+  (void)send(rpc::CommandId::CMD_GET_MEMORY_PROFILE_RESP, ctx.sequence_id,
+             resp);
+}
+
+void BridgeClass::_handleGetLinkStats(const bridge::router::CommandContext& ctx,
+                                      const rpc_pb_LinkStatsQuery& m) {
+  using C = LinkCounter;
+  rpc_pb_LinkStats resp = rpc_pb_LinkStats_init_default;
+  resp.rx_frames = linkCount(C::RX_FRAMES);
+  resp.rx_malformed = linkCount(C::RX_MALFORMED);
+  resp.rx_auth_failures = linkCount(C::RX_AUTH_FAILURES);
+  resp.rx_duplicates = linkCount(C::RX_DUPLICATES);
+  resp.tx_frames = linkCount(C::TX_FRAMES);
+  resp.tx_retransmits = linkCount(C::TX_RETRANSMITS);
+  resp.tx_retry_exhausted = linkCount(C::TX_RETRY_EXHAUSTED);
+  resp.tx_dropped = linkCount(C::TX_DROPPED);
+  resp.xoff_episodes = linkCount(C::XOFF_EPISODES);
+  resp.console_rx_overflow = linkCount(C::CONSOLE_RX_OVERFLOW);
+  resp.mailbox_dropped = linkCount(C::MAILBOX_DROPPED);
+  BRIDGE_ATOMIC_BLOCK { resp.tx_queue_peak = _tx_queue_peak; }
+  resp.serial_rx_peak = _serial_rx_peak;
+  resp.console_rx_peak = Console.rxPeak();
+#if BRIDGE_ENABLE_MAILBOX
+  resp.mailbox_peak = Mailbox.peak();
+#endif
+  // Only clear what was actually reported: a refused reply keeps the counts
+  // for the next poll.
+  if (send(rpc::CommandId::CMD_GET_LINK_STATS_RESP, ctx.sequence_id, resp) &&
+      m.reset) {
+    _link_counters.fill(0);
+  }
+}
+
+#if BRIDGE_ENABLE_FRAME_TRACE
+void BridgeClass::_handleGetFrameTrace(
+    const bridge::router::CommandContext& ctx,
+    const rpc_pb_FrameTraceQuery& m) {
+  rpc_pb_FrameTrace resp = rpc_pb_FrameTrace_init_default;
+  FrameTrace.snapshot(m.start, resp);
+  (void)send(rpc::CommandId::CMD_GET_FRAME_TRACE_RESP, ctx.sequence_id, resp);
+}
+#endif
+
+void BridgeClass::_handleLinkProbe(const bridge::router::CommandContext& ctx,
+                                   const rpc_pb_LinkProbe& m) {
+  (void)send(rpc::CommandId::CMD_LINK_PROBE_RESP, ctx.sequence_id, m);
+}
+
+void BridgeClass::_handleGetLoopProfile(
+    const bridge::router::CommandContext& ctx,
+    const rpc_pb_LoopProfileQuery& m) {
+#if BRIDGE_ENABLE_LOOP_PROFILER
+  rpc_pb_LoopProfile resp = rpc_pb_LoopProfile_init_default;
+  if (!LoopProfiler.snapshot(m.phase, resp)) {
+    emitStatus(rpc::StatusCode::STATUS_ERROR);
+    return;
+  }
+  if (m.reset) LoopProfiler.reset(m.phase);
+  (void)send(rpc::CommandId::CMD_GET_LOOP_PROFILE_RESP, ctx.sequence_id, resp);
+#else
+  static_cast<void>(ctx);
+  static_cast<void>(m);
+#endif
+}
+
+void BridgeClass::_handleClockSync(const bridge::router::CommandContext& ctx,
+                                   const rpc_pb_ClockSync& m) {
+  rpc_pb_ClockSyncResponse resp = rpc_pb_ClockSyncResponse_init_default;
+  resp.t1_us = m.t1_us;
+  resp.mcu_rx_us = _rx_frame_us;
+  resp.mcu_tx_us = ::micros();
+  (void)send(rpc::CommandId::CMD_CLOCK_SYNC_RESP, ctx.sequence_id, resp);
+}
+
 void BridgeClass::_applyTimingConfig(const rpc_pb_HandshakeConfig& msg) {
   _ack_timeout_ms = (uint16_t)msg.ack_timeout_ms;
   _retry_limit = (uint8_t)msg.ack_retry_limit;
@@ -962,16 +1761,66 @@ void BridgeClass::_applyTimingConfig(const rpc_pb_HandshakeConfig& msg) {
 }
 
 void BridgeClass::_handleReceivedFrame(etl::span<const uint8_t> p) {
+  _rx_frame_us = ::micros();
+  countLink(LinkCounter::RX_FRAMES);
   auto res = rpc::parse_frame(p);
   if (!res) {
+    countLink(LinkCounter::RX_MALFORMED);
+    _trace(rpc_pb_FrameTraceDirection_FRAME_TRACE_RX, 0, 0, p.size(),
+           rpc_pb_FrameTraceResult_FRAME_TRACE_MALFORMED);
     emitStatus(rpc::StatusCode::STATUS_MALFORMED);
     return;
   }
+  // A frame that passed its CRC proves the new rate works.
+  if (_fallback_baudrate != 0) {
+    _timers.stop(_timer_ids[bridge::scheduler::TIMER_BAUDRATE_CONFIRM]);
+    _fallback_baudrate = 0;
+  }
   rpc_pb_RpcEnvelope envelope = res.value();
+#if BRIDGE_BOND_MAX_LINKS > 1
+  // Striped frames can overtake each other: put them back in order before
+  // the nonce check sees them.
+  if (envelope.bond_seq != 0U) {
+    _bond_active = static_cast<uint8_t>(_bond_active | (1U << _rx_link));
+    const auto deliver = [this](etl::span<const uint8_t> f) {
+      _handleHeldFrame(f);
+    };
+    const auto verdict =
+        _bond_rx.accept(static_cast<uint16_t>(envelope.bond_seq - 1U), p,
+                        ::millis(), deliver);
+    if (verdict == decltype(_bond_rx)::Verdict::STALE) {
+      countLink(LinkCounter::RX_DUPLICATES);
+      return;
+    }
+    if (verdict == decltype(_bond_rx)::Verdict::NEXT) {
+      _handleFrame(envelope);
+      _bond_rx.release(deliver);
+    }
+    return;
+  }
+#endif
+  _handleFrame(envelope);
+}
+
+#if BRIDGE_BOND_MAX_LINKS > 1
+void BridgeClass::_handleHeldFrame(etl::span<const uint8_t> p) {
+  auto res = rpc::parse_frame(p);
+  if (!res) return;
+  rpc_pb_RpcEnvelope envelope = res.value();
+  _handleFrame(envelope);
+}
+#endif
+
+void BridgeClass::_handleFrame(rpc_pb_RpcEnvelope& envelope) {
   const uint16_t raw_cmd = envelope.command_id;
   const bool is_excluded = rpc::is_system_command(raw_cmd);
   if (isSynchronized() && !_shared_secret.empty() && !is_excluded) {
     if (envelope.payload_type.encrypted_payload_with_tag.size < 16) {
+      countLink(LinkCounter::RX_AUTH_FAILURES);
+      _trace(rpc_pb_FrameTraceDirection_FRAME_TRACE_RX, raw_cmd,
+             envelope.sequence_id,
+             envelope.payload_type.encrypted_payload_with_tag.size,
+             rpc_pb_FrameTraceResult_FRAME_TRACE_AUTH_FAILED);
       emitStatus(rpc::StatusCode::STATUS_ERROR);
       return;
     }
@@ -992,6 +1841,10 @@ void BridgeClass::_handleReceivedFrame(etl::span<const uint8_t> p) {
         !rpc::security::validate_frame_nonce(
             etl::span<const uint8_t>(envelope.nonce.bytes, 12),
             &_rx_nonce_counter)) {
+      countLink(LinkCounter::RX_AUTH_FAILURES);
+      _trace(rpc_pb_FrameTraceDirection_FRAME_TRACE_RX, raw_cmd,
+             envelope.sequence_id, ct_size,
+             rpc_pb_FrameTraceResult_FRAME_TRACE_AUTH_FAILED);
       emitStatus(rpc::StatusCode::STATUS_ERROR);
       return;
     }
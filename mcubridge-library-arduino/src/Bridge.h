@@ -30,9 +30,17 @@
 
 #include "config/bridge_config.h"
 #include "fsm/bridge_fsm.h"
+#include "protocol/BondReorder.h"
+#include "protocol/RequestTable.h"
 #include "protocol/rpc_frame.h"
 #include "protocol/rpc_protocol.h"
 #include "protocol/rpc_structs.h"
+#if BRIDGE_ENABLE_THREADED
+#include "hal/ArchTraits.h"
+#include "protocol/SubmitQueue.h"
+#endif
+#include "services/FrameTrace.h"
+#include "services/ServiceSet.h"
 
 // [SIL-2] Template De-bloating: Extern declarations
 namespace etl {
@@ -68,6 +76,16 @@ class BridgeClass {
  public:
   using ErrorPolicy = bridge::SafeStatePolicy;
   explicit BridgeClass(Stream& stream);
+  ~BridgeClass();
+  BridgeClass(const BridgeClass&) = delete;
+  BridgeClass& operator=(const BridgeClass&) = delete;
+
+  /**
+   * The bridge whose begin() or process() ran last, or nullptr. ETL errors
+   * (etl::handle_error) go to its ErrorPolicy, so with several bridges an
+   * error is handled by the one that was running.
+   */
+  static BridgeClass* current() { return _current; }
 
   void begin(uint32_t baudrate = 0, const char* secret = nullptr);
   void process();
@@ -98,6 +116,31 @@ class BridgeClass {
   void signalXoff();
   void signalXon();
 
+  /** Link health counters reported by CMD_GET_LINK_STATS. */
+  enum class LinkCounter : uint8_t {
+    RX_FRAMES,
+    RX_MALFORMED,
+    RX_AUTH_FAILURES,
+    RX_DUPLICATES,
+    TX_FRAMES,
+    TX_RETRANSMITS,
+    TX_RETRY_EXHAUSTED,
+    TX_DROPPED,
+    XOFF_EPISODES,
+    CONSOLE_RX_OVERFLOW,
+    MAILBOX_DROPPED,
+    COUNT
+  };
+
+  /** Add @p n to a link counter, saturating at UINT16_MAX. */
+  void countLink(LinkCounter c, uint16_t n = 1) {
+    uint16_t& v = _link_counters[static_cast<uint8_t>(c)];
+    v = (n > UINT16_MAX - v) ? UINT16_MAX : static_cast<uint16_t>(v + n);
+  }
+  uint16_t linkCount(LinkCounter c) const {
+    return _link_counters[static_cast<uint8_t>(c)];
+  }
+
   template <typename T>
   [[nodiscard]] bool sendFrame(T command, uint16_t seq = 0,
                                etl::span<const uint8_t> p = {}) {
@@ -107,15 +150,11 @@ class BridgeClass {
     const bool is_system = rpc::is_system_command(cmd);
     if (!_tx_enabled && !is_system) return false;
     if (is_reliable_cmd(cmd)) {
-      BRIDGE_ATOMIC_BLOCK {
-        if (_pending_tx_queue.full()) return false;
-        auto* buf = _tx_payload_pool.allocate();
-        if (!buf) return false;
-        const size_t pl_size = etl::min(p.size(), buf->data.size());
-        etl::copy_n(p.data(), pl_size, buf->data.data());
-        _pending_tx_queue.push_back({cmd, seq, buf, pl_size});
-        if (!_fsm.isAwaitingAck()) _flushPendingTxQueue();
-      }
+      auto* buf = _allocateTxBuffer();
+      if (!buf) return false;
+      const size_t pl_size = etl::min(p.size(), buf->data.size());
+      etl::copy_n(p.data(), pl_size, buf->data.data());
+      _enqueueTxFrame(cmd, seq, buf, pl_size);
       return true;
     }
     _transmit(cmd, seq, p);
@@ -129,6 +168,7 @@ class BridgeClass {
     env.version = rpc::PROTOCOL_VERSION;
     env.command_id = command_id;
     env.sequence_id = sequence_id;
+    _stamp(env);
     rpc::Payload::set<T>(env, packet);
     return _sendFrameRaw(env, command_id);
   }
@@ -152,19 +192,121 @@ class BridgeClass {
     }
   }
 
+  /**
+   * Send @p packet as a request Linux answers with @p response, echoing the
+   * sequence id the request went out with. @p handler is completed exactly
+   * once through Complete: with the response, or with a failure when Linux
+   * answers STATUS_ERROR, nothing arrives within @p timeout_ms, or the link
+   * drops (see bridge::RequestTable).
+   * @return false, without completing @p handler, if too many requests are
+   *         open or the frame could not be sent.
+   */
+  template <auto Complete, typename T, typename Handler>
+  [[nodiscard]] bool request(
+      rpc::CommandId c, const T& packet, rpc::CommandId response,
+      const Handler& handler,
+      uint32_t timeout_ms = bridge::config::REQUEST_TIMEOUT_MS) {
+    const uint16_t seq = _nextSequence();
+    // Added before sending: the response can only arrive after that.
+    if (!_requests.add<Complete>(seq, rpc::to_underlying(response),
+                                 timeout_ms, handler)) {
+      return false;
+    }
+    if (!send(c, seq, packet)) {
+      _requests.discard(seq);
+      return false;
+    }
+    return true;
+  }
+  bool canRequest() const { return !_requests.full(); }
+  /** End the open requests waiting for @p response as RequestStatus::LOST. */
+  void cancelRequests(rpc::CommandId response) {
+    _requests.cancel(rpc::to_underlying(response),
+                     bridge::RequestStatus::LOST);
+  }
+
   using CommandHandler = etl::delegate<void(const rpc_pb_RpcEnvelope&)>;
   using StatusHandler =
       etl::delegate<void(rpc::StatusCode, etl::span<const uint8_t>)>;
   void onCommand(CommandHandler h) { _command_handler = h; }
+  /**
+   * Run sketch-defined services alongside the built-in ones: process() polls
+   * them after the built-in services, enterSafeState() calls their onLost(),
+   * and commands missing from the dispatch table go to their onCommand()
+   * before the onCommand() handler. See bridge::services::ServiceSet.
+   *
+   * @code
+   * Bridge.useServices<MySensor, MyActuator>();
+   * @endcode
+   */
+  template <auto&... Services>
+  void useServices() {
+    _services = &bridge::services::ServiceSet<Services...>::hooks;
+  }
   void onStatus(StatusHandler h) { _status_handler = h; }
   void flushStream() { _stream.flush(); }
+#if BRIDGE_BOND_MAX_LINKS > 1
+  /**
+   * Bond @p stream with the stream given to the constructor. Once Linux
+   * stripes its frames over a link (serial_bond_ports), outgoing frames go
+   * round-robin over every link it has used and incoming ones are put back
+   * in order by RpcEnvelope.bond_seq. The sketch opens the UART at the rate
+   * the daemon opens serial_bond_ports with. Call before begin().
+   * @return false once BRIDGE_BOND_MAX_LINKS links are in use.
+   */
+  bool addLink(Stream& stream) {
+    if (_bond_link_count >= _bond_links.size()) return false;
+    _bond_links[_bond_link_count++].stream = &stream;
+    return true;
+  }
+#endif
+#if BRIDGE_ENABLE_THREADED
+  /**
+   * Run process() on a task of its own (bridge::hal::startTask()) until
+   * stopTask(). From then on that task owns the bridge: other tasks only
+   * call submit(). Call after begin().
+   * @return false if the task is already running or was not created.
+   */
+  bool startTask();
+  /** Stop the task started by startTask() and wait for it to finish. */
+  void stopTask();
+
+  /**
+   * Send @p packet as send() would, from any task. It is encoded on the
+   * calling task's stack and then queued, so a packet that does not encode
+   * never takes a slot; the bridge task sends it on its next pass and then
+   * completes @p done, if given.
+   * @return false, leaving @p done untouched, when @p packet does not
+   *         encode or BRIDGE_SUBMIT_QUEUE_SIZE submissions are already
+   *         waiting.
+   */
+  template <typename T>
+  [[nodiscard]] bool submit(rpc::CommandId c, const T& packet,
+                            bridge::Completion* done = nullptr) {
+    etl::array<uint8_t, rpc::MAX_PAYLOAD_SIZE> payload;
+    pb_ostream_t out = pb_ostream_from_buffer(payload.data(), payload.size());
+    if (!pb_encode(&out, rpc::Payload::get_fields<T>(), &packet)) return false;
+    const auto length = static_cast<uint16_t>(out.bytes_written);
+    if (done != nullptr) done->_arm();
+    return _submitted.push([&](Submission& s) {
+      s.command_id = rpc::to_underlying(c);
+      s.length = length;
+      s.done = done;
+      etl::copy_n(payload.data(), length, s.payload.data());
+    });
+  }
+#endif
 
   __attribute__((noinline)) void _dispatchCommand(
       const rpc_pb_RpcEnvelope& envelope);
-  static void _onBootloaderDelay();
+  void _onBootloaderDelay();
   void _onAckTimeout();
   void _onRxDedupe();
+  void _onRequestTimeout() {
+    if (!_requests.empty()) _requests.expire();
+  }
   void _onBaudrateChange();
+  void _onBaudrateConfirmTimeout();
   void _retransmitLastFrame();
   bool _isSecurityCheckPassed(uint16_t command_id) const;
 
@@ -178,6 +320,14 @@ class BridgeClass {
                                 const bridge::router::CommandContext& ctx);
   static void _onCmd_GetFreeMemory(BridgeClass& self,
                                    const bridge::router::CommandContext& ctx);
+  static void _onCmd_GetMemoryProfile(
+      BridgeClass& self, const bridge::router::CommandContext& ctx);
+  static void _onCmd_GetLinkStats(BridgeClass& self,
+                                  const bridge::router::CommandContext& ctx);
+  static void _onCmd_LinkProbe(BridgeClass& self,
+                               const bridge::router::CommandContext& ctx);
+  static void _onCmd_ClockSync(BridgeClass& self,
+                               const bridge::router::CommandContext& ctx);
   static void _onCmd_LinkSync(BridgeClass& self,
                               const bridge::router::CommandContext& ctx);
   static void _onCmd_LinkReset(BridgeClass& self,
@@ -202,6 +352,16 @@ class BridgeClass {
   // ctx.raw_command.
   static void _onCmd_PinRead(BridgeClass& self,
                              const bridge::router::CommandContext& ctx);
+  static void _onCmd_DigitalWriteMask(
+      BridgeClass& self, const bridge::router::CommandContext& ctx);
+  static void _onCmd_DigitalReadPort(BridgeClass& self,
+                                     const bridge::router::CommandContext& ctx);
+  static void _onCmd_GpioBatch(BridgeClass& self,
+                               const bridge::router::CommandContext& ctx);
+#if BRIDGE_ENABLE_PIN_EVENTS
+  static void _onCmd_PinSubscribe(BridgeClass& self,
+                                  const bridge::router::CommandContext& ctx);
+#endif
   static void _onCmd_ConsoleWrite(BridgeClass& self,
                                   const bridge::router::CommandContext& ctx);
 #if BRIDGE_ENABLE_DATASTORE
@@ -244,6 +404,54 @@ class BridgeClass {
   static void _onCmd_SpiSetConfig(BridgeClass& self,
                                   const bridge::router::CommandContext& ctx);
 #endif
+#if BRIDGE_ENABLE_I2C
+  static void _onCmd_I2cBegin(BridgeClass& self,
+                              const bridge::router::CommandContext& ctx);
+  static void _onCmd_I2cEnd(BridgeClass& self,
+                            const bridge::router::CommandContext& ctx);
+  static void _onCmd_I2cTransfer(BridgeClass& self,
+                                 const bridge::router::CommandContext& ctx);
+  static void _onCmd_I2cReadRegisters(
+      BridgeClass& self, const bridge::router::CommandContext& ctx);
+#endif
+#if BRIDGE_ENABLE_SAMPLER
+  static void _onCmd_StreamStart(BridgeClass& self,
+                                 const bridge::router::CommandContext& ctx);
+  static void _onCmd_StreamStop(BridgeClass& self,
+                                const bridge::router::CommandContext& ctx);
+#endif
+#if BRIDGE_ENABLE_TELEMETRY
+  static void _onCmd_TelemetryJob(BridgeClass& self,
+                                  const bridge::router::CommandContext& ctx);
+#endif
+#if BRIDGE_ENABLE_AGGREGATOR
+  static void _onCmd_AggregateConfig(
+      BridgeClass& self, const bridge::router::CommandContext& ctx);
+#endif
+#if BRIDGE_ENABLE_REFLEX
+  static void _onCmd_ReflexRule(BridgeClass& self,
+                                const bridge::router::CommandContext& ctx);
+#endif
+#if BRIDGE_ENABLE_TIMELINE
+  static void _onCmd_ScheduleGpio(BridgeClass& self,
+                                  const bridge::router::CommandContext& ctx);
+#endif
+#if BRIDGE_ENABLE_WAVEFORM
+  static void _onCmd_WaveformLoad(BridgeClass& self,
+                                  const bridge::router::CommandContext& ctx);
+  static void _onCmd_WaveformStart(BridgeClass& self,
+                                   const bridge::router::CommandContext& ctx);
+  static void _onCmd_WaveformStop(BridgeClass& self,
+                                  const bridge::router::CommandContext& ctx);
+#endif
+#if BRIDGE_ENABLE_LOOP_PROFILER
+  static void _onCmd_GetLoopProfile(BridgeClass& self,
+                                    const bridge::router::CommandContext& ctx);
+#endif
+#if BRIDGE_ENABLE_FRAME_TRACE
+  static void _onCmd_GetFrameTrace(BridgeClass& self,
+                                   const bridge::router::CommandContext& ctx);
+#endif
 
   static constexpr bool is_reliable_cmd(uint16_t id) {
     return rpc::requires_ack(id);
@@ -270,6 +478,7 @@ class BridgeClass {
   HardwareSerial* _hardware_serial = nullptr;
   CommandHandler _command_handler;
   StatusHandler _status_handler;
+  const bridge::services::Hooks* _services = nullptr;
   uint16_t _last_command_id = 0;
   uint16_t _tx_sequence_id = 0;
   uint8_t _retry_count = 0;
@@ -277,11 +486,97 @@ class BridgeClass {
   uint16_t _ack_timeout_ms = rpc::RPC_DEFAULT_ACK_TIMEOUT_MS;
   uint32_t _response_timeout_ms = rpc::RPC_HANDSHAKE_RESPONSE_TIMEOUT_MAX_MS;
   uint32_t _pending_baudrate = 0;
+  // Rate the UART runs at (0 if begin() was not told), and the one to go
+  // back to if a CMD_SET_BAUDRATE with confirm_timeout_ms is not confirmed
+  // by a valid frame in time.
+  uint32_t _baudrate = 0;
+  uint32_t _fallback_baudrate = 0;
+  uint32_t _baudrate_confirm_ms = 0;
+  // micros() when the frame being dispatched was handed over by the framer;
+  // the receive timestamp of the clock-sync exchange.
+  uint32_t _rx_frame_us = 0;
+  // Deepest _pending_tx_queue since boot, for CMD_GET_MEMORY_PROFILE.
+  uint8_t _tx_queue_peak = 0;
+  // Deepest UART RX backlog seen by _serialTask(), in bytes.
+  uint16_t _serial_rx_peak = 0;
+#if BRIDGE_ENABLE_FRAME_TIMESTAMPS
+  // Set by the first stamped frame after a link reset. _echo_* describe the
+  // last stamped request, echoed on frames with the same sequence id.
+  bool _frame_timestamps = false;
+  uint16_t _echo_seq = 0;
+  uint32_t _echo_sent_us = 0;
+  uint32_t _echo_rx_us = 0;
+#endif
+  etl::array<uint16_t, static_cast<uint8_t>(LinkCounter::COUNT)>
+      _link_counters = {};
 
+  using LinkPacketSerial =
+      PacketSerial2::PacketSerial<PacketSerial2::COBSR, PacketSerial2::NoCRC,
+                                  PacketSerial2::NoLock,
+                                  PacketSerial2::NoWatchdog>;
   etl::array<uint8_t, bridge::config::RX_BUFFER_SIZE> _rx_buffer;
-  PacketSerial2::PacketSerial<PacketSerial2::COBSR, PacketSerial2::NoCRC,
-                              PacketSerial2::NoLock, PacketSerial2::NoWatchdog>
-      _packet_serial;
+  LinkPacketSerial _packet_serial;
+#if BRIDGE_BOND_MAX_LINKS > 1
+  static_assert(bridge::config::BOND_MAX_LINKS <= 8,
+                "bonded links are tracked in a uint8_t mask");
+  // A UART bonded with _stream (link 1 and up); frames are decoded in place.
+  struct BondLink {
+    BondLink()
+        : packet_serial(etl::span<uint8_t>(rx_buffer.data(), rx_buffer.size()),
+                        etl::span<uint8_t>(rx_buffer.data(), rx_buffer.size())) {
+    }
+    Stream* stream = nullptr;
+    etl::array<uint8_t, bridge::config::RX_BUFFER_SIZE> rx_buffer;
+    LinkPacketSerial packet_serial;
+  };
+  etl::array<BondLink, bridge::config::BOND_MAX_LINKS - 1> _bond_links;
+  uint8_t _bond_link_count = 0;
+  // Links (bit 0: _stream) Linux has sent bonded frames on. Bonding is on
+  // while it is non-zero; a link reset or the safe state turns it off.
+  uint8_t _bond_active = 0;
+  uint8_t _bond_tx_link = 0;
+  // Link the frame being handled arrived on.
+  uint8_t _rx_link = 0;
+  // Frames sent since bonding started; on the wire as bond_seq - 1.
+  uint16_t _bond_tx_seq = 0;
+  bridge::BondReorder<bridge::config::BOND_REORDER_WINDOW, rpc::MAX_FRAME_SIZE>
+      _bond_rx;
+
+  void _resetBond() {
+    _bond_active = 0;
+    _bond_tx_link = 0;
+    _bond_tx_seq = 0;
+    _bond_rx.reset();
+  }
+  Stream& _linkStream(uint8_t link) {
+    return link == 0U ? _stream : *_bond_links[link - 1U].stream;
+  }
+  // Handles a frame the reorder window held back.
+  __attribute__((noinline)) void _handleHeldFrame(etl::span<const uint8_t> p);
+#endif
+
+#if BRIDGE_ENABLE_THREADED
+  static_assert(bridge::hal::CurrentArchTraits::has_tasks,
+                "BRIDGE_ENABLE_THREADED needs ESP32 or a host build");
+  // A frame another task handed over with submit(), already encoded.
+  struct Submission {
+    uint16_t command_id;
+    uint16_t length;
+    bridge::Completion* done;
+    etl::array<uint8_t, rpc::MAX_PAYLOAD_SIZE> payload;
+  };
+  enum TaskState : uint8_t { TASK_IDLE, TASK_RUNNING, TASK_STOPPING };
+
+  bridge::SubmitQueue<Submission, bridge::config::SUBMIT_QUEUE_SIZE>
+      _submitted;
+  etl::atomic<uint8_t> _task_state{TASK_IDLE};
+
+  static void _taskEntry(void* arg);
+  // Whether the next pass has received bytes or submissions to handle.
+  bool _hasTaskWork();
+  // Sends what other tasks submitted; at most one queue's worth per pass.
+  void _drainSubmitted();
+#endif
 
   etl::vector<uint8_t, 64> _shared_secret;
   etl::array<uint8_t, rpc::RPC_AEAD_KEY_SIZE> _session_key;
@@ -301,6 +596,20 @@ class BridgeClass {
   etl::callback_timer<bridge::scheduler::NUMBER_OF_TIMERS> _timers;
   etl::array<etl::timer::id::type, bridge::scheduler::NUMBER_OF_TIMERS>
       _timer_ids;
+  // Timer callbacks bound to this instance. _timers keeps a pointer to each,
+  // so they live as long as the bridge.
+  etl::array<etl::delegate<void()>, bridge::scheduler::NUMBER_OF_TIMERS>
+      _timer_callbacks;
+  static inline BridgeClass* _current = nullptr;
+
+  template <void (BridgeClass::*Callback)()>
+  void _registerTimer(bridge::scheduler::TimerId id, uint32_t period_ms,
+                      bool repeating) {
+    _timer_callbacks[id] =
+        etl::delegate<void()>::create<BridgeClass, Callback>(*this);
+    _timer_ids[id] =
+        _timers.register_timer(_timer_callbacks[id], period_ms, repeating);
+  }
   // Shared working buffer for transient operations (unencrypted encoding, SPI
   // transfer)
   etl::array<uint8_t, rpc::MAX_PAYLOAD_SIZE> _working_buffer;
@@ -317,6 +626,14 @@ class BridgeClass {
       _pending_tx_queue;
 
   etl::circular_buffer<uint16_t, bridge::config::RX_HISTORY_SIZE> _rx_history;
+  // MCU->Linux requests waiting for their response.
+  bridge::RequestTable _requests;
+
+  // Sequence id for the next request. 0 is left to unsolicited frames.
+  uint16_t _nextSequence() {
+    if (++_tx_sequence_id == 0U) ++_tx_sequence_id;
+    return _tx_sequence_id;
+  }
 
   bool _preDispatch(const bridge::router::CommandContext& ctx, bool needs_ack,
                     bool retransmit_on_dup);
@@ -386,20 +703,40 @@ class BridgeClass {
                         const rpc_pb_AckPacket& m);
   void _handleGetVersion(const bridge::router::CommandContext& ctx);
   void _handleGetFreeMemory(const bridge::router::CommandContext& ctx);
+  void _handleGetMemoryProfile(const bridge::router::CommandContext& ctx);
+  void _handleGetLoopProfile(const bridge::router::CommandContext& ctx,
+                             const rpc_pb_LoopProfileQuery& m);
+  void _handleGetLinkStats(const bridge::router::CommandContext& ctx,
+                           const rpc_pb_LinkStatsQuery& m);
+#if BRIDGE_ENABLE_FRAME_TRACE
+  void _handleGetFrameTrace(const bridge::router::CommandContext& ctx,
+                            const rpc_pb_FrameTraceQuery& m);
+#endif
+  void _handleClockSync(const bridge::router::CommandContext& ctx,
+                        const rpc_pb_ClockSync& m);
   __attribute__((noinline)) void _handleLinkSync(
       const bridge::router::CommandContext& ctx, const rpc_pb_LinkSync& m);
   void _handleLinkReset(const bridge::router::CommandContext& ctx);
   void _handleGetCapabilities(const bridge::router::CommandContext& ctx);
   void _handleXoff(const bridge::router::CommandContext& ctx);
   void _handleXon(const bridge::router::CommandContext& ctx);
-  void _handleSetBaudrate(const rpc::payload::SetBaudratePacket& msg);
+  void _handleSetBaudrate(const bridge::router::CommandContext& ctx,
+                          const rpc::payload::SetBaudratePacket& msg);
+  void _handleLinkProbe(const bridge::router::CommandContext& ctx,
+                        const rpc_pb_LinkProbe& m);
   void _handleEnterBootloader(const rpc::payload::EnterBootloader& msg);
   void _handleSpiBegin(const bridge::router::CommandContext& ctx);
   void _handleSpiEnd(const bridge::router::CommandContext& ctx);
   __attribute__((noinline)) void _handleSpiTransfer(
       const bridge::router::CommandContext& ctx, const rpc_pb_SpiTransfer& m);
+  void _handleI2cTransfer(const bridge::router::CommandContext& ctx,
+                          const rpc_pb_I2cTransfer& m);
+  void _handleI2cReadRegisters(const bridge::router::CommandContext& ctx,
+                               const rpc_pb_I2cReadRegisters& m);
   __attribute__((noinline)) void _handleReceivedFrame(
       etl::span<const uint8_t> p);
+  // Authenticates and dispatches a frame that passed its CRC.
+  void _handleFrame(rpc_pb_RpcEnvelope& envelope);
   void onUnknownCommand(const bridge::router::CommandContext& ctx);
 
   void _processAck(uint16_t command_id, uint16_t sequence_id);
@@ -418,27 +755,28 @@ class BridgeClass {
       const bridge::router::CommandContext& ctx, const rpc_pb_PinRead& m);
   __attribute__((noinline)) void _handleAnalogRead(
       const bridge::router::CommandContext& ctx, const rpc_pb_PinRead& m);
+  static void _handleDigitalWriteMask(const rpc_pb_DigitalWriteMask& m);
+  void _handleDigitalReadPort(const bridge::router::CommandContext& ctx,
+                              const rpc_pb_DigitalReadPort& m);
+  void _handleGpioBatch(const rpc_pb_GpioBatch& m);
+  void _handlePinSubscribe(const rpc_pb_PinSubscribe& m);
   static void _handleConsoleWrite(const rpc_pb_ConsoleWrite& m);
-  static void _handleDataStoreGetResponse(
-      const bridge::router::CommandContext& ctx,
-      const rpc_pb_DatastoreGetResponse& m);
   static void _handleFileWrite(const bridge::router::CommandContext& ctx,
                                const rpc_pb_FileWrite& m);
   static void _handleFileRead(const bridge::router::CommandContext& ctx,
                               const rpc_pb_FileRead& m);
   static void _handleFileRemove(const bridge::router::CommandContext& ctx,
                                 const rpc_pb_FileRemove& m);
-  static void _handleFileReadResponse(const bridge::router::CommandContext& ctx,
-                                      const rpc_pb_FileReadResponse& m);
   static void _handleProcessKill(const bridge::router::CommandContext& ctx,
                                  const rpc_pb_ProcessKill& m);
-  static void _handleProcessRunAsyncResponse(
-      const bridge::router::CommandContext& ctx,
-      const rpc_pb_ProcessRunAsyncResponse& m);
-  static void _handleProcessPollResponse(
-      const bridge::router::CommandContext& ctx,
-      const rpc_pb_ProcessPollResponse& m);
   static void _handleSpiSetConfig(const rpc_pb_SpiConfig& m);
+  void _handleStreamStart(const rpc_pb_StreamConfig& m);
+  void _handleTelemetryJob(const rpc_pb_TelemetryJob& m);
+  void _handleAggregateConfig(const rpc_pb_AggregateConfig& m);
+  void _handleReflexRule(const rpc_pb_ReflexRule& m);
+  void _handleScheduleGpio(const rpc_pb_ScheduleGpio& m);
+  void _handleWaveformLoad(const rpc_pb_WaveformLoad& m);
+  void _handleWaveformStart(const rpc_pb_WaveformStart& m);
 #if BRIDGE_ENABLE_MAILBOX
   static void _handleMailboxPush(const bridge::router::CommandContext& ctx,
                                  const rpc_pb_MailboxPush& m);
@@ -447,27 +785,98 @@ class BridgeClass {
       const rpc_pb_MailboxAvailableResponse& m);
 #endif
   void _serialize_and_send(const rpc_pb_RpcEnvelope& env);
+  // The link a frame stamped with @p bond_seq goes out on.
+  Stream& _txStream(uint32_t bond_seq);
+  // A free TX payload buffer, or nullptr (counted as a drop) when the queue
+  // or the pool is exhausted. The caller owns it until _enqueueTxFrame() or
+  // _releaseTxBuffer(), so it can fill it with interrupts enabled.
+  TxPayloadBuffer* _allocateTxBuffer() {
+    TxPayloadBuffer* buf = nullptr;
+    BRIDGE_ATOMIC_BLOCK {
+      if (!_pending_tx_queue.full()) buf = _tx_payload_pool.allocate();
+    }
+    if (!buf) countLink(LinkCounter::TX_DROPPED);
+    return buf;
+  }
+  void _releaseTxBuffer(TxPayloadBuffer* buf) {
+    BRIDGE_ATOMIC_BLOCK { _tx_payload_pool.release(buf); }
+  }
+  // Queue a filled buffer and start sending it if no frame awaits an ack.
+  // Only the queue update masks interrupts.
+  void _enqueueTxFrame(uint16_t cmd, uint16_t seq, TxPayloadBuffer* buf,
+                       size_t length) {
+    BRIDGE_ATOMIC_BLOCK {
+      // The pool has one buffer per queue slot, so this only fails if the
+      // queue was filled without buffers.
+      if (_pending_tx_queue.full()) {
+        _tx_payload_pool.release(buf);
+        buf = nullptr;
+      } else {
+        _pending_tx_queue.push_back({cmd, seq, buf, length});
+        _noteTxQueuePeak();
+      }
+    }
+    if (!buf) {
+      countLink(LinkCounter::TX_DROPPED);
+      return;
+    }
+    if (!_fsm.isAwaitingAck()) _flushPendingTxQueue();
+  }
+  // Adds the RpcEnvelope timestamps once the daemon has asked for them, and
+  // the bond sequence while bonded.
+  void _stamp(rpc_pb_RpcEnvelope& env) {
+#if BRIDGE_ENABLE_FRAME_TIMESTAMPS
+    if (_frame_timestamps) {
+      if (env.sequence_id == _echo_seq) {
+        env.echo_us = _echo_sent_us;
+        env.echo_rx_us = _echo_rx_us;
+      }
+      env.sent_us = ::micros();
+    }
+#endif
+#if BRIDGE_BOND_MAX_LINKS > 1
+    if (_bond_active != 0U) {
+      env.bond_seq = static_cast<uint32_t>(_bond_tx_seq++) + 1U;
+    }
+#endif
+    (void)env;
+  }
+  // Records into FrameTrace; compiles to nothing without the trace.
+  void _trace(rpc_pb_FrameTraceDirection direction, uint16_t command,
+              uint16_t sequence, size_t length,
+              rpc_pb_FrameTraceResult result) {
+#if BRIDGE_ENABLE_FRAME_TRACE
+    FrameTrace.record(direction, command, sequence, length, result,
+                      static_cast<uint8_t>(_fsm.get_state_id()));
+#else
+    (void)direction;
+    (void)command;
+    (void)sequence;
+    (void)length;
+    (void)result;
+#endif
+  }
+  void _noteTxQueuePeak() {
+    _tx_queue_peak = etl::max(_tx_queue_peak,
+                              static_cast<uint8_t>(_pending_tx_queue.size()));
+  }
   [[nodiscard]] bool _sendFrameRaw(const rpc_pb_RpcEnvelope& env,
                                    uint16_t command_id);
   template <typename T>
   bool _sendEncryptedHelper(uint16_t raw_cmd, uint16_t seq, const T& packet) {
     const pb_msgdesc_t* fields = rpc::Payload::get_fields<T>();
     if (is_reliable_cmd(raw_cmd)) {
-      BRIDGE_ATOMIC_BLOCK {
-        if (_pending_tx_queue.full()) return false;
-        auto* buf = _tx_payload_pool.allocate();
-        if (!buf) return false;
-        pb_ostream_t out_stream =
-            pb_ostream_from_buffer(buf->data.data(), buf->data.size());
-        if (pb_encode(&out_stream, fields, &packet)) {
-          _pending_tx_queue.push_back(
-              {raw_cmd, seq, buf, out_stream.bytes_written});
-          if (!_fsm.isAwaitingAck()) _flushPendingTxQueue();
-          return true;
-        }
-        _tx_payload_pool.release(buf);
-        return false;
+      auto* buf = _allocateTxBuffer();
+      if (!buf) return false;
+      pb_ostream_t out_stream =
+          pb_ostream_from_buffer(buf->data.data(), buf->data.size());
+      if (pb_encode(&out_stream, fields, &packet)) {
+        _enqueueTxFrame(raw_cmd, seq, buf, out_stream.bytes_written);
+        return true;
       }
+      _releaseTxBuffer(buf);
+      countLink(LinkCounter::TX_DROPPED);
+      return false;
     } else {
       pb_ostream_t out_stream =
           pb_ostream_from_buffer(_working_buffer.data(), rpc::MAX_PAYLOAD_SIZE);
@@ -477,6 +886,7 @@ class BridgeClass {
                                            out_stream.bytes_written));
         return true;
       }
+      countLink(LinkCounter::TX_DROPPED);
       return false;
     }
   }
@@ -36,6 +36,10 @@ static constexpr bool ENABLE_WATCHDOG = true;
 // [SIL-2] Maximum time to wait for Linux handshake before entering safe state.
 static constexpr uint32_t SYNC_TIMEOUT_MS = rpc::SYNC_TIMEOUT_MS;
 
+// How often open MCU->Linux requests are checked against their deadline
+// (REQUEST_TIMEOUT_MS). Only runs while a request is open.
+static constexpr uint32_t REQUEST_SWEEP_MS = 100;
+
 // --- Feature Flags (Manual overrides via build system) ---
 #ifndef BRIDGE_ENABLE_DATASTORE
 #define BRIDGE_ENABLE_DATASTORE 1
@@ -52,12 +56,153 @@ static constexpr uint32_t SYNC_TIMEOUT_MS = rpc::SYNC_TIMEOUT_MS;
 #ifndef BRIDGE_ENABLE_SPI
 #define BRIDGE_ENABLE_SPI 1
 #endif
+// Off by default: Wire adds its own buffers (~200 bytes of RAM on AVR).
+// Also sets the i2c capability bit reported to Linux.
+#ifndef BRIDGE_ENABLE_I2C
+#define BRIDGE_ENABLE_I2C 0
+#endif
+// Log-structured KV store in EEPROM (KVStore), mounted by Bridge.begin().
+// Off by default because it claims BRIDGE_EEPROM_SIZE bytes from
+// BRIDGE_EEPROM_OFFSET (0: the rest of the EEPROM, 1 KiB on ESP32), which
+// the sketch must not touch. Also sets the eeprom capability bit.
+#ifndef BRIDGE_ENABLE_EEPROM
+#define BRIDGE_ENABLE_EEPROM 0
+#endif
+#ifndef BRIDGE_EEPROM_OFFSET
+#define BRIDGE_EEPROM_OFFSET 0
+#endif
+#ifndef BRIDGE_EEPROM_SIZE
+#define BRIDGE_EEPROM_SIZE 0
+#endif
+// Default for the services below, which each hold static rings, buffers or
+// rule tables sized by rpc_hw_config.h. Off on AVR, where a 2.5 KB
+// ATmega32U4 has no RAM to spare for all of them: enable the ones a sketch
+// uses one by one. On elsewhere.
+#ifndef BRIDGE_ENABLE_STATIC_SERVICES
+#if defined(ARDUINO_ARCH_AVR)
+#define BRIDGE_ENABLE_STATIC_SERVICES 0
+#else
+#define BRIDGE_ENABLE_STATIC_SERVICES 1
+#endif
+#endif
+#ifndef BRIDGE_ENABLE_PIN_EVENTS
+#define BRIDGE_ENABLE_PIN_EVENTS BRIDGE_ENABLE_STATIC_SERVICES
+#endif
+#ifndef BRIDGE_ENABLE_SAMPLER
+#define BRIDGE_ENABLE_SAMPLER BRIDGE_ENABLE_STATIC_SERVICES
+#endif
+#ifndef BRIDGE_ENABLE_TELEMETRY
+#define BRIDGE_ENABLE_TELEMETRY BRIDGE_ENABLE_STATIC_SERVICES
+#endif
+#ifndef BRIDGE_ENABLE_AGGREGATOR
+#define BRIDGE_ENABLE_AGGREGATOR BRIDGE_ENABLE_STATIC_SERVICES
+#endif
+#ifndef BRIDGE_ENABLE_REFLEX
+#define BRIDGE_ENABLE_REFLEX BRIDGE_ENABLE_STATIC_SERVICES
+#endif
+#ifndef BRIDGE_ENABLE_TIMELINE
+#define BRIDGE_ENABLE_TIMELINE BRIDGE_ENABLE_STATIC_SERVICES
+#endif
+#ifndef BRIDGE_ENABLE_WAVEFORM
+#define BRIDGE_ENABLE_WAVEFORM BRIDGE_ENABLE_STATIC_SERVICES
+#endif
+// Events.push() for interrupt handlers: EVENT_RING_SIZE compact records
+// drained into CMD_EVENT_BATCH frames by process().
+#ifndef BRIDGE_ENABLE_EVENTS
+#define BRIDGE_ENABLE_EVENTS BRIDGE_ENABLE_STATIC_SERVICES
+#endif
+// How long before a scheduled deadline process() stops returning and
+// busy-waits on micros(); wider windows tolerate slower loop() passes.
+#ifndef BRIDGE_TIMELINE_SPIN_US
+#define BRIDGE_TIMELINE_SPIN_US 500
+#endif
+// Timer1 also drives PWM on its pins and the Servo library: sampling streams
+// and waveforms only claim it when explicitly allowed, otherwise they are
+// paced by micros().
+#ifndef BRIDGE_ENABLE_TIMER1
+#define BRIDGE_ENABLE_TIMER1 0
+#endif
+// Time every process() phase with micros() into log2 histograms
+// (CMD_GET_LOOP_PROFILE). Off by default: it costs ~200 bytes of RAM and a
+// few micros() reads per pass.
+#ifndef BRIDGE_ENABLE_LOOP_PROFILER
+#define BRIDGE_ENABLE_LOOP_PROFILER 0
+#endif
+// Keep the last BRIDGE_FRAME_TRACE_DEPTH frames and link events in a ring
+// that survives a watchdog reset (CMD_GET_FRAME_TRACE). Off by default: each
+// entry costs 12 bytes of RAM. The depth must be a power of two.
+#ifndef BRIDGE_ENABLE_FRAME_TRACE
+#define BRIDGE_ENABLE_FRAME_TRACE 0
+#endif
+#ifndef BRIDGE_FRAME_TRACE_DEPTH
+#define BRIDGE_FRAME_TRACE_DEPTH 32
+#endif
+// Advertise Capabilities.frame_timestamps: once the daemon stamps its frames,
+// outgoing envelopes carry micros() and echo the request's timestamp so the
+// daemon can split round trips into one-way latency and MCU queueing time.
+#ifndef BRIDGE_ENABLE_FRAME_TIMESTAMPS
+#define BRIDGE_ENABLE_FRAME_TIMESTAMPS 1
+#endif
+// Stripe frames over up to BRIDGE_BOND_MAX_LINKS UARTs (Bridge.addLink()),
+// for boards with spare hardware serial ports. 1 compiles bonding out. Each
+// extra link costs RX_BUFFER_SIZE bytes of RAM, and the reorder window keeps
+// BRIDGE_BOND_REORDER_WINDOW frames (a power of two) of MAX_FRAME_SIZE.
+#ifndef BRIDGE_BOND_MAX_LINKS
+#define BRIDGE_BOND_MAX_LINKS 1
+#endif
+#ifndef BRIDGE_BOND_REORDER_WINDOW
+#define BRIDGE_BOND_REORDER_WINDOW 4
+#endif
+// Threaded mode (ESP32, and std::thread on the host): Bridge.startTask()
+// runs process() on its own task, and other tasks hand frames to it through
+// Bridge.submit(). BRIDGE_SUBMIT_QUEUE_SIZE (a power of two) submissions can
+// wait at once, each taking MAX_PAYLOAD_SIZE bytes.
+#ifndef BRIDGE_ENABLE_THREADED
+#define BRIDGE_ENABLE_THREADED 0
+#endif
+#ifndef BRIDGE_SUBMIT_QUEUE_SIZE
+#define BRIDGE_SUBMIT_QUEUE_SIZE 8
+#endif
+#ifndef BRIDGE_TASK_STACK_BYTES
+#define BRIDGE_TASK_STACK_BYTES 8192
+#endif
+#ifndef BRIDGE_TASK_PRIORITY
+#define BRIDGE_TASK_PRIORITY 2
+#endif
+// Core the bridge task is pinned to on dual-core ESP32s (the Arduino loop()
+// runs on core 1).
+#ifndef BRIDGE_TASK_CORE
+#define BRIDGE_TASK_CORE 0
+#endif
 
 static constexpr bool ENABLE_DATASTORE = BRIDGE_ENABLE_DATASTORE;
 static constexpr bool ENABLE_MAILBOX = BRIDGE_ENABLE_MAILBOX;
 static constexpr bool ENABLE_FILESYSTEM = BRIDGE_ENABLE_FILESYSTEM;
 static constexpr bool ENABLE_PROCESS = BRIDGE_ENABLE_PROCESS;
 static constexpr bool ENABLE_SPI = BRIDGE_ENABLE_SPI;
+static constexpr bool ENABLE_I2C = BRIDGE_ENABLE_I2C;
+static constexpr bool ENABLE_EEPROM = BRIDGE_ENABLE_EEPROM;
+static constexpr bool ENABLE_PIN_EVENTS = BRIDGE_ENABLE_PIN_EVENTS;
+static constexpr bool ENABLE_SAMPLER = BRIDGE_ENABLE_SAMPLER;
+static constexpr bool ENABLE_TELEMETRY = BRIDGE_ENABLE_TELEMETRY;
+static constexpr bool ENABLE_AGGREGATOR = BRIDGE_ENABLE_AGGREGATOR;
+static constexpr bool ENABLE_REFLEX = BRIDGE_ENABLE_REFLEX;
+static constexpr bool ENABLE_TIMELINE = BRIDGE_ENABLE_TIMELINE;
+static constexpr bool ENABLE_WAVEFORM = BRIDGE_ENABLE_WAVEFORM;
+static constexpr bool ENABLE_EVENTS = BRIDGE_ENABLE_EVENTS;
+static constexpr bool ENABLE_LOOP_PROFILER = BRIDGE_ENABLE_LOOP_PROFILER;
+static constexpr bool ENABLE_FRAME_TRACE = BRIDGE_ENABLE_FRAME_TRACE;
+static constexpr bool ENABLE_FRAME_TIMESTAMPS = BRIDGE_ENABLE_FRAME_TIMESTAMPS;
+static constexpr uint8_t BOND_MAX_LINKS = BRIDGE_BOND_MAX_LINKS;
+static constexpr uint8_t BOND_REORDER_WINDOW = BRIDGE_BOND_REORDER_WINDOW;
+// How long a bonded frame waits for the ones before it before they are given
+// up as lost on their link.
+static constexpr uint32_t BOND_GAP_MS = 20;
+static constexpr bool ENABLE_THREADED = BRIDGE_ENABLE_THREADED;
+static constexpr uint8_t SUBMIT_QUEUE_SIZE = BRIDGE_SUBMIT_QUEUE_SIZE;
+static constexpr uint32_t TASK_STACK_BYTES = BRIDGE_TASK_STACK_BYTES;
+static constexpr uint8_t TASK_PRIORITY = BRIDGE_TASK_PRIORITY;
+static constexpr uint8_t TASK_CORE = BRIDGE_TASK_CORE;
 
 // [SIL-2/AVR] Cryptographic Power-On Self-Tests (KAT for SHA256, HMAC, AEAD).
 // Enabled by default. Set to 0 for flash-constrained targets (e.g. ATmega328P).
@@ -74,7 +219,9 @@ enum TimerId : uint8_t {
   TIMER_BAUDRATE_CHANGE = 2,
   TIMER_BOOTLOADER_DELAY = 3,
   TIMER_HANDSHAKE_TIMEOUT = 4,  // [SIL-2/H-2] Handshake response watchdog
-  NUMBER_OF_TIMERS = 5
+  TIMER_BAUDRATE_CONFIRM = 5,
+  TIMER_REQUEST_TIMEOUT = 6,
+  NUMBER_OF_TIMERS = 7
 };
 }  // namespace scheduler
 }  // namespace bridge
@@ -34,6 +34,9 @@ struct ArchTraits {
   static constexpr bool has_wdt =
       (Id == ArchId::ARCH_AVR || Id == ArchId::ARCH_ESP32);
   static constexpr bool is_harvard = (Id == ArchId::ARCH_AVR);
+  // Preemptive tasks hal::startTask() can create (BRIDGE_ENABLE_THREADED).
+  static constexpr bool has_tasks =
+      (Id == ArchId::ARCH_ESP32 || Id == ArchId::ARCH_HOST);
   static constexpr uint32_t default_free_memory =
       (Id == ArchId::ARCH_AVR)     ? 2048
       : (Id == ArchId::ARCH_ESP32) ? 320000
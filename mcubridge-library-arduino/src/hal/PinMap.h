@@ -0,0 +1,70 @@
+/**
+ * @file PinMap.h
+ * @brief Compile-time Arduino pin -> port register/bit tables.
+ *
+ * The tables mirror the board variant pin maps shipped with the Arduino AVR
+ * core, but are resolved at compile time instead of through PROGMEM lookups.
+ * Boards without a table fall back to the Arduino API (HAS_DIRECT_PORTS ==
+ * false).
+ */
+#ifndef BRIDGE_HAL_PIN_MAP_H
+#define BRIDGE_HAL_PIN_MAP_H
+
+#include <etl/array.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "config/bridge_config.h"
+
+namespace bridge::hal::pinmap {
+
+enum class Port : uint8_t { PORT_B = 0, PORT_C, PORT_D, PORT_E, PORT_F };
+inline constexpr size_t PORT_COUNT = 5;
+
+struct PinLocation {
+  Port port;
+  uint8_t bit;
+};
+
+#if defined(__AVR_ATmega32U4__)
+// Arduino Yun / Leonardo (ATmega32U4), digital pins D0..D13.
+inline constexpr bool HAS_DIRECT_PORTS = true;
+inline constexpr etl::array<PinLocation, 14> kPins{{
+    {Port::PORT_D, 2}, {Port::PORT_D, 3}, {Port::PORT_D, 1},
+    {Port::PORT_D, 0}, {Port::PORT_D, 4}, {Port::PORT_C, 6},
+    {Port::PORT_D, 7}, {Port::PORT_E, 6}, {Port::PORT_B, 4},
+    {Port::PORT_B, 5}, {Port::PORT_B, 6}, {Port::PORT_B, 7},
+    {Port::PORT_D, 6}, {Port::PORT_C, 7},
+}};
+#elif defined(__AVR_ATmega328P__) || defined(__AVR_ATmega168__)
+// Arduino Uno / Nano (ATmega328P), digital pins D0..D13.
+inline constexpr bool HAS_DIRECT_PORTS = true;
+inline constexpr etl::array<PinLocation, 14> kPins{{
+    {Port::PORT_D, 0}, {Port::PORT_D, 1}, {Port::PORT_D, 2},
+    {Port::PORT_D, 3}, {Port::PORT_D, 4}, {Port::PORT_D, 5},
+    {Port::PORT_D, 6}, {Port::PORT_D, 7}, {Port::PORT_B, 0},
+    {Port::PORT_B, 1}, {Port::PORT_B, 2}, {Port::PORT_B, 3},
+    {Port::PORT_B, 4}, {Port::PORT_B, 5},
+}};
+#else
+inline constexpr bool HAS_DIRECT_PORTS = false;
+// Placeholder only: callers must check HAS_DIRECT_PORTS first.
+inline constexpr etl::array<PinLocation, 1> kPins{{{Port::PORT_B, 0}}};
+#endif
+
+/**
+ * @brief Pin-mask covering every digital pin the bridge accepts (bit N = pin
+ * N).
+ */
+inline constexpr uint32_t kDigitalPinMask =
+    (bridge::config::DIGITAL_PINS >= 32U)
+        ? 0xFFFFFFFFUL
+        : ((1UL << bridge::config::DIGITAL_PINS) - 1UL);
+
+static_assert(!HAS_DIRECT_PORTS ||
+                  kPins.size() >= bridge::config::DIGITAL_PINS,
+              "Pin map must cover every advertised digital pin");
+
+}  // namespace bridge::hal::pinmap
+
+#endif  // BRIDGE_HAL_PIN_MAP_H
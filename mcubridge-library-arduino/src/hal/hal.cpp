@@ -4,14 +4,60 @@
 #include <etl/iterator.h>
 
 #include "ArchTraits.h"
+#include "PinMap.h"
 #include "config/bridge_config.h"
 #include "protocol/rpc_protocol.h"
 #include "protocol/rpc_structs.h"
 
+#if BRIDGE_ENABLE_THREADED && defined(ARDUINO_ARCH_ESP32)
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#elif BRIDGE_ENABLE_THREADED
+#include <thread>
+#endif
+
+#if BRIDGE_ENABLE_EEPROM && defined(ARDUINO_ARCH_AVR)
+#include <avr/eeprom.h>
+#elif BRIDGE_ENABLE_EEPROM && defined(ARDUINO_ARCH_ESP32)
+#include <EEPROM.h>
+#endif
+
 #if defined(ARDUINO_ARCH_AVR)
 extern "C" {
 extern char* __brkval;
 extern char __heap_start;
+extern char __data_start;
+extern char __data_end;
+extern char __bss_start;
+extern char __bss_end;
+}
+#endif
+
+#if defined(ARDUINO_ARCH_AVR) && BRIDGE_ENABLE_TIMER1
+namespace {
+void (*volatile g_timer1_callback)() = nullptr;
+}  // namespace
+
+ISR(TIMER1_COMPA_vect) {
+  void (*cb)() = g_timer1_callback;
+  if (cb) cb();
+}
+#endif
+
+#if defined(ARDUINO_ARCH_AVR) && defined(ADCSRA)
+namespace {
+// Set while a background conversion or hal::analogRead() owns the ADC.
+volatile bool g_adc_busy = false;
+void (*volatile g_adc_callback)(uint16_t) = nullptr;
+}  // namespace
+
+ISR(ADC_vect) {
+  const uint16_t value = ADC;
+  void (*cb)(uint16_t) = g_adc_callback;
+  ADCSRA &= static_cast<uint8_t>(~_BV(ADIE));
+  g_adc_callback = nullptr;
+  g_adc_busy = false;
+  if (cb) cb(value);
 }
 #endif
 
@@ -105,6 +151,56 @@ uint16_t getFreeMemory() {
   return bridge::config::FALLBACK_FREE_MEMORY;
 }
 
+#if defined(ARDUINO_ARCH_AVR)
+namespace {
+constexpr uint8_t kStackCanary = 0xC5U;
+// Bytes left unpainted below paintStack()'s own frame.
+constexpr uintptr_t kStackPaintGuard = 32U;
+
+inline uint8_t* _heapEnd() {
+  return reinterpret_cast<uint8_t*>(__brkval == 0 ? &__heap_start
+                                                  : __brkval);
+}
+}  // namespace
+#endif
+
+void paintStack() {
+#if defined(ARDUINO_ARCH_AVR)
+  uint8_t marker = 0;
+  uint8_t* p = _heapEnd();
+  uint8_t* const end = &marker - kStackPaintGuard;
+  while (p < end) *p++ = kStackCanary;
+  bridge::hal::memory_fence();
+#endif
+}
+
+void stackUsage(uint16_t& peak, uint16_t& headroom) {
+  peak = 0;
+  headroom = 0;
+#if defined(ARDUINO_ARCH_AVR)
+  const uint8_t* p = _heapEnd();
+  const uint8_t* const top = reinterpret_cast<const uint8_t*>(RAMEND);
+  while (p < top && *p == kStackCanary) ++p;
+  headroom = static_cast<uint16_t>(p - _heapEnd());
+  peak = static_cast<uint16_t>(top - p + 1);
+#endif
+}
+
+void ramSections(uint16_t& ram, uint16_t& data, uint16_t& bss,
+                 uint16_t& heap) {
+  ram = 0;
+  data = 0;
+  bss = 0;
+  heap = 0;
+#if defined(ARDUINO_ARCH_AVR)
+  ram = static_cast<uint16_t>(RAMEND - RAMSTART + 1U);
+  data = static_cast<uint16_t>(&__data_end - &__data_start);
+  bss = static_cast<uint16_t>(&__bss_end - &__bss_start);
+  heap = static_cast<uint16_t>(_heapEnd() -
+                               reinterpret_cast<uint8_t*>(&__heap_start));
+#endif
+}
+
 void init() {
   forceSafeState();
   if constexpr (bridge::config::ENABLE_WATCHDOG) {
@@ -140,6 +236,87 @@ __attribute__((weak)) etl::expected<void, HalError> removeFile(
   return etl::unexpected<HalError>(HalError::NOT_IMPLEMENTED);
 }
 
+namespace {
+#if BRIDGE_ENABLE_EEPROM && defined(ARDUINO_ARCH_AVR)
+constexpr uint16_t kNvSize = (BRIDGE_EEPROM_SIZE != 0)
+                                 ? BRIDGE_EEPROM_SIZE
+                                 : (E2END + 1 - BRIDGE_EEPROM_OFFSET);
+static_assert(BRIDGE_EEPROM_OFFSET + kNvSize <= E2END + 1,
+              "BRIDGE_EEPROM_OFFSET/SIZE do not fit in this EEPROM");
+
+inline uint8_t* _nvAddress(uint16_t addr) {
+  return reinterpret_cast<uint8_t*>(
+      static_cast<uintptr_t>(BRIDGE_EEPROM_OFFSET + addr));
+}
+#elif BRIDGE_ENABLE_EEPROM && defined(ARDUINO_ARCH_ESP32)
+// The ESP32 core emulates EEPROM in RAM, committed to a flash partition that
+// has to be sized up front.
+constexpr uint16_t kNvSize =
+    (BRIDGE_EEPROM_SIZE != 0) ? BRIDGE_EEPROM_SIZE : 1024U;
+
+// Set by nvWrite() until nvCommit() has flushed the RAM copy to flash.
+bool g_nv_dirty = false;
+
+bool _nvReady() {
+  static const bool ready = EEPROM.begin(BRIDGE_EEPROM_OFFSET + kNvSize);
+  return ready;
+}
+#endif
+}  // namespace
+
+__attribute__((weak)) uint16_t nvSize() {
+#if BRIDGE_ENABLE_EEPROM && defined(ARDUINO_ARCH_AVR)
+  return kNvSize;
+#elif BRIDGE_ENABLE_EEPROM && defined(ARDUINO_ARCH_ESP32)
+  return _nvReady() ? kNvSize : 0U;
+#else
+  return 0U;
+#endif
+}
+
+__attribute__((weak)) etl::expected<void, HalError> nvRead(
+    uint16_t addr, etl::span<uint8_t> out) {
+  const uint16_t size = nvSize();
+  if (size == 0U) return etl::unexpected<HalError>(HalError::NOT_IMPLEMENTED);
+  if (static_cast<uint32_t>(addr) + out.size() > size)
+    return etl::unexpected<HalError>(HalError::INVALID_ARGUMENT);
+#if BRIDGE_ENABLE_EEPROM && defined(ARDUINO_ARCH_AVR)
+  eeprom_read_block(out.data(), _nvAddress(addr), out.size());
+#elif BRIDGE_ENABLE_EEPROM && defined(ARDUINO_ARCH_ESP32)
+  EEPROM.readBytes(BRIDGE_EEPROM_OFFSET + addr, out.data(), out.size());
+#endif
+  return {};
+}
+
+__attribute__((weak)) etl::expected<void, HalError> nvWrite(
+    uint16_t addr, etl::span<const uint8_t> data) {
+  const uint16_t size = nvSize();
+  if (size == 0U) return etl::unexpected<HalError>(HalError::NOT_IMPLEMENTED);
+  if (static_cast<uint32_t>(addr) + data.size() > size)
+    return etl::unexpected<HalError>(HalError::INVALID_ARGUMENT);
+#if BRIDGE_ENABLE_EEPROM && defined(ARDUINO_ARCH_AVR)
+  eeprom_update_block(data.data(), _nvAddress(addr), data.size());
+#elif BRIDGE_ENABLE_EEPROM && defined(ARDUINO_ARCH_ESP32)
+  for (size_t i = 0; i < data.size(); ++i) {
+    const int at = BRIDGE_EEPROM_OFFSET + addr + static_cast<int>(i);
+    if (EEPROM.read(at) == data[i]) continue;
+    EEPROM.write(at, data[i]);
+    g_nv_dirty = true;
+  }
+#endif
+  return {};
+}
+
+__attribute__((weak)) etl::expected<void, HalError> nvCommit() {
+#if BRIDGE_ENABLE_EEPROM && defined(ARDUINO_ARCH_ESP32)
+  if (g_nv_dirty) {
+    if (!EEPROM.commit()) return etl::unexpected<HalError>(HalError::IO_ERROR);
+    g_nv_dirty = false;
+  }
+#endif
+  return {};
+}
+
 void fillCapabilities(rpc_pb_Capabilities& caps) {
   caps.watchdog = bridge::config::ENABLE_WATCHDOG;
 
@@ -149,9 +326,7 @@ void fillCapabilities(rpc_pb_Capabilities& caps) {
 #if defined(BRIDGE_ENABLE_DEBUG_IO)
   caps.debug_io = true;
 #endif
-#if defined(BRIDGE_ENABLE_EEPROM)
-  caps.eeprom = true;
-#endif
+  caps.eeprom = nvSize() > 0U;
 #if defined(BRIDGE_ENABLE_DAC)
   caps.dac = true;
 #endif
@@ -174,6 +349,397 @@ void fillCapabilities(rpc_pb_Capabilities& caps) {
   caps.spi = (BRIDGE_ENABLE_SPI != 0);
 #endif
   caps.sd = !!hasSD();
+  caps.frame_timestamps = bridge::config::ENABLE_FRAME_TIMESTAMPS;
+}
+
+namespace {
+#if defined(ARDUINO_ARCH_AVR)
+volatile uint8_t* _portOutput(pinmap::Port p) {
+  switch (p) {
+    case pinmap::Port::PORT_B:
+      return &PORTB;
+#if defined(PORTC)
+    case pinmap::Port::PORT_C:
+      return &PORTC;
+#endif
+    case pinmap::Port::PORT_D:
+      return &PORTD;
+#if defined(PORTE)
+    case pinmap::Port::PORT_E:
+      return &PORTE;
+#endif
+#if defined(PORTF)
+    case pinmap::Port::PORT_F:
+      return &PORTF;
+#endif
+    default:
+      return nullptr;
+  }
+}
+
+volatile uint8_t* _portDirection(pinmap::Port p) {
+  switch (p) {
+    case pinmap::Port::PORT_B:
+      return &DDRB;
+#if defined(DDRC)
+    case pinmap::Port::PORT_C:
+      return &DDRC;
+#endif
+    case pinmap::Port::PORT_D:
+      return &DDRD;
+#if defined(DDRE)
+    case pinmap::Port::PORT_E:
+      return &DDRE;
+#endif
+#if defined(DDRF)
+    case pinmap::Port::PORT_F:
+      return &DDRF;
+#endif
+    default:
+      return nullptr;
+  }
+}
+
+volatile uint8_t* _portInput(pinmap::Port p) {
+  switch (p) {
+    case pinmap::Port::PORT_B:
+      return &PINB;
+#if defined(PINC)
+    case pinmap::Port::PORT_C:
+      return &PINC;
+#endif
+    case pinmap::Port::PORT_D:
+      return &PIND;
+#if defined(PINE)
+    case pinmap::Port::PORT_E:
+      return &PINE;
+#endif
+#if defined(PINF)
+    case pinmap::Port::PORT_F:
+      return &PINF;
+#endif
+    default:
+      return nullptr;
+  }
+}
+#endif
+
+// Pins left with a PWM timer attached by fastAnalogWrite(). Only the Arduino
+// API detaches the timer, so these skip the direct-port path once.
+volatile uint32_t _pwm_pins = 0;
+
+bool _hasDirectPort(uint8_t pin) {
+  return pinmap::HAS_DIRECT_PORTS && pin < pinmap::kPins.size();
+}
+
+bool _takePwm(uint8_t pin) {
+  if (pin >= 32U) return true;
+  const uint32_t bit = 1UL << pin;
+  bool attached = false;
+  BRIDGE_ATOMIC_BLOCK {
+    attached = (_pwm_pins & bit) != 0U;
+    _pwm_pins &= ~bit;
+  }
+  return attached;
+}
+
+// _takePwm() for a pin mask: the selected pins that had PWM attached.
+uint32_t _takePwmMask(uint32_t mask) {
+  uint32_t attached = 0;
+  BRIDGE_ATOMIC_BLOCK {
+    attached = _pwm_pins & mask;
+    _pwm_pins &= ~mask;
+  }
+  return attached;
+}
+}  // namespace
+
+void fastPinMode(uint8_t pin, uint8_t mode) {
+#if defined(ARDUINO_ARCH_AVR)
+  if (_hasDirectPort(pin)) {
+    const auto& loc = pinmap::kPins[pin];
+    volatile uint8_t* ddr = _portDirection(loc.port);
+    volatile uint8_t* out = _portOutput(loc.port);
+    const uint8_t bit = static_cast<uint8_t>(1U << loc.bit);
+    if (ddr && out) {
+      BRIDGE_ATOMIC_BLOCK {
+        if (mode == OUTPUT) {
+          *ddr |= bit;
+        } else {
+          *ddr &= static_cast<uint8_t>(~bit);
+          if (mode == INPUT_PULLUP)
+            *out |= bit;
+          else
+            *out &= static_cast<uint8_t>(~bit);
+        }
+      }
+      return;
+    }
+  }
+#endif
+  ::pinMode(pin, mode);
+}
+
+void fastDigitalWrite(uint8_t pin, uint8_t level) {
+  if (_takePwm(pin) || !_hasDirectPort(pin)) {
+    ::digitalWrite(pin, level);
+    return;
+  }
+#if defined(ARDUINO_ARCH_AVR)
+  const auto& loc = pinmap::kPins[pin];
+  volatile uint8_t* out = _portOutput(loc.port);
+  const uint8_t bit = static_cast<uint8_t>(1U << loc.bit);
+  if (out) {
+    BRIDGE_ATOMIC_BLOCK {
+      if (level == LOW)
+        *out &= static_cast<uint8_t>(~bit);
+      else
+        *out |= bit;
+    }
+    return;
+  }
+#endif
+  ::digitalWrite(pin, level);
+}
+
+int fastDigitalRead(uint8_t pin) {
+  if (_takePwm(pin) || !_hasDirectPort(pin)) return ::digitalRead(pin);
+#if defined(ARDUINO_ARCH_AVR)
+  const auto& loc = pinmap::kPins[pin];
+  volatile uint8_t* in = _portInput(loc.port);
+  if (in) return (*in & (1U << loc.bit)) ? HIGH : LOW;
+#endif
+  return ::digitalRead(pin);
+}
+
+void fastAnalogWrite(uint8_t pin, int value) {
+  ::analogWrite(pin, value);
+  if (pin >= 32U) return;
+  // 0 and 255 are plain digital writes in the Arduino core (timer detached).
+  const uint32_t bit = 1UL << pin;
+  BRIDGE_ATOMIC_BLOCK {
+    if (value > 0 && value < 255)
+      _pwm_pins |= bit;
+    else
+      _pwm_pins &= ~bit;
+  }
+}
+
+uint32_t pwmPins() {
+  uint32_t pins = 0;
+  BRIDGE_ATOMIC_BLOCK { pins = _pwm_pins; }
+  return pins;
+}
+
+void digitalWriteMask(uint32_t mask, uint32_t value) {
+  mask &= pinmap::kDigitalPinMask;
+  // On AVR the compare output of a PWM timer overrides PORTx, so those pins
+  // go through the core first to detach it, as in fastDigitalWrite().
+  const uint32_t pwm = _takePwmMask(mask);
+  for (uint8_t pin = 0; pin < bridge::config::DIGITAL_PINS; ++pin) {
+    const uint32_t bit = 1UL << pin;
+    if (pwm & bit) ::digitalWrite(pin, (value & bit) ? HIGH : LOW);
+  }
+  mask &= ~pwm;
+  if constexpr (pinmap::HAS_DIRECT_PORTS) {
+#if defined(ARDUINO_ARCH_AVR)
+    // Fold the pin mask into per-port set/clear masks first so the critical
+    // section is one read-modify-write per touched port.
+    etl::array<uint8_t, pinmap::PORT_COUNT> set_bits = {};
+    etl::array<uint8_t, pinmap::PORT_COUNT> clr_bits = {};
+    for (size_t i = 0; i < pinmap::kPins.size(); ++i) {
+      const uint32_t bit = 1UL << i;
+      if ((mask & bit) == 0U) continue;
+      const auto& loc = pinmap::kPins[i];
+      const size_t port = static_cast<size_t>(loc.port);
+      if (value & bit)
+        set_bits[port] |= static_cast<uint8_t>(1U << loc.bit);
+      else
+        clr_bits[port] |= static_cast<uint8_t>(1U << loc.bit);
+    }
+    BRIDGE_ATOMIC_BLOCK {
+      for (size_t p = 0; p < pinmap::PORT_COUNT; ++p) {
+        if ((set_bits[p] | clr_bits[p]) == 0U) continue;
+        volatile uint8_t* reg = _portOutput(static_cast<pinmap::Port>(p));
+        if (reg)
+          *reg = static_cast<uint8_t>((*reg & ~clr_bits[p]) | set_bits[p]);
+      }
+    }
+    return;
+#endif
+  }
+  for (uint8_t pin = 0; pin < bridge::config::DIGITAL_PINS; ++pin) {
+    const uint32_t bit = 1UL << pin;
+    if (mask & bit) ::digitalWrite(pin, (value & bit) ? HIGH : LOW);
+  }
+}
+
+uint32_t digitalReadPort(uint32_t mask) {
+  mask &= pinmap::kDigitalPinMask;
+  // Detach PWM left by fastAnalogWrite() first, as fastDigitalRead() does.
+  const uint32_t pwm = _takePwmMask(mask);
+  for (uint8_t pin = 0; pin < bridge::config::DIGITAL_PINS; ++pin) {
+    if (pwm & (1UL << pin)) static_cast<void>(::digitalRead(pin));
+  }
+  uint32_t levels = 0;
+  if constexpr (pinmap::HAS_DIRECT_PORTS) {
+#if defined(ARDUINO_ARCH_AVR)
+    etl::array<uint8_t, pinmap::PORT_COUNT> snapshot = {};
+    BRIDGE_ATOMIC_BLOCK {
+      for (size_t p = 0; p < pinmap::PORT_COUNT; ++p) {
+        volatile uint8_t* reg = _portInput(static_cast<pinmap::Port>(p));
+        if (reg) snapshot[p] = *reg;
+      }
+    }
+    for (size_t i = 0; i < pinmap::kPins.size(); ++i) {
+      const auto& loc = pinmap::kPins[i];
+      if (snapshot[static_cast<size_t>(loc.port)] & (1U << loc.bit))
+        levels |= 1UL << i;
+    }
+    return levels & mask;
+#endif
+  }
+  for (uint8_t pin = 0; pin < bridge::config::DIGITAL_PINS; ++pin) {
+    const uint32_t bit = 1UL << pin;
+    if ((mask & bit) && ::digitalRead(pin) != LOW) levels |= bit;
+  }
+  return levels;
+}
+
+__attribute__((weak)) bool startPeriodicTimer(uint32_t period_us,
+                                             void (*callback)()) {
+  if (callback == nullptr || period_us == 0U) return false;
+#if defined(ARDUINO_ARCH_AVR) && BRIDGE_ENABLE_TIMER1
+  // CTC mode, clk/64: 4 us per tick at 16 MHz, up to ~262 ms per period.
+  constexpr uint32_t kTicksPerMs = F_CPU / 64UL / 1000UL;
+  if (period_us > (65536UL * 1000UL) / kTicksPerMs) return false;
+  const uint32_t ticks = (period_us * kTicksPerMs) / 1000UL;
+  if (ticks == 0U || ticks > 65536UL) return false;
+  bool ok = true;
+  BRIDGE_ATOMIC_BLOCK {
+    if (g_timer1_callback == callback) {
+      // Re-arm by the owner: the counter already restarted at the last
+      // compare match, so only the next period changes and the time spent
+      // reaching this call is not added to it.
+      OCR1A = static_cast<uint16_t>(ticks - 1U);
+    } else if (g_timer1_callback != nullptr) {
+      ok = false;
+    } else {
+      g_timer1_callback = callback;
+      TCCR1A = 0;
+      TCCR1B = 0;
+      TCNT1 = 0;
+      OCR1A = static_cast<uint16_t>(ticks - 1U);
+      TCCR1B = _BV(WGM12) | _BV(CS11) | _BV(CS10);
+      TIFR1 = _BV(OCF1A);
+      TIMSK1 |= _BV(OCIE1A);
+    }
+  }
+  return ok;
+#else
+  return false;
+#endif
+}
+
+__attribute__((weak)) bool startAnalogConversion(uint8_t pin,
+                                                void (*done)(uint16_t)) {
+  if (done == nullptr) return false;
+#if defined(ARDUINO_ARCH_AVR) && defined(ADCSRA)
+  // The channel mapping of the core's analogRead().
+#if defined(analogPinToChannel)
+  const uint8_t channel = analogPinToChannel(pin);
+#else
+  const uint8_t channel = pin;
+#endif
+  bool ok = false;
+  BRIDGE_ATOMIC_BLOCK {
+    if (!g_adc_busy) {
+      g_adc_busy = true;
+      g_adc_callback = done;
+#if defined(ADCSRB) && defined(MUX5)
+      ADCSRB = static_cast<uint8_t>((ADCSRB & ~_BV(MUX5)) |
+                                    (((channel >> 3) & 0x01U) << MUX5));
+#endif
+      ADMUX = static_cast<uint8_t>((DEFAULT << 6) | (channel & 0x07U));
+      // Writing ADIF clears the flag a polled analogRead() leaves set, which
+      // would otherwise fire the interrupt with a stale result.
+      ADCSRA |= _BV(ADIF) | _BV(ADIE) | _BV(ADSC);
+      ok = true;
+    }
+  }
+  return ok;
+#else
+  (void)pin;
+  return false;
+#endif
+}
+
+int analogRead(uint8_t pin) {
+#if defined(ARDUINO_ARCH_AVR) && defined(ADCSRA)
+  for (;;) {
+    bool claimed = false;
+    BRIDGE_ATOMIC_BLOCK {
+      if (!g_adc_busy) {
+        g_adc_busy = true;
+        claimed = true;
+      }
+    }
+    if (claimed) break;
+  }
+  const int value = ::analogRead(pin);
+  g_adc_busy = false;
+  return value;
+#else
+  return ::analogRead(pin);
+#endif
+}
+
+__attribute__((weak)) void stopPeriodicTimer() {
+#if defined(ARDUINO_ARCH_AVR) && BRIDGE_ENABLE_TIMER1
+  BRIDGE_ATOMIC_BLOCK {
+    TIMSK1 &= static_cast<uint8_t>(~_BV(OCIE1A));
+    TCCR1B = 0;
+    g_timer1_callback = nullptr;
+  }
+#endif
+}
+
+bool startTask(void (*entry)(void*), void* arg) {
+  if (entry == nullptr) return false;
+#if BRIDGE_ENABLE_THREADED && defined(ARDUINO_ARCH_ESP32)
+  return xTaskCreatePinnedToCore(entry, "bridge",
+                                 bridge::config::TASK_STACK_BYTES, arg,
+                                 bridge::config::TASK_PRIORITY, nullptr,
+                                 bridge::config::TASK_CORE) == pdPASS;
+#elif BRIDGE_ENABLE_THREADED
+  std::thread(entry, arg).detach();
+  return true;
+#else
+  (void)arg;
+  return false;
+#endif
+}
+
+void yieldTask() {
+#if BRIDGE_ENABLE_THREADED && defined(ARDUINO_ARCH_ESP32)
+  taskYIELD();
+#elif BRIDGE_ENABLE_THREADED
+  std::this_thread::yield();
+#endif
+}
+
+void idleTask() {
+#if BRIDGE_ENABLE_THREADED && defined(ARDUINO_ARCH_ESP32)
+  vTaskDelay(1);
+#elif BRIDGE_ENABLE_THREADED
+  std::this_thread::yield();
+#endif
+}
+
+void endTask() {
+#if BRIDGE_ENABLE_THREADED && defined(ARDUINO_ARCH_ESP32)
+  vTaskDelete(nullptr);
+#endif
 }
 
 void getPinCounts(uint8_t& digital, uint8_t& analog) {
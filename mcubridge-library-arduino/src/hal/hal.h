@@ -61,6 +61,31 @@ void watchdog_kick();
  */
 uint16_t getFreeMemory();
 
+/**
+ * @brief Fill the gap between the heap and the current stack pointer with a
+ * canary pattern so stackUsage() can later find the deepest stack seen.
+ * Call once, as early and as shallow in the call chain as possible.
+ */
+void paintStack();
+
+/**
+ * @brief Scan the area painted by paintStack().
+ * @param peak Deepest stack (bytes below the top of RAM) reached so far,
+ * ISRs included.
+ * @param headroom Painted bytes never overwritten: the closest the stack
+ * has come to the heap.
+ * Both are 0 where painting is not supported.
+ */
+void stackUsage(uint16_t& peak, uint16_t& headroom);
+
+/**
+ * @brief Static RAM layout: total SRAM, initialized data, zeroed data and
+ * the bytes handed out by malloc(). All 0 where the linker symbols are not
+ * available.
+ */
+void ramSections(uint16_t& ram, uint16_t& data, uint16_t& bss,
+                 uint16_t& heap);
+
 /**
  * @brief Validate if a pin number is valid for the current board.
  * @param pin The pin number to validate.
@@ -101,11 +126,137 @@ etl::expected<ChunkResult, HalError> readFileChunk(etl::string_view path,
  */
 etl::expected<void, HalError> removeFile(etl::string_view path);
 
+/**
+ * @brief Size of the non-volatile region reserved for the KV store: the
+ * EEPROM bytes from BRIDGE_EEPROM_OFFSET (emulated in flash on ESP32).
+ * 0 when BRIDGE_ENABLE_EEPROM is off or the board has none.
+ */
+uint16_t nvSize();
+
+/**
+ * @brief Read @p out.size() bytes at @p addr, relative to the region.
+ */
+etl::expected<void, HalError> nvRead(uint16_t addr, etl::span<uint8_t> out);
+
+/**
+ * @brief Write @p data at @p addr, relative to the region. Bytes that already
+ * hold the value are not rewritten, so they cost neither time nor wear. On
+ * AVR this blocks for ~3.4 ms per changed byte. On ESP32 the bytes only
+ * reach flash at the next nvCommit().
+ */
+etl::expected<void, HalError> nvWrite(uint16_t addr,
+                                      etl::span<const uint8_t> data);
+
+/**
+ * @brief Persist every nvWrite() since the last commit. On ESP32 this
+ * rewrites the whole emulated EEPROM sector, so call it once per logical
+ * update, not per write. A no-op where writes are direct (AVR).
+ */
+etl::expected<void, HalError> nvCommit();
+
 /**
  * @brief Populate MCU capabilities directly into the Protobuf message.
  */
 void fillCapabilities(rpc_pb_Capabilities& caps);
 
+/**
+ * @brief Single-pin GPIO fast path. On boards with a constexpr pin map these
+ * access the port registers directly, skipping the PROGMEM table lookups and
+ * timer checks of the Arduino API; other pins and boards use the Arduino API.
+ * Pins driven through fastAnalogWrite() keep the Arduino semantics: the next
+ * fastDigitalWrite()/fastDigitalRead() goes through the core once to detach
+ * the PWM timer.
+ */
+void fastPinMode(uint8_t pin, uint8_t mode);
+void fastDigitalWrite(uint8_t pin, uint8_t level);
+int fastDigitalRead(uint8_t pin);
+void fastAnalogWrite(uint8_t pin, int value);
+
+/**
+ * @brief Pins (bit N for pin N) whose PWM timer fastAnalogWrite() left
+ * attached and that no digital access through this HAL has detached yet.
+ */
+uint32_t pwmPins();
+
+/**
+ * @brief Drive several digital pins in one operation. Bit N of @p mask selects
+ * pin N; the same bit of @p value chooses HIGH or LOW. On boards with a
+ * constexpr pin map the pins sharing a port register are updated with a
+ * single read-modify-write while interrupts are masked, so they switch
+ * together. Pins driven through fastAnalogWrite() are written through the
+ * Arduino API first to detach the PWM timer, so they switch just before the
+ * others.
+ */
+void digitalWriteMask(uint32_t mask, uint32_t value);
+
+/**
+ * @brief Sample several digital pins in one coherent snapshot. PWM left on
+ * the selected pins by fastAnalogWrite() is detached first, as
+ * fastDigitalRead() does.
+ * @return Pin levels as a bitmask, limited to the pins selected in @p mask.
+ */
+uint32_t digitalReadPort(uint32_t mask);
+
+/**
+ * @brief Call @p callback from a hardware timer interrupt every @p period_us.
+ * Only one periodic timer exists and it belongs to the first caller until
+ * stopPeriodicTimer(). Calling it again with the owning callback (also from
+ * inside that callback) only changes the period, starting at the next tick.
+ * On AVR this uses Timer1 when BRIDGE_ENABLE_TIMER1 is set.
+ * @return false when no timer is available or another callback owns it, so
+ * the caller has to pace itself with micros().
+ */
+bool startPeriodicTimer(uint32_t period_us, void (*callback)());
+
+/**
+ * @brief Stop the timer started by startPeriodicTimer(). Safe to call when it
+ * is not running.
+ */
+void stopPeriodicTimer();
+
+/**
+ * @brief Start converting analog channel @p pin (0 for A0, as analogRead()
+ * takes it) and return at once; the ADC-complete interrupt hands the result
+ * to @p done. [ISR] Callable from ISRs, @p done included, to chain the next
+ * conversion. One conversion runs at a time, on the core's DEFAULT
+ * reference. On AVR only.
+ * @return false when the ADC is busy or cannot convert in the background.
+ */
+bool startAnalogConversion(uint8_t pin, void (*done)(uint16_t value));
+
+/**
+ * @brief ::analogRead() that waits for a conversion started by
+ * startAnalogConversion() rather than corrupting it. Services read the ADC
+ * through this one. Not from ISRs.
+ */
+int analogRead(uint8_t pin);
+
+/**
+ * @brief Run @p entry(@p arg) on a task of its own: a FreeRTOS task pinned to
+ * BRIDGE_TASK_CORE on ESP32, a std::thread on the host. @p entry must end
+ * with endTask(). Only built with BRIDGE_ENABLE_THREADED.
+ * @return false when the target has no tasks or the task was not created.
+ */
+bool startTask(void (*entry)(void*), void* arg);
+
+/**
+ * @brief Let tasks of the same priority run; a task with more work waiting
+ * calls it between passes.
+ */
+void yieldTask();
+
+/**
+ * @brief Sleep a tick so lower priority tasks, and the idle task watchdog,
+ * run too; a task with nothing to do, or waiting on another, calls it.
+ */
+void idleTask();
+
+/**
+ * @brief Last call of a task started by startTask(). On ESP32 it deletes the
+ * task and does not return.
+ */
+void endTask();
+
 /**
  * @brief Get the architecture specific ID.
  */
@@ -129,15 +280,46 @@ void getPinCounts(uint8_t& digital, uint8_t& analog);
 #include <util/atomic.h>
 #define BRIDGE_ATOMIC_BLOCK ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
 #else
+// Restores the interrupt mask it found, like ATOMIC_RESTORESTATE, so blocks
+// nest (a fast GPIO write inside a GPIO batch) and are safe inside ISRs.
 struct BridgeAtomicGuard {
-  BridgeAtomicGuard() {
-    noInterrupts();
+#if defined(ARDUINO_ARCH_ESP32)
+  BridgeAtomicGuard() : _state(portSET_INTERRUPT_MASK_FROM_ISR()) {
     asm volatile("" ::: "memory");
   }
   ~BridgeAtomicGuard() {
     asm volatile("" ::: "memory");
-    interrupts();
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(_state);
   }
+  UBaseType_t _state;
+#elif defined(__arm__)
+  BridgeAtomicGuard() : _primask(__get_PRIMASK()) {
+    __disable_irq();
+    asm volatile("" ::: "memory");
+  }
+  ~BridgeAtomicGuard() {
+    asm volatile("" ::: "memory");
+    __set_PRIMASK(_primask);
+  }
+  uint32_t _primask;
+#elif defined(ARDUINO_STUB_INTERRUPT_MASK)
+  BridgeAtomicGuard() : _enabled(interruptsEnabled()) { noInterrupts(); }
+  ~BridgeAtomicGuard() {
+    if (_enabled) interrupts();
+  }
+  bool _enabled;
+#elif defined(ARDUINO_ARCH_ESP8266)
+  BridgeAtomicGuard() : _ps(xt_rsil(15)) { asm volatile("" ::: "memory"); }
+  ~BridgeAtomicGuard() {
+    asm volatile("" ::: "memory");
+    xt_wsr_ps(_ps);
+  }
+  uint32_t _ps;
+#else
+  // Blocks run inside ISRs (PinEvents -> Reflex -> fastDigitalWrite), where
+  // a bare interrupts() at the end would unmask them early.
+#error "BRIDGE_ATOMIC_BLOCK cannot save the interrupt mask on this core"
+#endif
 };
 #define BRIDGE_ATOMIC_BLOCK if (BridgeAtomicGuard _guard{}; true)
 #endif
@@ -0,0 +1,142 @@
+#ifndef PROTOCOL_BOND_REORDER_H
+#define PROTOCOL_BOND_REORDER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#undef min
+#undef max
+#include <etl/algorithm.h>
+#include <etl/array.h>
+#include <etl/span.h>
+
+namespace bridge {
+
+/**
+ * @brief Puts frames striped over bonded links back in order.
+ *
+ * A bonded sender numbers its frames with a shared 16-bit counter and
+ * spreads them over its links, so a frame can overtake the one before it.
+ * accept() tells whether a frame is the next one, keeps a copy of one that
+ * is up to Window frames early, and drops one that is already past. Frames
+ * kept are handed to deliver(span) once the gap before them fills. They are
+ * also handed on when the gap is given up: by a frame landing past the
+ * window, or by expire() after a timeout. A frame lost on its link is
+ * resent by the reliable layer under a new number, so its slot can go.
+ */
+template <size_t Window, size_t FrameSize>
+class BondReorder {
+  static_assert(Window > 0U && (Window & (Window - 1U)) == 0U,
+                "the reorder window must be a power of two");
+
+ public:
+  enum class Verdict : uint8_t {
+    NEXT,   // In order: handle it, then call release().
+    HELD,   // Early: kept until the frames before it arrive.
+    STALE,  // Already passed or already held: drop it.
+  };
+
+  /** Expect frame 0 next, as after a link reset on both ends. */
+  void reset() {
+    _next = 0;
+    _held = 0;
+    for (Slot& s : _slots) s.length = 0;
+  }
+
+  uint8_t held() const { return _held; }
+
+  /**
+   * Sort frame @p seq in. A frame too far ahead first hands every held
+   * frame to @p deliver, in order, and restarts the window at @p seq; so
+   * does one so far behind that the sender must have started over.
+   */
+  template <typename Deliver>
+  Verdict accept(uint16_t seq, etl::span<const uint8_t> frame,
+                 uint32_t now_ms, Deliver&& deliver) {
+    const int16_t ahead = static_cast<int16_t>(seq - _next);
+    if (ahead < 0 && ahead > -kResyncDistance) return Verdict::STALE;
+    if (ahead < 0 || ahead >= static_cast<int16_t>(Window)) {
+      _flush(deliver);
+      _next = seq;
+    } else if (ahead > 0) {
+      Slot& s = _slots[seq % Window];
+      if (s.length != 0U) return Verdict::STALE;
+      s.seq = seq;
+      s.length = static_cast<uint16_t>(etl::min(frame.size(), FrameSize));
+      etl::copy_n(frame.data(), s.length, s.bytes.data());
+      if (_held++ == 0U) _wait_since_ms = now_ms;
+      return Verdict::HELD;
+    }
+    ++_next;
+    return Verdict::NEXT;
+  }
+
+  /** Hand on the held frames that are now in order. */
+  template <typename Deliver>
+  void release(Deliver&& deliver) {
+    while (_held > 0U) {
+      Slot& s = _slots[_next % Window];
+      if (s.length == 0U || s.seq != _next) return;
+      _take(s, deliver);
+    }
+  }
+
+  /**
+   * Give up on a gap that held frames have waited on for @p gap_ms: skip to
+   * the first held frame and hand on what is then in order.
+   */
+  template <typename Deliver>
+  void expire(uint32_t now_ms, uint32_t gap_ms, Deliver&& deliver) {
+    if (_held == 0U || now_ms - _wait_since_ms < gap_ms) return;
+    for (size_t i = 0; i < Window; ++i) {
+      const Slot& s = _slots[_next % Window];
+      if (s.length != 0U && s.seq == _next) break;
+      ++_next;
+    }
+    release(deliver);
+    _wait_since_ms = now_ms;
+  }
+
+ private:
+  // Further behind than this, a frame means the sender started over.
+  static constexpr int16_t kResyncDistance = 256;
+
+  struct Slot {
+    uint16_t seq;
+    uint16_t length;  // 0: free.
+    etl::array<uint8_t, FrameSize> bytes;
+  };
+
+  // The slot is freed and the window moved on before deliver() runs, so a
+  // link reset inside it (reset()) leaves nothing half done. Nothing fills
+  // slots while deliver() runs: frames only arrive from the serial task.
+  template <typename Deliver>
+  void _take(Slot& s, Deliver& deliver) {
+    const size_t length = s.length;
+    s.length = 0;
+    --_held;
+    ++_next;
+    deliver(etl::span<const uint8_t>(s.bytes.data(), length));
+  }
+
+  template <typename Deliver>
+  void _flush(Deliver& deliver) {
+    for (size_t i = 0; i < Window && _held > 0U; ++i) {
+      Slot& s = _slots[_next % Window];
+      if (s.length != 0U && s.seq == _next) {
+        _take(s, deliver);
+      } else {
+        ++_next;
+      }
+    }
+  }
+
+  etl::array<Slot, Window> _slots = {};
+  uint32_t _wait_since_ms = 0;
+  uint16_t _next = 0;
+  uint8_t _held = 0;
+};
+
+}  // namespace bridge
+
+#endif  // PROTOCOL_BOND_REORDER_H
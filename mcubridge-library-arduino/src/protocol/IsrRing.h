@@ -0,0 +1,92 @@
+#ifndef PROTOCOL_ISR_RING_H
+#define PROTOCOL_ISR_RING_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#undef min
+#undef max
+#include <etl/array.h>
+#include <etl/atomic.h>
+
+namespace bridge {
+
+/**
+ * @brief Wait-free ring with one producer (interrupt handlers) and one
+ * consumer (process()).
+ *
+ * The producer writes a slot and publishes it by moving the tail; the
+ * consumer reads published slots and frees them by moving the head. Each
+ * index is a single byte written by one side only, so neither side masks
+ * interrupts, retries or waits. "One producer" means one context at a time:
+ * ISRs that cannot preempt each other (every ISR on AVR, one priority level
+ * on one core elsewhere). Code that is not an ISR must push from inside
+ * BRIDGE_ATOMIC_BLOCK. A push into a full ring is refused and counted.
+ */
+template <typename T, size_t N>
+class IsrRing {
+  static_assert(N > 0U && N <= 128U && (N & (N - 1U)) == 0U,
+                "the ring size must be a power of two up to 128");
+
+ public:
+  /** [ISR] Producer side. @return false, counting it, when the ring is full. */
+  bool push(const T& value) {
+    const uint8_t tail = _tail.load(etl::memory_order_relaxed);
+    const uint8_t fill = static_cast<uint8_t>(
+        tail - _head.load(etl::memory_order_acquire));
+    if (fill == N) {
+      _overflows.store(
+          static_cast<uint8_t>(_overflows.load(etl::memory_order_relaxed) + 1U),
+          etl::memory_order_relaxed);
+      return false;
+    }
+    _slots[tail & (N - 1U)] = value;
+    _tail.store(static_cast<uint8_t>(tail + 1U), etl::memory_order_release);
+    if (fill >= _peak.load(etl::memory_order_relaxed)) {
+      _peak.store(static_cast<uint8_t>(fill + 1U), etl::memory_order_relaxed);
+    }
+    return true;
+  }
+
+  /** Consumer side: published elements not yet popped. */
+  uint8_t size() const {
+    return static_cast<uint8_t>(_tail.load(etl::memory_order_acquire) -
+                                _head.load(etl::memory_order_relaxed));
+  }
+
+  /** Consumer side: the @p i-th oldest element, for i < size(). */
+  const T& peek(uint8_t i) const {
+    return _slots[(_head.load(etl::memory_order_relaxed) + i) & (N - 1U)];
+  }
+
+  /** Consumer side: free the @p n oldest elements, n <= size(). */
+  void pop(uint8_t n) {
+    _head.store(static_cast<uint8_t>(_head.load(etl::memory_order_relaxed) + n),
+                etl::memory_order_release);
+  }
+
+  /** Consumer side: free everything published so far. */
+  void clear() {
+    _head.store(_tail.load(etl::memory_order_acquire),
+                etl::memory_order_release);
+  }
+
+  /** Pushes refused since boot, modulo 256. */
+  uint8_t overflows() const {
+    return _overflows.load(etl::memory_order_relaxed);
+  }
+  /** Highest fill since boot. */
+  uint8_t peak() const { return _peak.load(etl::memory_order_relaxed); }
+
+ private:
+  etl::array<T, N> _slots = {};
+  etl::atomic<uint8_t> _head{0U};
+  etl::atomic<uint8_t> _tail{0U};
+  // Producer only, like _tail.
+  etl::atomic<uint8_t> _overflows{0U};
+  etl::atomic<uint8_t> _peak{0U};
+};
+
+}  // namespace bridge
+
+#endif  // PROTOCOL_ISR_RING_H
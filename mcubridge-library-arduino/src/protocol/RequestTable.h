@@ -0,0 +1,193 @@
+#ifndef PROTOCOL_REQUEST_TABLE_H
+#define PROTOCOL_REQUEST_TABLE_H
+
+#include <Arduino.h>
+#include <string.h>
+
+#include "config/bridge_config.h"
+#undef min
+#undef max
+#include <etl/delegate.h>
+#include <etl/type_traits.h>
+#include <etl/vector.h>
+
+namespace bridge {
+
+/** How an MCU→Linux request ended. */
+enum class RequestStatus : uint8_t {
+  OK,        // Linux answered with the expected response.
+  TIMEOUT,   // No answer before the deadline.
+  REJECTED,  // Linux answered STATUS_ERROR.
+  LOST,      // The link dropped (enterSafeState()) or the owner cancelled.
+};
+
+namespace detail {
+template <typename F>
+struct completion_traits;
+template <typename H, typename R>
+struct completion_traits<void (*)(const H&, RequestStatus, const R*)> {
+  using Handler = H;
+  using Response = R;
+};
+}  // namespace detail
+
+/**
+ * @brief Requests the MCU sent to Linux and is waiting on, keyed by sequence.
+ *
+ * Each entry remembers the sequence id the request went out with, the
+ * command id of the response that completes it, a deadline and the caller's
+ * handler (any delegate-sized type). Completion goes through a function
+ * chosen at compile time, Complete(handler, status, response), which turns
+ * the decoded response into the handler's own signature; response is null
+ * unless the status is OK. Every request completes exactly once, and its
+ * entry is freed before Complete runs, so Complete may issue the next
+ * request.
+ */
+class RequestTable {
+ public:
+  static constexpr size_t kCapacity = bridge::config::MAX_PENDING_REQUESTS;
+
+  bool empty() const { return _entries.empty(); }
+  bool full() const { return _entries.full(); }
+  size_t size() const { return _entries.size(); }
+
+  template <auto Complete, typename Handler>
+  bool add(uint16_t sequence, uint16_t response, uint32_t timeout_ms,
+           const Handler& handler) {
+    using Traits = detail::completion_traits<decltype(Complete)>;
+    static_assert(sizeof(Handler) <= kHandlerSize,
+                  "request handlers must fit in a delegate");
+    static_assert(etl::is_same_v<typename Traits::Handler, Handler>,
+                  "Complete takes a different handler type");
+    if (_entries.full()) return false;
+    Entry e = {};
+    e.deadline_ms = ::millis() + timeout_ms;
+    e.timeout_ms = timeout_ms;
+    e.sequence = sequence;
+    e.response = response;
+    e.complete = &_complete<Complete>;
+    memcpy(e.handler, &handler, sizeof(Handler));
+    _entries.push_back(e);
+    return true;
+  }
+
+  /** Whether a response @p response with @p sequence is awaited. */
+  bool awaits(uint16_t sequence, uint16_t response) const {
+    for (const Entry& e : _entries) {
+      if (e.sequence == sequence && e.response == response) return true;
+    }
+    return false;
+  }
+
+  /**
+   * Hand @p msg to the request waiting for it. With @p last false the
+   * request stays open for more parts and its deadline starts over.
+   * @return false if no request was waiting for it.
+   */
+  template <typename Response>
+  bool complete(uint16_t sequence, uint16_t response, const Response& msg,
+                bool last = true) {
+    Entry* e = _find(sequence, response);
+    if (e == nullptr) return false;
+    if (!last) {
+      e->deadline_ms = ::millis() + e->timeout_ms;
+      const Entry part = *e;
+      part.complete(part, RequestStatus::OK, &msg);
+      return true;
+    }
+    _finish(e, RequestStatus::OK, &msg);
+    return true;
+  }
+
+  /** End the request sent as @p sequence with @p status, if still open. */
+  bool fail(uint16_t sequence, RequestStatus status) {
+    for (Entry& e : _entries) {
+      if (e.sequence == sequence) {
+        _finish(&e, status, nullptr);
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /** Drop the request sent as @p sequence without completing it. */
+  void discard(uint16_t sequence) {
+    for (auto it = _entries.begin(); it != _entries.end(); ++it) {
+      if (it->sequence == sequence) {
+        _entries.erase(it);
+        return;
+      }
+    }
+  }
+
+  /** End every request waiting for @p response (0: all) with @p status. */
+  void cancel(uint16_t response, RequestStatus status) {
+    // Complete may add requests: only end those that were open on entry.
+    for (size_t n = _entries.size(); n > 0U; --n) {
+      Entry* e = nullptr;
+      for (Entry& it : _entries) {
+        if (response == 0U || it.response == response) {
+          e = &it;
+          break;
+        }
+      }
+      if (e == nullptr) return;
+      _finish(e, status, nullptr);
+    }
+  }
+
+  /** Time out every request past its deadline. */
+  void expire() {
+    const uint32_t now = ::millis();
+    for (size_t n = _entries.size(); n > 0U; --n) {
+      Entry* e = nullptr;
+      for (Entry& it : _entries) {
+        if (static_cast<int32_t>(now - it.deadline_ms) >= 0) {
+          e = &it;
+          break;
+        }
+      }
+      if (e == nullptr) return;
+      _finish(e, RequestStatus::TIMEOUT, nullptr);
+    }
+  }
+
+ private:
+  static constexpr size_t kHandlerSize = sizeof(etl::delegate<void()>);
+
+  struct Entry {
+    uint32_t deadline_ms;
+    uint32_t timeout_ms;
+    uint16_t sequence;
+    uint16_t response;
+    void (*complete)(const Entry&, RequestStatus, const void*);
+    alignas(void*) uint8_t handler[kHandlerSize];
+  };
+
+  template <auto Complete>
+  static void _complete(const Entry& e, RequestStatus status,
+                        const void* msg) {
+    using Traits = detail::completion_traits<decltype(Complete)>;
+    Complete(*reinterpret_cast<const typename Traits::Handler*>(e.handler),
+             status, static_cast<const typename Traits::Response*>(msg));
+  }
+
+  Entry* _find(uint16_t sequence, uint16_t response) {
+    for (Entry& e : _entries) {
+      if (e.sequence == sequence && e.response == response) return &e;
+    }
+    return nullptr;
+  }
+
+  void _finish(Entry* e, RequestStatus status, const void* msg) {
+    const Entry done = *e;
+    _entries.erase(e);
+    done.complete(done, status, msg);
+  }
+
+  etl::vector<Entry, kCapacity> _entries;
+};
+
+}  // namespace bridge
+
+#endif  // PROTOCOL_REQUEST_TABLE_H
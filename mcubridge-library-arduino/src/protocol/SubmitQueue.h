@@ -0,0 +1,143 @@
+#ifndef PROTOCOL_SUBMIT_QUEUE_H
+#define PROTOCOL_SUBMIT_QUEUE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#undef min
+#undef max
+#include <etl/array.h>
+#include <etl/atomic.h>
+
+#include "hal/hal.h"
+
+class BridgeClass;
+
+namespace bridge {
+
+/**
+ * @brief Bounded lock-free queue with many producer tasks and one consumer.
+ *
+ * Each cell carries a sequence number saying whose turn it is: a producer
+ * claims the next position with a compare-and-swap on the tail, fills the
+ * cell and publishes it by moving the cell's sequence on; the consumer reads
+ * cells in order once they are published. Producers never wait on each
+ * other or on the consumer. A producer preempted between claiming and
+ * publishing holds the consumer up at that cell until it resumes.
+ */
+template <typename T, size_t N>
+class SubmitQueue {
+  static_assert(N > 0U && (N & (N - 1U)) == 0U,
+                "the submit queue size must be a power of two");
+
+ public:
+  SubmitQueue() {
+    for (size_t i = 0; i < N; ++i) {
+      _cells[i].sequence.store(i, etl::memory_order_relaxed);
+    }
+  }
+  SubmitQueue(const SubmitQueue&) = delete;
+  SubmitQueue& operator=(const SubmitQueue&) = delete;
+
+  /**
+   * Claim a cell, let @p fill(T&) write it and hand it to the consumer.
+   * Safe from any task. @return false, without calling @p fill, when full.
+   */
+  template <typename Fill>
+  bool push(Fill&& fill) {
+    size_t pos = _tail.load(etl::memory_order_relaxed);
+    for (;;) {
+      Cell& cell = _cells[pos & (N - 1U)];
+      const size_t seq = cell.sequence.load(etl::memory_order_acquire);
+      const ptrdiff_t lag = static_cast<ptrdiff_t>(seq - pos);
+      if (lag == 0) {
+        if (_tail.compare_exchange_weak(pos, pos + 1U,
+                                        etl::memory_order_relaxed,
+                                        etl::memory_order_relaxed)) {
+          fill(cell.value);
+          cell.sequence.store(pos + 1U, etl::memory_order_release);
+          return true;
+        }
+      } else if (lag < 0) {
+        return false;  // The consumer has not freed this cell yet.
+      } else {
+        pos = _tail.load(etl::memory_order_relaxed);
+      }
+    }
+  }
+
+  /**
+   * Hand the oldest published cell to @p consume(T&), then free it. Only
+   * the consumer task calls this. @return false when nothing is published.
+   */
+  template <typename Consume>
+  bool pop(Consume&& consume) {
+    Cell& cell = _cells[_head & (N - 1U)];
+    if (cell.sequence.load(etl::memory_order_acquire) != _head + 1U) {
+      return false;
+    }
+    consume(cell.value);
+    cell.sequence.store(_head + N, etl::memory_order_release);
+    ++_head;
+    return true;
+  }
+
+  /** Consumer side: true when pop() would find nothing. */
+  bool empty() const {
+    return _cells[_head & (N - 1U)].sequence.load(etl::memory_order_acquire) !=
+           _head + 1U;
+  }
+
+ private:
+  struct Cell {
+    etl::atomic<size_t> sequence;
+    T value;
+  };
+
+  etl::array<Cell, N> _cells;
+  etl::atomic<size_t> _tail{0U};
+  size_t _head = 0;  // Consumer only.
+};
+
+/**
+ * @brief Tells the task that called BridgeClass::submit() what became of it.
+ *
+ * The submitting task owns it and must keep it alive until done().
+ */
+class Completion {
+ public:
+  enum class Status : uint8_t {
+    PENDING,  // Still queued for the bridge task.
+    SENT,     // Sent, or queued for its ack like a send() from process().
+    FAILED,   // The bridge task could not send it (TX disabled or full).
+  };
+
+  Status status() const {
+    return static_cast<Status>(_status.load(etl::memory_order_acquire));
+  }
+  bool done() const { return status() != Status::PENDING; }
+
+  /** Yield until the bridge task has handled the submission. */
+  bool wait() const {
+    while (!done()) bridge::hal::idleTask();
+    return status() == Status::SENT;
+  }
+
+ private:
+  friend class ::BridgeClass;
+
+  void _arm() {
+    _status.store(static_cast<uint8_t>(Status::PENDING),
+                  etl::memory_order_relaxed);
+  }
+  void _finish(bool sent) {
+    _status.store(static_cast<uint8_t>(sent ? Status::SENT : Status::FAILED),
+                  etl::memory_order_release);
+  }
+
+  etl::atomic<uint8_t> _status{static_cast<uint8_t>(Status::PENDING)};
+};
+
+}  // namespace bridge
+
+#endif  // PROTOCOL_SUBMIT_QUEUE_H
@@ -0,0 +1,132 @@
+#include "services/Aggregator.h"
+
+#include <etl/algorithm.h>
+
+#if BRIDGE_ENABLE_AGGREGATOR
+
+#include "Bridge.h"
+
+static_assert(bridge::config::MAX_AGGREGATE_CHANNELS <= 8U,
+              "_pending_mask holds one bit per aggregated channel");
+
+etl::array<AggregatorClass::Window, bridge::config::MAX_AGGREGATE_CHANNELS>
+    AggregatorClass::_open = {};
+etl::array<AggregatorClass::Window, bridge::config::MAX_AGGREGATE_CHANNELS>
+    AggregatorClass::_closed = {};
+etl::array<uint8_t, bridge::config::MAX_AGGREGATE_CHANNELS>
+    AggregatorClass::_channels = {};
+uint32_t AggregatorClass::_sample_period_ms = 0;
+uint32_t AggregatorClass::_window_ms = 0;
+uint32_t AggregatorClass::_next_sample_ms = 0;
+uint32_t AggregatorClass::_window_start_ms = 0;
+uint32_t AggregatorClass::_closed_start_ms = 0;
+uint16_t AggregatorClass::_missed = 0;
+uint8_t AggregatorClass::_pending_mask = 0;
+uint8_t AggregatorClass::_channel_count = 0;
+
+AggregatorClass::AggregatorClass() {}
+
+bool AggregatorClass::configure(const rpc::payload::AggregateConfig& cfg) {
+  onLost();
+  if (cfg.channel_mask == 0U) return true;
+  constexpr uint32_t kValidMask =
+      (1UL << bridge::config::ANALOG_PINS) - 1UL;
+  if ((cfg.channel_mask & ~kValidMask) != 0U) return false;
+  if (cfg.sample_period_ms == 0U || cfg.window_ms < cfg.sample_period_ms)
+    return false;
+
+  uint8_t count = 0;
+  for (uint8_t ch = 0; ch < bridge::config::ANALOG_PINS; ++ch) {
+    if ((cfg.channel_mask & (1UL << ch)) == 0U) continue;
+    if (count == _channels.size()) return false;
+    _channels[count++] = ch;
+  }
+  _sample_period_ms = cfg.sample_period_ms;
+  _window_ms = cfg.window_ms;
+  _next_sample_ms = ::millis();
+  _window_start_ms = _next_sample_ms;
+  _channel_count = count;
+  return true;
+}
+
+void AggregatorClass::_accumulate(Window& w, uint16_t x) {
+  if (w.count == 0U) {
+    w.min = x;
+    w.max = x;
+  } else {
+    w.min = etl::min(w.min, x);
+    w.max = etl::max(w.max, x);
+  }
+  ++w.count;
+  // Welford: numerically stable running mean and sum of squared deviations.
+  const float delta = static_cast<float>(x) - w.mean;
+  w.mean += delta / static_cast<float>(w.count);
+  w.m2 += delta * (static_cast<float>(x) - w.mean);
+}
+
+void AggregatorClass::_closeWindow() {
+  if (_pending_mask != 0U && _missed < UINT16_MAX) ++_missed;
+  _closed = _open;
+  _closed_start_ms = _window_start_ms;
+  _pending_mask = static_cast<uint8_t>((1U << _channel_count) - 1U);
+  _open.fill(Window{});
+}
+
+void AggregatorClass::_flush() {
+  if (_pending_mask == 0U || !Bridge.isSynchronized()) return;
+  uint8_t i = 0;
+  while ((_pending_mask & (1U << i)) == 0U) ++i;
+
+  const Window& w = _closed[i];
+  rpc::payload::AggregateReport msg = rpc_pb_AggregateReport_init_default;
+  msg.channel = _channels[i];
+  msg.window_start_ms = _closed_start_ms;
+  msg.count = w.count;
+  msg.min = w.min;
+  msg.max = w.max;
+  msg.mean = w.mean;
+  msg.variance = (w.count != 0U) ? w.m2 / static_cast<float>(w.count) : 0.0f;
+  msg.missed_windows = _missed;
+  // One channel per pass keeps the pending TX queue available to others.
+  if (!Bridge.send(rpc::CommandId::CMD_AGGREGATE_REPORT, 0, msg)) return;
+  _pending_mask = static_cast<uint8_t>(_pending_mask & ~(1U << i));
+  _missed = 0;
+}
+
+void AggregatorClass::process() {
+  if (!running()) return;
+  const uint32_t now = ::millis();
+  if (now - _window_start_ms >= _window_ms) {
+    _closeWindow();
+    _window_start_ms += _window_ms;
+    if (now - _window_start_ms >= _window_ms) _window_start_ms = now;
+  }
+  if (static_cast<int32_t>(now - _next_sample_ms) >= 0) {
+    for (uint8_t i = 0; i < _channel_count; ++i) {
+      _accumulate(_open[i],
+                  static_cast<uint16_t>(bridge::hal::analogRead(_channels[i])));
+    }
+    _next_sample_ms += _sample_period_ms;
+    if (static_cast<int32_t>(now - _next_sample_ms) >= 0)
+      _next_sample_ms = now + _sample_period_ms;
+  }
+  _flush();
+}
+
+uint8_t AggregatorClass::pendingReports() {
+  uint8_t n = 0;
+  for (uint8_t m = _pending_mask; m != 0U; m &= static_cast<uint8_t>(m - 1U))
+    ++n;
+  return n;
+}
+
+void AggregatorClass::onLost() {
+  _channel_count = 0;
+  _pending_mask = 0;
+  _missed = 0;
+  _open.fill(Window{});
+}
+
+AggregatorType Aggregator;
+
+#endif  // BRIDGE_ENABLE_AGGREGATOR
@@ -0,0 +1,66 @@
+#ifndef SERVICES_AGGREGATOR_H
+#define SERVICES_AGGREGATOR_H
+
+#include "config/bridge_config.h"
+
+#if BRIDGE_ENABLE_AGGREGATOR
+
+#undef min
+#undef max
+#include <etl/array.h>
+
+#include "protocol/rpc_structs.h"
+
+/**
+ * @brief Windowed statistics over analog channels, one CMD_AGGREGATE_REPORT
+ * per channel and window.
+ *
+ * Count, min, max, mean and variance are updated per sample with Welford's
+ * recurrence, so each channel needs a fixed handful of bytes whatever the
+ * window length. A closed window is frozen while its reports drain; if the
+ * next one closes first, the older one is replaced and counted in
+ * missed_windows.
+ */
+class AggregatorClass {
+ public:
+  AggregatorClass();
+
+  /** Configure and restart all windows; channel_mask == 0 stops. */
+  static bool configure(const rpc::payload::AggregateConfig& cfg);
+  static void process();
+  static void onLost();
+
+  static bool running() { return _channel_count != 0U; }
+  static uint8_t pendingReports();
+
+ private:
+  struct Window {
+    uint32_t count;
+    float mean;
+    float m2;
+    uint16_t min;
+    uint16_t max;
+  };
+
+  static void _accumulate(Window& w, uint16_t x);
+  static void _closeWindow();
+  static void _flush();
+
+  static etl::array<Window, bridge::config::MAX_AGGREGATE_CHANNELS> _open;
+  static etl::array<Window, bridge::config::MAX_AGGREGATE_CHANNELS> _closed;
+  static etl::array<uint8_t, bridge::config::MAX_AGGREGATE_CHANNELS> _channels;
+  static uint32_t _sample_period_ms;
+  static uint32_t _window_ms;
+  static uint32_t _next_sample_ms;
+  static uint32_t _window_start_ms;
+  static uint32_t _closed_start_ms;
+  static uint16_t _missed;
+  static uint8_t _pending_mask;
+  static uint8_t _channel_count;
+};
+
+using AggregatorType = AggregatorClass;
+extern AggregatorType Aggregator;
+
+#endif  // BRIDGE_ENABLE_AGGREGATOR
+#endif  // SERVICES_AGGREGATOR_H
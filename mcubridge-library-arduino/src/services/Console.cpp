@@ -17,6 +17,11 @@ void ConsoleClass::_push(const rpc::payload::ConsoleWrite& msg) {
   const size_t to_write =
       etl::min(static_cast<size_t>(data.size), _rx_buffer.available());
   _rx_buffer.push(data.bytes, data.bytes + to_write);
+  if (to_write < data.size) {
+    Bridge.countLink(BridgeClass::LinkCounter::CONSOLE_RX_OVERFLOW,
+                     static_cast<uint16_t>(data.size - to_write));
+  }
+  _rx_peak = etl::max(_rx_peak, static_cast<uint16_t>(_rx_buffer.size()));
 }
 
 void ConsoleClass::process() {
@@ -35,6 +40,7 @@ size_t ConsoleClass::write(uint8_t c) {
   if (_tx_buffer.full()) process();
   if (!_tx_buffer.full()) {
     _tx_buffer.push_back(c);
+    _noteTxPeak();
     return 1;
   }
   return 0;
@@ -45,12 +51,14 @@ size_t ConsoleClass::write(const uint8_t* buffer, size_t size) {
   if (_tx_buffer.full()) process();
   const size_t to_write = etl::min(size, _tx_buffer.available());
   _tx_buffer.insert(_tx_buffer.end(), buffer, buffer + to_write);
+  _noteTxPeak();
   if (to_write < size && _tx_buffer.full()) {
     process();
     const size_t extra_write =
         etl::min(size - to_write, _tx_buffer.available());
     _tx_buffer.insert(_tx_buffer.end(), buffer + to_write,
                       buffer + to_write + extra_write);
+    _noteTxPeak();
     return to_write + extra_write;
   }
   return to_write;
@@ -6,6 +6,7 @@
 #include "config/bridge_config.h"
 #undef min
 #undef max
+#include <etl/algorithm.h>
 #include <etl/bitset.h>
 #include <etl/circular_buffer.h>
 #include <etl/vector.h>
@@ -22,6 +23,10 @@ class ConsoleClass : public Stream {
 
   void onLost() { _flags.reset(BEGUN); }
 
+  // Highest buffer fill (bytes) seen since boot, for CMD_GET_MEMORY_PROFILE.
+  uint16_t rxPeak() const { return _rx_peak; }
+  uint16_t txPeak() const { return _tx_peak; }
+
   // Stream implementation
   size_t write(uint8_t c) override;
   size_t write(const uint8_t* buffer, size_t size) override;
@@ -32,7 +37,13 @@ class ConsoleClass : public Stream {
 
  private:
   enum Flags { BEGUN = 0 };
+  void _noteTxPeak() {
+    _tx_peak = etl::max(_tx_peak, static_cast<uint16_t>(_tx_buffer.size()));
+  }
+
   etl::bitset<1> _flags;
+  uint16_t _rx_peak = 0;
+  uint16_t _tx_peak = 0;
   etl::circular_buffer<uint8_t, bridge::config::CONSOLE_RX_BUFFER_SIZE>
       _rx_buffer;
   etl::vector<uint8_t, bridge::config::CONSOLE_TX_BUFFER_SIZE> _tx_buffer;
@@ -26,7 +26,7 @@ void DataStoreClass::set(etl::string_view key, etl::span<const uint8_t> value) {
 
 void DataStoreClass::get(etl::string_view key,
                          typename DataStoreClass::GetHandler handler) {
-  if (_pending_gets.full()) {
+  if (!Bridge.canRequest()) {
     Bridge.emitStatus(rpc::StatusCode::STATUS_ERROR);
     return;
   }
@@ -37,24 +37,23 @@ void DataStoreClass::get(etl::string_view key,
     etl::copy_n(key.begin(), k_copy, p.key);
   }
 
-  if (!Bridge.send(rpc::CommandId::CMD_DATASTORE_GET, 0, p)) {
+  if (!Bridge.request<&DataStoreClass::_onResponse>(
+          rpc::CommandId::CMD_DATASTORE_GET, p,
+          rpc::CommandId::CMD_DATASTORE_GET_RESP, handler)) {
     Bridge.emitStatus(rpc::StatusCode::STATUS_ERROR);
-    return;
   }
-
-  _pending_gets.push(handler);
 }
 
 void DataStoreClass::_onResponse(
-    const rpc::payload::DatastoreGetResponse& msg) {
-  if (_pending_gets.empty()) return;
-
-  const GetHandler handler = _pending_gets.front();
-  _pending_gets.pop();
+    const GetHandler& handler, bridge::RequestStatus,
+    const rpc::payload::DatastoreGetResponse* msg) {
   if (!handler.is_valid()) return;
-
+  if (msg == nullptr) {
+    handler(etl::string_view(), etl::span<const uint8_t>());
+    return;
+  }
   handler(etl::string_view(),
-          etl::span<const uint8_t>(msg.value.bytes, msg.value.size));
+          etl::span<const uint8_t>(msg->value.bytes, msg->value.size));
 }
 
 DataStoreType DataStore;
@@ -5,11 +5,11 @@
 #undef min
 #undef max
 #include <etl/delegate.h>
-#include <etl/queue.h>
 #include <etl/span.h>
 #include <etl/string.h>
 #include <etl/string_view.h>
 
+#include "protocol/RequestTable.h"
 #include "protocol/rpc_structs.h"
 
 class DataStoreClass {
@@ -19,13 +19,15 @@ class DataStoreClass {
 
   DataStoreClass();
   static void set(etl::string_view key, etl::span<const uint8_t> value);
+  /**
+   * Ask Linux for @p key. @p handler gets the value, or an empty one if
+   * Linux does not answer in time or the link drops.
+   */
   void get(etl::string_view key, GetHandler handler);
 
-  void _onResponse(const rpc::payload::DatastoreGetResponse& msg);
-
-  void onLost() { _pending_gets.clear(); }
-
-  etl::queue<GetHandler, bridge::config::MAX_PENDING_DATASTORE> _pending_gets;
+  static void _onResponse(const GetHandler& handler,
+                          bridge::RequestStatus status,
+                          const rpc::payload::DatastoreGetResponse* msg);
 };
 
 using DataStoreType = DataStoreClass;
@@ -0,0 +1,57 @@
+#include "services/Events.h"
+
+#include <etl/algorithm.h>
+
+#if BRIDGE_ENABLE_EVENTS
+
+#include "Bridge.h"
+
+bridge::IsrRing<EventsClass::Event, bridge::config::EVENT_RING_SIZE>
+    EventsClass::_ring;
+uint16_t EventsClass::_dropped = 0;
+uint8_t EventsClass::_overflows_seen = 0;
+
+EventsClass::EventsClass() {}
+
+// The ring only keeps an 8-bit count of refused pushes; fold it in on every
+// pass, batch sent or not, so it cannot lap between two batches.
+void EventsClass::_countOverflows() {
+  const uint8_t overflows = _ring.overflows();
+  const uint8_t fresh = static_cast<uint8_t>(overflows - _overflows_seen);
+  _overflows_seen = overflows;
+  _dropped = static_cast<uint16_t>(
+      etl::min<uint32_t>(static_cast<uint32_t>(_dropped) + fresh, UINT16_MAX));
+}
+
+void EventsClass::process() {
+  _countOverflows();
+  if (!Bridge.isSynchronized()) return;
+  rpc::payload::EventBatch msg = rpc_pb_EventBatch_init_default;
+  constexpr size_t kMaxEvents = sizeof(msg.events) / sizeof(msg.events[0]);
+  const uint8_t count =
+      static_cast<uint8_t>(etl::min<size_t>(_ring.size(), kMaxEvents));
+  if (count == 0U && _dropped == 0U) return;
+  for (uint8_t i = 0; i < count; ++i) {
+    const Event& e = _ring.peek(i);
+    msg.events[i].id = e.id;
+    msg.events[i].value = e.value;
+    msg.events[i].timestamp_ms = e.timestamp_ms;
+  }
+  msg.events_count = count;
+  msg.dropped = _dropped;
+  // TX busy: keep the events; the next pass sends them with any that
+  // arrived meanwhile.
+  if (!Bridge.send(rpc::CommandId::CMD_EVENT_BATCH, 0, msg)) return;
+  _ring.pop(count);
+  _dropped = 0U;
+}
+
+void EventsClass::onLost() {
+  _ring.clear();
+  _overflows_seen = _ring.overflows();
+  _dropped = 0U;
+}
+
+EventsType Events;
+
+#endif  // BRIDGE_ENABLE_EVENTS
@@ -0,0 +1,65 @@
+#ifndef SERVICES_EVENTS_H
+#define SERVICES_EVENTS_H
+
+#include "config/bridge_config.h"
+
+#if BRIDGE_ENABLE_EVENTS
+
+#include <Arduino.h>
+
+#include "protocol/IsrRing.h"
+#include "protocol/rpc_structs.h"
+
+/**
+ * @brief Events the sketch records from interrupt handlers, pushed to Linux
+ * as batched CMD_EVENT_BATCH.
+ *
+ * An ISR cannot call Bridge.send(): sending takes atomic blocks, encodes
+ * and writes to the Stream. Events.push() only stamps the event with
+ * millis() and stores it in a wait-free ring, a few dozen cycles on AVR.
+ * process() drains the ring in batches; events that found it full are
+ * counted and reported as dropped with the next batch.
+ *
+ * @code
+ * void onEncoderTick() { Events.push(EVT_ENCODER, TCNT1); }
+ * @endcode
+ */
+class EventsClass {
+ public:
+  EventsClass();
+
+  /**
+   * [ISR] Record event @p id with @p value. Wait-free. Call it from ISRs
+   * that cannot preempt each other, or from BRIDGE_ATOMIC_BLOCK elsewhere.
+   * @return false when the ring is full and the event was dropped.
+   */
+  static bool push(uint8_t id, uint16_t value = 0) {
+    return _ring.push(Event{::millis(), value, id});
+  }
+
+  static void process();
+  static void onLost();
+
+  static size_t pending() { return _ring.size(); }
+  /** Highest ring fill since boot, for CMD_GET_MEMORY_PROFILE. */
+  static uint8_t ringPeak() { return _ring.peak(); }
+
+ private:
+  struct Event {
+    uint32_t timestamp_ms;
+    uint16_t value;
+    uint8_t id;
+  };
+
+  static void _countOverflows();
+
+  static bridge::IsrRing<Event, bridge::config::EVENT_RING_SIZE> _ring;
+  static uint16_t _dropped;
+  static uint8_t _overflows_seen;
+};
+
+using EventsType = EventsClass;
+extern EventsType Events;
+
+#endif  // BRIDGE_ENABLE_EVENTS
+#endif  // SERVICES_EVENTS_H
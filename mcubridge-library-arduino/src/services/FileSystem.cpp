@@ -35,14 +35,15 @@ void FileSystemClass::write(etl::string_view path,
 void FileSystemClass::read(
     etl::string_view path,
     typename FileSystemClass::FileSystemReadHandler handler) {
-  _read_handler = handler;
   rpc::payload::FileRead p = {};
   const size_t p_copy = etl::min(path.size(), sizeof(p.path) - 1U);
   if (p_copy > 0U) {
     etl::copy_n(path.begin(), p_copy, p.path);
   }
 
-  if (!Bridge.send(rpc::CommandId::CMD_FILE_READ, 0, p)) {
+  if (!Bridge.request<&FileSystemClass::_onResponse>(
+          rpc::CommandId::CMD_FILE_READ, p, rpc::CommandId::CMD_FILE_READ_RESP,
+          handler)) {
     Bridge.emitStatus(rpc::StatusCode::STATUS_ERROR);
   }
 }
@@ -123,11 +124,15 @@ void FileSystemClass::_onRemove(const rpc::payload::FileRemove& msg) {
   }
 }
 
-void FileSystemClass::_onResponse(const rpc::payload::FileReadResponse& msg) {
-  if (_read_handler.is_valid()) {
-    _read_handler(
-        etl::span<const uint8_t>(msg.content.bytes, msg.content.size));
+void FileSystemClass::_onResponse(const FileSystemReadHandler& handler,
+                                  bridge::RequestStatus,
+                                  const rpc::payload::FileReadResponse* msg) {
+  if (!handler.is_valid()) return;
+  if (msg == nullptr) {
+    handler(etl::span<const uint8_t>());
+    return;
   }
+  handler(etl::span<const uint8_t>(msg->content.bytes, msg->content.size));
 }
 
 FileSystemType FileSystem;
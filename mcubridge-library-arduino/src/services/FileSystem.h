@@ -8,6 +8,7 @@
 #include <etl/span.h>
 #include <etl/string_view.h>
 
+#include "protocol/RequestTable.h"
 #include "protocol/rpc_structs.h"
 
 class FileSystemClass {
@@ -16,18 +17,19 @@ class FileSystemClass {
 
   FileSystemClass();
   static void write(etl::string_view path, etl::span<const uint8_t> data);
+  /**
+   * Read @p path from Linux. @p handler gets each chunk, then an empty one
+   * at EOF; a read Linux refuses or stops answering ends with an empty one.
+   */
   void read(etl::string_view path, FileSystemReadHandler handler);
   static void remove(etl::string_view path);
 
   static void _onWrite(const rpc::payload::FileWrite& msg);
   static void _onRead(const rpc::payload::FileRead& msg);
   static void _onRemove(const rpc::payload::FileRemove& msg);
-  void _onResponse(const rpc::payload::FileReadResponse& msg);
-
-  void onLost() { _read_handler = FileSystemReadHandler{}; }
-
- private:
-  FileSystemReadHandler _read_handler;
+  static void _onResponse(const FileSystemReadHandler& handler,
+                          bridge::RequestStatus status,
+                          const rpc::payload::FileReadResponse* msg);
 };
 
 using FileSystemType = FileSystemClass;
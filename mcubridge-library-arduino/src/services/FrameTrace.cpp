@@ -0,0 +1,69 @@
+#include "services/FrameTrace.h"
+
+#if BRIDGE_ENABLE_FRAME_TRACE
+
+#include <string.h>
+
+// Left alone by the C runtime at startup, so a reset that is not a power
+// cycle finds the previous trace where it was.
+#if defined(ARDUINO_ARCH_AVR)
+#define BRIDGE_NOINIT __attribute__((section(".noinit")))
+#elif defined(ARDUINO_ARCH_ESP32)
+#include <esp_attr.h>
+#define BRIDGE_NOINIT __NOINIT_ATTR
+#else
+#define BRIDGE_NOINIT
+#endif
+
+namespace {
+// 'TRC' plus the depth: a build with a different ring layout does not trust
+// what an older one left behind.
+constexpr uint32_t kMagic = 0x54524300UL | FrameTraceClass::kDepth;
+
+inline void _putLe(uint8_t*& out, uint32_t value, uint8_t bytes) {
+  for (uint8_t i = 0; i < bytes; ++i)
+    *out++ = static_cast<uint8_t>(value >> (8U * i));
+}
+}  // namespace
+
+BRIDGE_NOINIT FrameTraceClass::Ring FrameTraceClass::_ring;
+
+FrameTraceClass::FrameTraceClass() {}
+
+void FrameTraceClass::begin() {
+  if (_ring.magic != kMagic) clear();
+  record(rpc_pb_FrameTraceDirection_FRAME_TRACE_EVENT, 0, 0, 0,
+         rpc_pb_FrameTraceResult_FRAME_TRACE_BOOT, 0);
+}
+
+void FrameTraceClass::clear() {
+  memset(&_ring, 0, sizeof(_ring));
+  _ring.magic = kMagic;
+}
+
+void FrameTraceClass::snapshot(uint32_t from, rpc::payload::FrameTrace& out) {
+  static_assert(sizeof(out.events.bytes) ==
+                    rpc::RPC_FRAME_TRACE_CHUNK_RECORDS * kRecordSize,
+                "mcubridge.options and the trace constants disagree");
+  const uint32_t first = start();
+  if (from < first) from = first;
+  if (from > _ring.end) from = _ring.end;
+  out.start = from;
+  out.end = _ring.end;
+  uint8_t* p = out.events.bytes;
+  for (uint32_t n = from;
+       n < _ring.end && n - from < rpc::RPC_FRAME_TRACE_CHUNK_RECORDS; ++n) {
+    const Event& e = _ring.events[n & (kDepth - 1U)];
+    _putLe(p, e.t_us, 4);
+    _putLe(p, e.command, 2);
+    _putLe(p, e.sequence, 2);
+    *p++ = e.length;
+    *p++ = e.flags;
+    *p++ = e.state;
+  }
+  out.events.size = static_cast<pb_size_t>(p - out.events.bytes);
+}
+
+FrameTraceType FrameTrace;
+
+#endif  // BRIDGE_ENABLE_FRAME_TRACE
@@ -0,0 +1,87 @@
+#ifndef SERVICES_FRAME_TRACE_H
+#define SERVICES_FRAME_TRACE_H
+
+#include "config/bridge_config.h"
+
+#if BRIDGE_ENABLE_FRAME_TRACE
+
+#include <Arduino.h>
+
+#include "protocol/rpc_structs.h"
+
+/**
+ * @brief Ring of the last frames and link events, for post-mortem analysis.
+ *
+ * Bridge records every frame it parses or sends, plus markers for
+ * enterSafeState() and exhausted retries, with micros(), the command,
+ * sequence, payload length, outcome and FSM state. Recording is a handful of
+ * stores into the next slot; nothing is encoded until CMD_GET_FRAME_TRACE
+ * reads the ring back.
+ *
+ * The ring lives in a .noinit section on AVR and ESP32, so it survives a
+ * watchdog or software reset: begin() keeps a ring that passes its sanity
+ * checks and appends a FRAME_TRACE_BOOT marker after the old events. Power
+ * loss, and boards without such a section, start empty.
+ */
+class FrameTraceClass {
+ public:
+  static constexpr uint8_t kDepth = BRIDGE_FRAME_TRACE_DEPTH;
+  static constexpr uint8_t kRecordSize = rpc::RPC_FRAME_TRACE_RECORD_SIZE;
+  static_assert(kDepth > 0U && (kDepth & (kDepth - 1U)) == 0U,
+                "BRIDGE_FRAME_TRACE_DEPTH must be a power of two");
+
+  FrameTraceClass();
+
+  /** Keep a trace that survived a reset, or start an empty one. */
+  static void begin();
+  static void clear();
+
+  static void record(rpc_pb_FrameTraceDirection direction, uint16_t command,
+                     uint16_t sequence, size_t length,
+                     rpc_pb_FrameTraceResult result, uint8_t state) {
+    Event& e = _ring.events[_ring.end & (kDepth - 1U)];
+    e.t_us = ::micros();
+    e.command = command;
+    e.sequence = sequence;
+    e.length = length > UINT8_MAX ? UINT8_MAX : static_cast<uint8_t>(length);
+    e.flags = static_cast<uint8_t>((direction << 6) | (result & 0x3FU));
+    e.state = state;
+    ++_ring.end;
+  }
+
+  /** Number of the oldest event still in the ring. */
+  static uint32_t start() {
+    return _ring.end > kDepth ? _ring.end - kDepth : 0U;
+  }
+  /** Number the next event will get. */
+  static uint32_t end() { return _ring.end; }
+
+  /**
+   * Fill @p out with up to RPC_FRAME_TRACE_CHUNK_RECORDS events from number
+   * @p from on (or the oldest one kept, if that is later).
+   */
+  static void snapshot(uint32_t from, rpc::payload::FrameTrace& out);
+
+ private:
+  struct Event {
+    uint32_t t_us;
+    uint16_t command;
+    uint16_t sequence;
+    uint8_t length;
+    uint8_t flags;
+    uint8_t state;
+  };
+  struct Ring {
+    uint32_t magic;
+    uint32_t end;
+    Event events[kDepth];
+  };
+
+  static Ring _ring;
+};
+
+using FrameTraceType = FrameTraceClass;
+extern FrameTraceType FrameTrace;
+
+#endif  // BRIDGE_ENABLE_FRAME_TRACE
+#endif  // SERVICES_FRAME_TRACE_H
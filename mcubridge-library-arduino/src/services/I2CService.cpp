@@ -0,0 +1,116 @@
+#include "I2CService.h"
+
+#include "Bridge.h"
+
+#if BRIDGE_ENABLE_I2C
+
+namespace {
+rpc_pb_I2cStatus _busStatus(uint8_t wire_code) {
+#if defined(WIRE_HAS_TIMEOUT)
+  if (Wire.getWireTimeoutFlag()) {
+    Wire.clearWireTimeoutFlag();
+    return rpc_pb_I2cStatus_I2C_TIMEOUT;
+  }
+#endif
+  return wire_code <= rpc_pb_I2cStatus_I2C_TIMEOUT
+             ? static_cast<rpc_pb_I2cStatus>(wire_code)
+             : rpc_pb_I2cStatus_I2C_BUS_ERROR;
+}
+}  // namespace
+
+I2CServiceClass::I2CServiceClass() : _initialized(false) {}
+
+void I2CServiceClass::begin(const rpc::payload::I2cConfig& config) {
+  if (!_initialized) {
+    Wire.begin();
+    _initialized = true;
+  }
+  if (config.frequency != 0U) Wire.setClock(config.frequency);
+#if defined(WIRE_HAS_TIMEOUT)
+  // [SIL-2] A slave holding SDA low must not hang process().
+  Wire.setWireTimeout(rpc::RPC_I2C_TIMEOUT_US, true);
+#endif
+}
+
+void I2CServiceClass::end() {
+  if (!_initialized) return;
+  Wire.end();
+  _initialized = false;
+}
+
+rpc_pb_I2cStatus I2CServiceClass::transfer(uint8_t address,
+                                           etl::span<const uint8_t> out,
+                                           etl::span<uint8_t> in, bool hold) {
+  if (!_initialized) return rpc_pb_I2cStatus_I2C_BUS_ERROR;
+  if (out.size() > rpc::RPC_I2C_TRANSFER_MAX_BYTES ||
+      in.size() > rpc::RPC_I2C_TRANSFER_MAX_BYTES) {
+    return rpc_pb_I2cStatus_I2C_DATA_TOO_LONG;
+  }
+  // A held read keeps the bus for the next transfer, which then has to
+  // start with a repeated start even when it has nothing to write.
+  if (!out.empty()) {
+    Wire.beginTransmission(address);
+    if (Wire.write(out.data(), out.size()) != out.size()) {
+      return rpc_pb_I2cStatus_I2C_DATA_TOO_LONG;
+    }
+    const bool stop = in.empty() && !hold;
+    const rpc_pb_I2cStatus st = _busStatus(Wire.endTransmission(stop));
+    if (st != rpc_pb_I2cStatus_I2C_OK) return st;
+  }
+  if (in.empty()) return rpc_pb_I2cStatus_I2C_OK;
+
+  const uint8_t got =
+      Wire.requestFrom(address, static_cast<uint8_t>(in.size()),
+                       static_cast<uint8_t>(!hold));
+  if (got != in.size()) {
+    while (Wire.available() > 0) (void)Wire.read();
+    const rpc_pb_I2cStatus st = _busStatus(0);
+    if (st != rpc_pb_I2cStatus_I2C_OK) return st;
+    // requestFrom() returns 0 when the address is not acknowledged.
+    return got == 0U ? rpc_pb_I2cStatus_I2C_NACK_ADDRESS
+                     : rpc_pb_I2cStatus_I2C_SHORT_READ;
+  }
+  for (auto& b : in) b = static_cast<uint8_t>(Wire.read());
+  return rpc_pb_I2cStatus_I2C_OK;
+}
+
+void I2CServiceClass::readRegisters(
+    const rpc::payload::I2cReadRegisters& msg,
+    rpc::payload::I2cReadRegistersResponse& resp) {
+  static_assert(sizeof(msg.reads) / sizeof(msg.reads[0]) ==
+                    rpc::RPC_I2C_BATCH_MAX_READS,
+                "mcubridge.options and the batch constants disagree");
+  static_assert(sizeof(resp.data.bytes) == rpc::RPC_I2C_BATCH_MAX_BYTES,
+                "mcubridge.options and the batch constants disagree");
+  resp.status = rpc_pb_I2cStatus_I2C_OK;
+  resp.completed = 0;
+  resp.data.size = 0;
+  if (msg.reg_bytes > 2U) {
+    resp.status = rpc_pb_I2cStatus_I2C_DATA_TOO_LONG;
+    return;
+  }
+  const uint8_t address = static_cast<uint8_t>(msg.address);
+  const bool wide = (msg.reg_bytes == 2U);
+  for (pb_size_t i = 0; i < msg.reads_count; ++i) {
+    const auto& r = msg.reads[i];
+    if (r.len > sizeof(resp.data.bytes) - resp.data.size) {
+      resp.status = rpc_pb_I2cStatus_I2C_DATA_TOO_LONG;
+      return;
+    }
+    uint8_t reg[2] = {static_cast<uint8_t>(r.reg >> 8),
+                      static_cast<uint8_t>(r.reg)};
+    const etl::span<const uint8_t> out =
+        wide ? etl::span<const uint8_t>(reg, 2)
+             : etl::span<const uint8_t>(reg + 1, 1);
+    resp.status = transfer(
+        address, out,
+        etl::span<uint8_t>(resp.data.bytes + resp.data.size, r.len), false);
+    if (resp.status != rpc_pb_I2cStatus_I2C_OK) return;
+    resp.data.size = static_cast<pb_size_t>(resp.data.size + r.len);
+    ++resp.completed;
+  }
+}
+
+I2CServiceType I2CService;
+
+#endif  // BRIDGE_ENABLE_I2C
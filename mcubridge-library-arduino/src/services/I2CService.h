@@ -0,0 +1,46 @@
+#ifndef BRIDGE_I2C_SERVICE_H
+#define BRIDGE_I2C_SERVICE_H
+
+#include "config/bridge_config.h"
+
+#if BRIDGE_ENABLE_I2C
+
+#include <Wire.h>
+#undef min
+#undef max
+#include <etl/span.h>
+
+#include "protocol/rpc_structs.h"
+
+/**
+ * @brief I2C master on the Wire bus.
+ *
+ * transfer() covers plain writes, plain reads and register reads (write then
+ * read with a repeated start). readRegisters() runs several of those against
+ * one device and packs the blocks into one response, so a sensor driver on
+ * Linux pays one round trip for a whole register map. Every call stops at
+ * the first bus error and reports it as an rpc_pb_I2cStatus.
+ */
+class I2CServiceClass {
+ public:
+  I2CServiceClass();
+
+  void begin(const rpc::payload::I2cConfig& config);
+  void end();
+  rpc_pb_I2cStatus transfer(uint8_t address, etl::span<const uint8_t> out,
+                            etl::span<uint8_t> in, bool hold);
+  void readRegisters(const rpc::payload::I2cReadRegisters& msg,
+                     rpc::payload::I2cReadRegistersResponse& resp);
+
+  bool running() const { return _initialized; }
+  void onLost() { end(); }
+
+ private:
+  bool _initialized;
+};
+
+using I2CServiceType = I2CServiceClass;
+extern I2CServiceType I2CService;
+
+#endif  // BRIDGE_ENABLE_I2C
+#endif  // BRIDGE_I2C_SERVICE_H
@@ -0,0 +1,307 @@
+#include "services/KVStore.h"
+
+#include <etl/algorithm.h>
+
+#if BRIDGE_ENABLE_EEPROM
+
+#include <etl/crc8_ccitt.h>
+
+#include "hal/hal.h"
+#include "services/DataStore.h"
+
+namespace {
+// Erased EEPROM reads as 0xFF, which is also an invalid key length: the byte
+// written after every record to end the log.
+constexpr uint8_t kEndOfLog = 0xFF;
+constexpr uint8_t kMagic[2] = {'K', 'V'};
+
+inline uint8_t _crc(const uint8_t* data, size_t len) {
+  return etl::crc8_ccitt(data, data + len).value();
+}
+
+inline uint8_t _hash(etl::string_view key) {
+  return _crc(reinterpret_cast<const uint8_t*>(key.data()), key.size());
+}
+
+inline bool _read(uint16_t addr, uint8_t* out, size_t len) {
+  return bridge::hal::nvRead(addr, etl::span<uint8_t>(out, len)).has_value();
+}
+
+inline bool _write(uint16_t addr, const uint8_t* data, size_t len) {
+  return bridge::hal::nvWrite(addr, etl::span<const uint8_t>(data, len))
+      .has_value();
+}
+
+// Once per public operation: on ESP32 every commit rewrites the whole flash
+// sector, which would undo the wear leveling if each _write() paid for one.
+inline bool _commit() { return bridge::hal::nvCommit().has_value(); }
+}  // namespace
+
+KVStoreClass::Index KVStoreClass::_index;
+uint16_t KVStoreClass::_bank_size = 0;
+uint16_t KVStoreClass::_end = 0;
+uint16_t KVStoreClass::_generation = 0;
+uint8_t KVStoreClass::_bank = 0;
+bool KVStoreClass::_mounted = false;
+
+KVStoreClass::KVStoreClass() {}
+
+bool KVStoreClass::begin() {
+  _mounted = false;
+  _index.clear();
+  _bank_size = bridge::hal::nvSize() / 2U;
+  if (_bank_size < kHeaderSize + kMaxRecord + 1U) return false;
+
+  uint16_t gen0 = 0;
+  uint16_t gen1 = 0;
+  const bool valid0 = _readHeader(0, gen0);
+  const bool valid1 = _readHeader(1, gen1);
+  if (!valid0 && !valid1) return format();
+
+  // Generations wrap: the newer bank is the one less than half the range
+  // ahead of the other.
+  _bank = (valid1 && (!valid0 || static_cast<int16_t>(gen1 - gen0) > 0)) ? 1U
+                                                                          : 0U;
+  _generation = (_bank == 1U) ? gen1 : gen0;
+  _end = _scan();
+  _mounted = true;
+  return true;
+}
+
+bool KVStoreClass::format() {
+  _mounted = false;
+  _index.clear();
+  if (_bank_size == 0U) return false;
+  // Retire bank 1 before bank 0 becomes valid, so there is never a moment
+  // with two live banks holding different data.
+  const uint8_t erased[kHeaderSize] = {kEndOfLog, kEndOfLog, kEndOfLog,
+                                       kEndOfLog};
+  if (!_write(_bankBase(1), erased, sizeof(erased)) ||
+      !_write(_bankBase(0) + kHeaderSize, &kEndOfLog, 1U) ||
+      !_writeHeader(0, 1U) || !_commit()) {
+    return false;
+  }
+  _bank = 0;
+  _generation = 1U;
+  _end = kHeaderSize;
+  _mounted = true;
+  return true;
+}
+
+bool KVStoreClass::get(etl::string_view key, etl::span<uint8_t> out,
+                       size_t& length) {
+  if (!_mounted) return false;
+  const auto it = _find(key);
+  if (it == _index.end()) return false;
+  uint8_t buf[kMaxRecord];
+  if (_readRecord(it->addr, _bankBase(_bank) + _bank_size, buf) == 0U)
+    return false;
+  length = buf[1];
+  etl::copy_n(buf + 2U + buf[0], etl::min(length, out.size()), out.data());
+  return true;
+}
+
+bool KVStoreClass::put(etl::string_view key, etl::span<const uint8_t> value,
+                       bool mirror) {
+  if (!_mounted || key.empty() || key.size() > kMaxKey ||
+      value.size() > kMaxValue) {
+    return false;
+  }
+  auto it = _find(key);
+  bool unchanged = false;
+  if (it != _index.end()) {
+    uint8_t buf[kMaxRecord];
+    unchanged =
+        _readRecord(it->addr, _bankBase(_bank) + _bank_size, buf) != 0U &&
+        buf[1] == value.size() &&
+        etl::equal(value.begin(), value.end(), buf + 2U + buf[0]);
+  } else if (_index.full()) {
+    return false;
+  }
+
+  // Rewriting an identical value would only spend EEPROM cycles.
+  if (!unchanged) {
+    uint16_t addr = 0;
+    if (!_append(key, value, false, addr)) return false;
+    // A compaction rebuilt the index: look the key up again.
+    it = _find(key);
+    if (it != _index.end()) {
+      it->addr = addr;
+    } else {
+      _index.push_back(Entry{addr, _hash(key)});
+    }
+    if (!_commit()) return false;
+  }
+
+#if BRIDGE_ENABLE_DATASTORE
+  if (mirror) DataStore.set(key, value);
+#else
+  (void)mirror;
+#endif
+  return true;
+}
+
+bool KVStoreClass::remove(etl::string_view key) {
+  if (!_mounted) return false;
+  if (_find(key) == _index.end()) return true;
+  uint16_t addr = 0;
+  if (!_append(key, etl::span<const uint8_t>(), true, addr)) return false;
+  const auto it = _find(key);
+  if (it != _index.end()) _index.erase(it);
+  return _commit();
+}
+
+bool KVStoreClass::contains(etl::string_view key) {
+  return _mounted && _find(key) != _index.end();
+}
+
+void KVStoreClass::mirrorAll() {
+#if BRIDGE_ENABLE_DATASTORE
+  if (!_mounted) return;
+  uint8_t buf[kMaxRecord];
+  for (const Entry& e : _index) {
+    if (_readRecord(e.addr, _bankBase(_bank) + _bank_size, buf) == 0U)
+      continue;
+    DataStore.set(
+        etl::string_view(reinterpret_cast<const char*>(buf + 2U), buf[0]),
+        etl::span<const uint8_t>(buf + 2U + buf[0], buf[1]));
+  }
+#endif
+}
+
+uint16_t KVStoreClass::freeBytes() {
+  return _mounted ? static_cast<uint16_t>(_bankBase(_bank) + _bank_size - _end)
+                  : 0U;
+}
+
+bool KVStoreClass::_readHeader(uint8_t bank, uint16_t& generation) {
+  uint8_t h[kHeaderSize];
+  if (!_read(_bankBase(bank), h, sizeof(h)) || h[0] != kMagic[0] ||
+      h[1] != kMagic[1]) {
+    return false;
+  }
+  generation = static_cast<uint16_t>(h[2] | (h[3] << 8));
+  return true;
+}
+
+bool KVStoreClass::_writeHeader(uint8_t bank, uint16_t generation) {
+  const uint8_t h[kHeaderSize] = {kMagic[0], kMagic[1],
+                                  static_cast<uint8_t>(generation & 0xFFU),
+                                  static_cast<uint8_t>(generation >> 8)};
+  return _write(_bankBase(bank), h, sizeof(h));
+}
+
+// Reads the record at @p addr into @p buf. Returns its size, or 0 at the end
+// of the log: erased or torn bytes, or a record running past @p limit.
+uint16_t KVStoreClass::_readRecord(uint16_t addr, uint16_t limit,
+                                   uint8_t* buf) {
+  if (static_cast<uint32_t>(addr) + kRecordOverhead > limit ||
+      !_read(addr, buf, 2U)) {
+    return 0U;
+  }
+  const uint8_t key_len = buf[0];
+  const uint8_t value_len = buf[1];
+  if (key_len == 0U || key_len > kMaxKey ||
+      (value_len != kTombstone && value_len > kMaxValue)) {
+    return 0U;
+  }
+  const uint16_t size = kRecordOverhead + key_len +
+                        (value_len == kTombstone ? 0U : value_len);
+  if (static_cast<uint32_t>(addr) + size > limit ||
+      !_read(addr + 2U, buf + 2U, size - 2U) ||
+      _crc(buf, size - 1U) != buf[size - 1U]) {
+    return 0U;
+  }
+  return size;
+}
+
+// Replays the active bank into the index. Returns the end of the log.
+uint16_t KVStoreClass::_scan() {
+  _index.clear();
+  const uint16_t limit = _bankBase(_bank) + _bank_size;
+  uint16_t addr = _bankBase(_bank) + kHeaderSize;
+  uint8_t buf[kMaxRecord];
+  while (const uint16_t size = _readRecord(addr, limit, buf)) {
+    const etl::string_view key(reinterpret_cast<const char*>(buf + 2U),
+                               buf[0]);
+    const auto it = _find(key);
+    if (buf[1] == kTombstone) {
+      if (it != _index.end()) _index.erase(it);
+    } else if (it != _index.end()) {
+      it->addr = addr;
+    } else if (!_index.full()) {
+      _index.push_back(Entry{addr, _hash(key)});
+    }
+    addr += size;
+  }
+  return addr;
+}
+
+KVStoreClass::Index::iterator KVStoreClass::_find(etl::string_view key) {
+  if (key.empty() || key.size() > kMaxKey) return _index.end();
+  const uint8_t hash = _hash(key);
+  uint8_t stored[2U + kMaxKey];
+  return etl::find_if(_index.begin(), _index.end(), [&](const Entry& e) {
+    return e.hash == hash && _read(e.addr, stored, 2U) &&
+           stored[0] == key.size() &&
+           _read(e.addr + 2U, stored + 2U, key.size()) &&
+           etl::equal(key.begin(), key.end(),
+                      reinterpret_cast<const char*>(stored + 2U));
+  });
+}
+
+bool KVStoreClass::_append(etl::string_view key,
+                           etl::span<const uint8_t> value, bool tombstone,
+                           uint16_t& addr) {
+  const uint16_t size = kRecordOverhead + key.size() +
+                        (tombstone ? 0U : value.size());
+  if (_end + size > _bankBase(_bank) + _bank_size &&
+      (!_compact() || _end + size > _bankBase(_bank) + _bank_size)) {
+    return false;
+  }
+
+  uint8_t buf[kMaxRecord];
+  buf[0] = static_cast<uint8_t>(key.size());
+  buf[1] = tombstone ? kTombstone : static_cast<uint8_t>(value.size());
+  etl::copy_n(key.data(), key.size(), buf + 2U);
+  if (!tombstone) etl::copy_n(value.data(), value.size(), buf + 2U + key.size());
+  buf[size - 1U] = _crc(buf, size - 1U);
+
+  // End the log past the new record first: until the record is complete
+  // (CRC included) a reset just drops it.
+  const uint16_t next = _end + size;
+  if (next < _bankBase(_bank) + _bank_size && !_write(next, &kEndOfLog, 1U))
+    return false;
+  if (!_write(_end, buf, size)) return false;
+  addr = _end;
+  _end = next;
+  return true;
+}
+
+// Copies the live records into the other bank and switches to it.
+bool KVStoreClass::_compact() {
+  const uint8_t target = _bank ^ 1U;
+  const uint16_t limit = _bankBase(target) + _bank_size;
+  uint16_t out = _bankBase(target) + kHeaderSize;
+  {
+    uint8_t buf[kMaxRecord];
+    for (const Entry& e : _index) {
+      const uint16_t size =
+          _readRecord(e.addr, _bankBase(_bank) + _bank_size, buf);
+      if (size == 0U || out + size > limit || !_write(out, buf, size))
+        return false;
+      out += size;
+    }
+  }
+  if (out < limit && !_write(out, &kEndOfLog, 1U)) return false;
+  // The header goes last: until it is written the old bank stays newer.
+  if (!_writeHeader(target, _generation + 1U)) return false;
+  _bank = target;
+  ++_generation;
+  _end = _scan();
+  return true;
+}
+
+KVStoreType KVStore;
+
+#endif  // BRIDGE_ENABLE_EEPROM
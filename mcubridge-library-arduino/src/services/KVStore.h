@@ -0,0 +1,102 @@
+#ifndef SERVICES_KVSTORE_H
+#define SERVICES_KVSTORE_H
+
+#include "config/bridge_config.h"
+
+#if BRIDGE_ENABLE_EEPROM
+
+#undef min
+#undef max
+#include <etl/span.h>
+#include <etl/string_view.h>
+#include <etl/vector.h>
+
+#include "protocol/rpc_structs.h"
+
+/**
+ * @brief Key/value pairs kept in EEPROM across resets.
+ *
+ * The region from bridge::hal::nvSize() is split into two banks. Each bank
+ * holds a header (magic + generation) followed by an append-only log of
+ * records: key length, value length (0xFF marks a deletion), key, value and
+ * a CRC-8. Updates only ever append, so the writes walk through the bank
+ * instead of hammering the same cells; when the bank is full the live
+ * records are copied into the other bank under the next generation, whose
+ * header is written last so a reset in the middle leaves the old bank in
+ * charge. A torn record fails its CRC and ends the log. On ESP32, where
+ * the EEPROM is emulated in one flash sector, each put(), remove() or
+ * format() commits it once, compaction included.
+ *
+ * begin() (called by Bridge.begin()) scans the newest bank into a RAM index
+ * of record addresses, so get() works before the link to Linux is up. Keys
+ * and values follow the DataStore limits; put(..., true) and mirrorAll()
+ * also push the pairs to the Linux DataStore.
+ */
+class KVStoreClass {
+ public:
+  static constexpr size_t kMaxKey = rpc::RPC_MAX_DATASTORE_KEY_LENGTH;
+  static constexpr size_t kMaxValue =
+      sizeof(rpc::payload::DatastorePut{}.value.bytes);
+
+  KVStoreClass();
+
+  /** Mount the store, formatting the region if it holds no valid bank. */
+  static bool begin();
+  /** Erase every pair. */
+  static bool format();
+
+  /**
+   * Copy the value of @p key into @p out (truncated to its size).
+   * @param length Full length of the stored value.
+   */
+  static bool get(etl::string_view key, etl::span<uint8_t> out,
+                  size_t& length);
+  static bool put(etl::string_view key, etl::span<const uint8_t> value,
+                  bool mirror = false);
+  static bool remove(etl::string_view key);
+  static bool contains(etl::string_view key);
+
+  /** Push every stored pair to the Linux DataStore. */
+  static void mirrorAll();
+
+  static bool mounted() { return _mounted; }
+  static size_t count() { return _index.size(); }
+  /** Log bytes left in the active bank before the next compaction. */
+  static uint16_t freeBytes();
+  static uint16_t generation() { return _generation; }
+
+ private:
+  struct Entry {
+    uint16_t addr;
+    uint8_t hash;
+  };
+  using Index = etl::vector<Entry, bridge::config::MAX_KV_KEYS>;
+
+  static constexpr uint8_t kTombstone = 0xFF;
+  static constexpr uint16_t kHeaderSize = 4;
+  static constexpr uint16_t kRecordOverhead = 3;
+  static constexpr uint16_t kMaxRecord = kRecordOverhead + kMaxKey + kMaxValue;
+
+  static uint16_t _bankBase(uint8_t bank) { return bank * _bank_size; }
+  static bool _readHeader(uint8_t bank, uint16_t& generation);
+  static bool _writeHeader(uint8_t bank, uint16_t generation);
+  static uint16_t _readRecord(uint16_t addr, uint16_t limit, uint8_t* buf);
+  static uint16_t _scan();
+  static Index::iterator _find(etl::string_view key);
+  static bool _append(etl::string_view key, etl::span<const uint8_t> value,
+                      bool tombstone, uint16_t& addr);
+  static bool _compact();
+
+  static Index _index;
+  static uint16_t _bank_size;
+  static uint16_t _end;
+  static uint16_t _generation;
+  static uint8_t _bank;
+  static bool _mounted;
+};
+
+using KVStoreType = KVStoreClass;
+extern KVStoreType KVStore;
+
+#endif  // BRIDGE_ENABLE_EEPROM
+#endif  // SERVICES_KVSTORE_H
@@ -0,0 +1,50 @@
+#include "services/LoopProfiler.h"
+
+#if BRIDGE_ENABLE_LOOP_PROFILER
+
+#include <string.h>
+
+LoopProfilerClass::Histogram LoopProfilerClass::_phases[kPhases] = {};
+
+LoopProfilerClass::LoopProfilerClass() {}
+
+uint8_t LoopProfilerClass::bucketOf(uint32_t elapsed_us) {
+  uint8_t bucket = 0;
+  while (elapsed_us > 1U && bucket < kBuckets - 1U) {
+    elapsed_us >>= 1;
+    ++bucket;
+  }
+  return bucket;
+}
+
+void LoopProfilerClass::record(rpc_pb_LoopPhase phase, uint32_t elapsed_us) {
+  if (static_cast<uint8_t>(phase) >= kPhases) return;
+  Histogram& h = _phases[phase];
+  if (h.samples != UINT32_MAX) ++h.samples;
+  if (elapsed_us > h.max_us) h.max_us = elapsed_us;
+  uint16_t& count = h.buckets[bucketOf(elapsed_us)];
+  if (count != UINT16_MAX) ++count;
+}
+
+bool LoopProfilerClass::snapshot(rpc_pb_LoopPhase phase,
+                                 rpc::payload::LoopProfile& out) {
+  static_assert(sizeof(out.buckets) / sizeof(out.buckets[0]) == kBuckets,
+                "mcubridge.options and the bucket constant disagree");
+  if (static_cast<uint8_t>(phase) >= kPhases) return false;
+  const Histogram& h = _phases[phase];
+  out.phase = phase;
+  out.samples = h.samples;
+  out.max_us = h.max_us;
+  out.buckets_count = kBuckets;
+  for (uint8_t i = 0; i < kBuckets; ++i) out.buckets[i] = h.buckets[i];
+  return true;
+}
+
+void LoopProfilerClass::reset(rpc_pb_LoopPhase phase) {
+  if (static_cast<uint8_t>(phase) >= kPhases) return;
+  memset(&_phases[phase], 0, sizeof(_phases[phase]));
+}
+
+LoopProfilerType LoopProfiler;
+
+#endif  // BRIDGE_ENABLE_LOOP_PROFILER
@@ -0,0 +1,46 @@
+#ifndef SERVICES_LOOP_PROFILER_H
+#define SERVICES_LOOP_PROFILER_H
+
+#include "config/bridge_config.h"
+
+#if BRIDGE_ENABLE_LOOP_PROFILER
+
+#include "protocol/rpc_structs.h"
+
+/**
+ * @brief Latency histograms of the phases of Bridge.process().
+ *
+ * process() reads micros() between its phases and records each duration,
+ * plus the whole call, into a fixed set of log2 buckets (see LoopProfile in
+ * mcubridge.proto). Recording is a shift loop and a saturating increment, so
+ * the profiler adds a few microseconds per pass and no allocation.
+ */
+class LoopProfilerClass {
+ public:
+  static constexpr uint8_t kPhases = _rpc_pb_LoopPhase_ARRAYSIZE;
+  static constexpr uint8_t kBuckets = rpc::RPC_LOOP_PROFILE_BUCKETS;
+
+  LoopProfilerClass();
+
+  static void record(rpc_pb_LoopPhase phase, uint32_t elapsed_us);
+  /** Copy one phase into @p out. @return false for an unknown phase. */
+  static bool snapshot(rpc_pb_LoopPhase phase, rpc::payload::LoopProfile& out);
+  static void reset(rpc_pb_LoopPhase phase);
+
+  static uint8_t bucketOf(uint32_t elapsed_us);
+
+ private:
+  struct Histogram {
+    uint32_t samples;
+    uint32_t max_us;
+    uint16_t buckets[kBuckets];
+  };
+
+  static Histogram _phases[kPhases];
+};
+
+using LoopProfilerType = LoopProfilerClass;
+extern LoopProfilerType LoopProfiler;
+
+#endif  // BRIDGE_ENABLE_LOOP_PROFILER
+#endif  // SERVICES_LOOP_PROFILER_H
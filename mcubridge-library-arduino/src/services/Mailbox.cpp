@@ -25,6 +25,8 @@ typename MailboxClass::AvailableCallback MailboxClass::_available_callback;
 
 etl::queue<typename MailboxClass::MailboxMessage, 8> MailboxClass::_queue;
 
+uint8_t MailboxClass::_peak = 0;
+
 void MailboxClass::requestRead() {
   (void)Bridge.sendFrame(rpc::CommandId::CMD_MAILBOX_READ);
 }
@@ -40,23 +42,25 @@ void MailboxClass::signalProcessed(uint32_t message_id) {
   }
 }
 
-void MailboxClass::_onPush(const rpc::payload::MailboxPush& msg) {
-  if (!_queue.full()) {
-    MailboxMessage m;
-    m.size = (uint8_t)etl::min((size_t)msg.data.size, sizeof(m.data));
-    etl::copy_n(msg.data.bytes, m.size, m.data.begin());
-    _queue.push(m);
+void MailboxClass::_enqueue(const uint8_t* data, size_t size) {
+  if (_queue.full()) {
+    Bridge.countLink(BridgeClass::LinkCounter::MAILBOX_DROPPED);
+    return;
   }
+  MailboxMessage m;
+  m.size = (uint8_t)etl::min(size, sizeof(m.data));
+  etl::copy_n(data, m.size, m.data.begin());
+  _queue.push(m);
+  _peak = etl::max(_peak, static_cast<uint8_t>(_queue.size()));
+}
+
+void MailboxClass::_onPush(const rpc::payload::MailboxPush& msg) {
+  _enqueue(msg.data.bytes, msg.data.size);
 }
 
 void MailboxClass::_onReadResponse(
     const rpc::payload::MailboxReadResponse& msg) {
-  if (!_queue.full()) {
-    MailboxMessage m;
-    m.size = (uint8_t)etl::min((size_t)msg.content.size, sizeof(m.data));
-    etl::copy_n(msg.content.bytes, m.size, m.data.begin());
-    _queue.push(m);
-  }
+  _enqueue(msg.content.bytes, msg.content.size);
 }
 
 void MailboxClass::_onAvailableResponse(
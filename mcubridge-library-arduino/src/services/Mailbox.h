@@ -36,6 +36,8 @@ class MailboxClass {
 
   static void process();
   static void onLost();
+  /** Deepest the inbound queue has been since boot. */
+  static uint8_t peak() { return _peak; }
 
  private:
   struct MailboxMessage {
@@ -45,6 +47,9 @@ class MailboxClass {
   static MessageCallback _message_callback;
   static AvailableCallback _available_callback;
   static etl::queue<MailboxMessage, 8> _queue;
+  static uint8_t _peak;
+
+  static void _enqueue(const uint8_t* data, size_t size);
 };
 
 using MailboxType = MailboxClass;
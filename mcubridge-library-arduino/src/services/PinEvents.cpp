@@ -0,0 +1,200 @@
+#include "services/PinEvents.h"
+
+#include <etl/algorithm.h>
+
+#if BRIDGE_ENABLE_PIN_EVENTS
+
+#include "Bridge.h"
+#if BRIDGE_ENABLE_REFLEX
+#include "services/Reflex.h"
+#endif
+
+#if defined(ARDUINO_ARCH_AVR) && defined(digitalPinToInterrupt)
+#define BRIDGE_PIN_EVENTS_IRQ 1
+#else
+#define BRIDGE_PIN_EVENTS_IRQ 0
+#endif
+
+namespace {
+
+inline uint8_t _pinLevel(uint8_t pin) {
+  return (::digitalRead(pin) == HIGH) ? 1U : 0U;
+}
+
+#if BRIDGE_PIN_EVENTS_IRQ
+// attachInterrupt() callbacks carry no argument: one trampoline per slot.
+template <uint8_t Slot>
+void _pinIsr() {
+  PinEventsClass::_onInterrupt(Slot);
+}
+constexpr etl::array<void (*)(), 4> kIsrTable{{
+    &_pinIsr<0>,
+    &_pinIsr<1>,
+    &_pinIsr<2>,
+    &_pinIsr<3>,
+}};
+#endif
+
+}  // namespace
+
+etl::array<PinEventsClass::Subscription, bridge::config::MAX_PIN_SUBSCRIPTIONS>
+    PinEventsClass::_subs = {};
+etl::circular_buffer<PinEventsClass::Edge, bridge::config::PIN_EVENT_RING_SIZE>
+    PinEventsClass::_ring;
+uint32_t PinEventsClass::_watch_mask = 0;
+uint16_t PinEventsClass::_dropped = 0;
+uint8_t PinEventsClass::_ring_peak = 0;
+
+PinEventsClass::PinEventsClass() {}
+
+bool PinEventsClass::subscribe(const rpc::payload::PinSubscribe& msg) {
+  if (msg.pin >= bridge::config::DIGITAL_PINS) return false;
+  const uint8_t pin = static_cast<uint8_t>(msg.pin);
+
+  auto* it = etl::find_if(_subs.begin(), _subs.end(),
+                          [pin](const Subscription& s) {
+                            return s.active && s.pin == pin;
+                          });
+  if (it != _subs.end()) _release(*it);
+  if (msg.edge == rpc_pb_PinEdge_PIN_EDGE_NONE) return true;
+
+  it = etl::find_if(_subs.begin(), _subs.end(),
+                    [](const Subscription& s) { return !s.active; });
+  if (it == _subs.end()) return false;
+
+  Subscription& s = *it;
+  BRIDGE_ATOMIC_BLOCK {
+    s.pin = pin;
+    s.edge = static_cast<uint8_t>(msg.edge);
+    s.debounce_ms = static_cast<uint16_t>(
+        etl::min<uint32_t>(msg.debounce_ms, UINT16_MAX));
+    s.level = _pinLevel(pin);
+    s.last_edge_ms = ::millis();
+    s.irq = false;
+    s.active = true;
+  }
+#if BRIDGE_PIN_EVENTS_IRQ
+  const int irq = digitalPinToInterrupt(pin);
+  const size_t slot = static_cast<size_t>(it - _subs.begin());
+  if (irq != NOT_AN_INTERRUPT && slot < kIsrTable.size()) {
+    s.irq = true;
+    attachInterrupt(irq, kIsrTable[slot], CHANGE);
+  }
+#endif
+  if (!s.irq) _watch_mask |= (1UL << pin);
+  return true;
+}
+
+void PinEventsClass::_release(Subscription& s) {
+#if BRIDGE_PIN_EVENTS_IRQ
+  if (s.irq) detachInterrupt(digitalPinToInterrupt(s.pin));
+#endif
+  BRIDGE_ATOMIC_BLOCK {
+    s.active = false;
+    s.irq = false;
+  }
+  _watch_mask &= ~(1UL << s.pin);
+}
+
+// [ISR] Runs with interrupts masked; shares _subs/_ring with _scan/_flush,
+// which only touch them inside BRIDGE_ATOMIC_BLOCK.
+void PinEventsClass::_onInterrupt(uint8_t slot) {
+  Subscription& s = _subs[slot];
+  if (!s.active) return;
+  _onLevel(s, _pinLevel(s.pin), ::millis());
+}
+
+void PinEventsClass::_onLevel(Subscription& s, uint8_t level, uint32_t now) {
+  if (level == s.level) return;
+  // Bounces inside the window are ignored; the next scan after it closes
+  // reports the settled level if it differs from the last one sent.
+  if (s.debounce_ms != 0U &&
+      static_cast<uint32_t>(now - s.last_edge_ms) < s.debounce_ms)
+    return;
+  s.level = level;
+  s.last_edge_ms = now;
+#if BRIDGE_ENABLE_REFLEX
+  // Interlocks react to the debounced level before it is queued for Linux.
+  ReflexClass::onPinLevel(s.pin, level);
+#endif
+
+  const bool wanted = (s.edge == rpc_pb_PinEdge_PIN_EDGE_CHANGE) ||
+                      (s.edge == rpc_pb_PinEdge_PIN_EDGE_RISING && level) ||
+                      (s.edge == rpc_pb_PinEdge_PIN_EDGE_FALLING && !level);
+  if (!wanted) return;
+  if (_ring.full()) {
+    if (_dropped < UINT16_MAX) ++_dropped;
+    return;
+  }
+  _ring.push(Edge{now, s.pin, level});
+  if (_ring.size() > _ring_peak)
+    _ring_peak = static_cast<uint8_t>(_ring.size());
+}
+
+void PinEventsClass::_scan() {
+  // One coherent snapshot for every polled pin; interrupt-driven pins are
+  // re-read individually below so a concurrent ISR cannot be undone by a
+  // stale sample.
+  const uint32_t levels =
+      _watch_mask ? bridge::hal::digitalReadPort(_watch_mask) : 0U;
+  BRIDGE_ATOMIC_BLOCK {
+    const uint32_t now = ::millis();
+    for (auto& s : _subs) {
+      if (!s.active) continue;
+      const uint8_t level =
+          s.irq ? _pinLevel(s.pin)
+                : static_cast<uint8_t>((levels >> s.pin) & 1U);
+      _onLevel(s, level, now);
+    }
+  }
+}
+
+void PinEventsClass::_flush() {
+  if (!Bridge.isSynchronized()) return;
+  rpc::payload::PinEvent msg = rpc_pb_PinEvent_init_default;
+  constexpr size_t kMaxEvents = sizeof(msg.events) / sizeof(msg.events[0]);
+  size_t count = 0U;
+  BRIDGE_ATOMIC_BLOCK {
+    if (_ring.empty() && _dropped == 0U) return;
+    count = etl::min(_ring.size(), kMaxEvents);
+    for (size_t i = 0; i < count; ++i) {
+      msg.events[i].pin = _ring[i].pin;
+      msg.events[i].level = _ring[i].level;
+      msg.events[i].timestamp_ms = _ring[i].timestamp_ms;
+    }
+    msg.events_count = static_cast<pb_size_t>(count);
+    msg.dropped = _dropped;
+  }
+  // Pending TX slot busy (awaiting ACK): keep the edges and retry on the next
+  // process() pass, which naturally coalesces them into a larger batch.
+  if (!Bridge.send(rpc::CommandId::CMD_PIN_EVENT, 0, msg)) return;
+  BRIDGE_ATOMIC_BLOCK {
+    _ring.pop(count);
+    _dropped = static_cast<uint16_t>(_dropped - msg.dropped);
+  }
+}
+
+void PinEventsClass::process() {
+  _scan();
+  _flush();
+}
+
+size_t PinEventsClass::pending() {
+  size_t n = 0U;
+  BRIDGE_ATOMIC_BLOCK { n = _ring.size(); }
+  return n;
+}
+
+void PinEventsClass::onLost() {
+  for (auto& s : _subs) {
+    if (s.active) _release(s);
+  }
+  BRIDGE_ATOMIC_BLOCK {
+    _ring.clear();
+    _dropped = 0U;
+  }
+}
+
+PinEventsType PinEvents;
+
+#endif  // BRIDGE_ENABLE_PIN_EVENTS
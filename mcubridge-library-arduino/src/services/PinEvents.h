@@ -0,0 +1,71 @@
+#ifndef SERVICES_PIN_EVENTS_H
+#define SERVICES_PIN_EVENTS_H
+
+#include "config/bridge_config.h"
+
+#if BRIDGE_ENABLE_PIN_EVENTS
+
+#undef min
+#undef max
+#include <etl/array.h>
+#include <etl/circular_buffer.h>
+
+#include "protocol/rpc_structs.h"
+
+/**
+ * @brief Pin-change subscriptions pushed to Linux as batched CMD_PIN_EVENT.
+ *
+ * Edges are captured by an external interrupt when the pin has one (AVR) and
+ * by a per-process() port snapshot otherwise. The snapshot also reconciles
+ * interrupt-driven pins once their debounce window closes, so the last
+ * reported level always converges to the real one. Nothing is sent while no
+ * edge is pending.
+ */
+class PinEventsClass {
+ public:
+  PinEventsClass();
+
+  /** Add, update or (edge == PIN_EDGE_NONE) cancel a pin subscription. */
+  static bool subscribe(const rpc::payload::PinSubscribe& msg);
+  static void process();
+  static void onLost();
+
+  static size_t pending();
+  /** Highest ring fill since boot, for CMD_GET_MEMORY_PROFILE. */
+  static uint8_t ringPeak() { return _ring_peak; }
+  static void _onInterrupt(uint8_t slot);
+
+ private:
+  struct Subscription {
+    uint32_t last_edge_ms;
+    uint16_t debounce_ms;
+    uint8_t pin;
+    uint8_t edge;
+    uint8_t level;
+    bool active;
+    bool irq;
+  };
+  struct Edge {
+    uint32_t timestamp_ms;
+    uint8_t pin;
+    uint8_t level;
+  };
+
+  static void _onLevel(Subscription& s, uint8_t level, uint32_t now);
+  static void _scan();
+  static void _flush();
+  static void _release(Subscription& s);
+
+  static etl::array<Subscription, bridge::config::MAX_PIN_SUBSCRIPTIONS>
+      _subs;
+  static etl::circular_buffer<Edge, bridge::config::PIN_EVENT_RING_SIZE> _ring;
+  static uint32_t _watch_mask;
+  static uint16_t _dropped;
+  static uint8_t _ring_peak;
+};
+
+using PinEventsType = PinEventsClass;
+extern PinEventsType PinEvents;
+
+#endif  // BRIDGE_ENABLE_PIN_EVENTS
+#endif  // SERVICES_PIN_EVENTS_H
@@ -19,7 +19,7 @@ ProcessClass::ProcessClass() {}
 void ProcessClass::runAsync(etl::string_view cmd,
                             etl::span<const etl::string_view> args,
                             typename ProcessClass::ProcessRunHandler handler) {
-  if (handler.is_valid() && Process._pending_run_async.full()) {
+  if (handler.is_valid() && !Bridge.canRequest()) {
     Bridge.emitStatus(
         rpc::StatusCode::STATUS_ERROR,
         etl::string_view(rpc::status_reason::PROCESS_LIMIT_REACHED));
@@ -60,21 +60,24 @@ void ProcessClass::runAsync(etl::string_view cmd,
     etl::copy_n(command_buffer.begin(), c_copy, p.command);
   }
 
-  const bool send_ok = Bridge.send(rpc::CommandId::CMD_PROCESS_RUN_ASYNC, 0, p);
+  // Without a handler nobody waits for the pid: no request to track.
+  const bool send_ok =
+      handler.is_valid()
+          ? Bridge.request<&ProcessClass::_onRunAsyncResponse>(
+                rpc::CommandId::CMD_PROCESS_RUN_ASYNC, p,
+                rpc::CommandId::CMD_PROCESS_RUN_ASYNC_RESP, handler)
+          : Bridge.send(rpc::CommandId::CMD_PROCESS_RUN_ASYNC, 0, p);
   if (!send_ok) {
     Bridge.emitStatus(
         rpc::StatusCode::STATUS_ERROR,
         etl::string_view(rpc::status_reason::PROCESS_RUN_ASYNC_FAILED));
     if (handler.is_valid()) handler(kProcessInvalidPid);
-    return;
   }
-
-  if (handler.is_valid()) Process._pending_run_async.push({handler});
 }
 
 void ProcessClass::poll(int32_t pid,
                         typename ProcessClass::ProcessPollHandler handler) {
-  if (handler.is_valid() && _pending_polls.full()) {
+  if (handler.is_valid() && !Bridge.canRequest()) {
     Bridge.emitStatus(
         rpc::StatusCode::STATUS_ERROR,
         etl::string_view(rpc::status_reason::PROCESS_LIMIT_REACHED));
@@ -84,15 +87,16 @@ void ProcessClass::poll(int32_t pid,
   rpc::payload::ProcessPoll p = {};
   p.pid = static_cast<uint32_t>(pid);
 
-  if (!Bridge.send(rpc::CommandId::CMD_PROCESS_POLL, 0, p)) {
+  const bool send_ok =
+      handler.is_valid()
+          ? Bridge.request<&ProcessClass::_onPollResponse>(
+                rpc::CommandId::CMD_PROCESS_POLL, p,
+                rpc::CommandId::CMD_PROCESS_POLL_RESP, handler)
+          : Bridge.send(rpc::CommandId::CMD_PROCESS_POLL, 0, p);
+  if (!send_ok) {
     Bridge.emitStatus(
         rpc::StatusCode::STATUS_ERROR,
         etl::string_view(rpc::status_reason::PROCESS_RUN_INTERNAL_ERROR));
-    return;
-  }
-
-  if (handler.is_valid()) {
-    _pending_polls.push({pid, handler});
   }
 }
 
@@ -104,34 +108,37 @@ void ProcessClass::kill(int32_t pid) {
 }
 
 void ProcessClass::_onKillNotification(const rpc::payload::ProcessKill&) {
-  // Linux notifies MCU that a process was killed. Clear local queues only —
+  // Linux notifies MCU that a process was killed. End local requests only —
   // do NOT re-send CMD_PROCESS_KILL (that would create an echo loop).
   reset();
 }
 
 void ProcessClass::_onRunAsyncResponse(
-    const rpc::payload::ProcessRunAsyncResponse& msg) {
-  if (_pending_run_async.empty()) return;
-  const typename ProcessClass::PendingRunAsync pending =
-      _pending_run_async.front();
-  _pending_run_async.pop();
-  pending.handler(static_cast<int32_t>(msg.pid));
+    const ProcessRunHandler& handler, bridge::RequestStatus,
+    const rpc::payload::ProcessRunAsyncResponse* msg) {
+  handler(msg != nullptr ? static_cast<int32_t>(msg->pid)
+                         : kProcessInvalidPid);
 }
 
 void ProcessClass::_onPollResponse(
-    const rpc::payload::ProcessPollResponse& msg) {
-  if (_pending_polls.empty()) return;
-  const typename ProcessClass::PendingPoll pending = _pending_polls.front();
-  _pending_polls.pop();
-  pending.handler(
-      static_cast<rpc::StatusCode>(msg.status), msg.exit_code,
-      etl::span<const uint8_t>(msg.stdout_data.bytes, msg.stdout_data.size),
-      etl::span<const uint8_t>(msg.stderr_data.bytes, msg.stderr_data.size));
+    const ProcessPollHandler& handler, bridge::RequestStatus status,
+    const rpc::payload::ProcessPollResponse* msg) {
+  if (msg == nullptr) {
+    handler(status == bridge::RequestStatus::TIMEOUT
+                ? rpc::StatusCode::STATUS_TIMEOUT
+                : rpc::StatusCode::STATUS_ERROR,
+            0, etl::span<const uint8_t>(), etl::span<const uint8_t>());
+    return;
+  }
+  handler(
+      static_cast<rpc::StatusCode>(msg->status), msg->exit_code,
+      etl::span<const uint8_t>(msg->stdout_data.bytes, msg->stdout_data.size),
+      etl::span<const uint8_t>(msg->stderr_data.bytes, msg->stderr_data.size));
 }
 
 void ProcessClass::reset() {
-  _pending_run_async.clear();
-  _pending_polls.clear();
+  Bridge.cancelRequests(rpc::CommandId::CMD_PROCESS_RUN_ASYNC_RESP);
+  Bridge.cancelRequests(rpc::CommandId::CMD_PROCESS_POLL_RESP);
 }
 
 ProcessType Process;
@@ -5,10 +5,10 @@
 #undef min
 #undef max
 #include <etl/delegate.h>
-#include <etl/queue.h>
 #include <etl/span.h>
 #include <etl/string_view.h>
 
+#include "protocol/RequestTable.h"
 #include "protocol/rpc_protocol.h"
 #include "protocol/rpc_structs.h"
 
@@ -27,23 +27,16 @@ class ProcessClass {
   static void kill(int32_t pid);
 
   void _onKillNotification(const rpc::payload::ProcessKill& msg);
-  void _onRunAsyncResponse(const rpc::payload::ProcessRunAsyncResponse& msg);
-  void _onPollResponse(const rpc::payload::ProcessPollResponse& msg);
-  void reset();
-
-  void onLost() { reset(); }
-
-  struct PendingRunAsync {
-    ProcessRunHandler handler;
-  };
-  struct PendingPoll {
-    int32_t pid{0};
-    ProcessPollHandler handler;
-  };
-  etl::queue<PendingRunAsync, bridge::config::MAX_PENDING_PROCESS_POLLS>
-      _pending_run_async;
-  etl::queue<PendingPoll, bridge::config::MAX_PENDING_PROCESS_POLLS>
-      _pending_polls;
+  // A run that fails or goes unanswered reports pid -1; such a poll reports
+  // STATUS_ERROR or STATUS_TIMEOUT with no output.
+  static void _onRunAsyncResponse(
+      const ProcessRunHandler& handler, bridge::RequestStatus status,
+      const rpc::payload::ProcessRunAsyncResponse* msg);
+  static void _onPollResponse(const ProcessPollHandler& handler,
+                              bridge::RequestStatus status,
+                              const rpc::payload::ProcessPollResponse* msg);
+  /** End the runs and polls still waiting for Linux. */
+  static void reset();
 };
 
 using ProcessType = ProcessClass;
@@ -0,0 +1,189 @@
+#include "services/Reflex.h"
+
+#include <etl/algorithm.h>
+
+#if BRIDGE_ENABLE_REFLEX
+
+#include "Bridge.h"
+#include "hal/hal.h"
+
+etl::array<ReflexClass::Rule, bridge::config::MAX_REFLEX_RULES>
+    ReflexClass::_rules = {};
+etl::circular_buffer<ReflexClass::Notice, 4> ReflexClass::_notices;
+uint16_t ReflexClass::_dropped = 0;
+
+ReflexClass::ReflexClass() {}
+
+bool ReflexClass::_isDigital(uint8_t trigger) {
+  return trigger == rpc_pb_ReflexTrigger_REFLEX_TRIGGER_PIN_HIGH ||
+         trigger == rpc_pb_ReflexTrigger_REFLEX_TRIGGER_PIN_LOW;
+}
+
+bool ReflexClass::configure(const rpc::payload::ReflexRule& msg) {
+  if (msg.rule_id >= _rules.size()) return false;
+  Rule& r = _rules[msg.rule_id];
+  if (msg.trigger == rpc_pb_ReflexTrigger_REFLEX_TRIGGER_NONE) {
+    BRIDGE_ATOMIC_BLOCK { r.used = false; }
+    return true;
+  }
+
+  const uint8_t trigger = static_cast<uint8_t>(msg.trigger);
+  const bool analog =
+      trigger == rpc_pb_ReflexTrigger_REFLEX_TRIGGER_ANALOG_ABOVE ||
+      trigger == rpc_pb_ReflexTrigger_REFLEX_TRIGGER_ANALOG_BELOW;
+  if (analog && msg.pin >= bridge::config::ANALOG_PINS) return false;
+  if (_isDigital(trigger) && msg.pin >= bridge::config::DIGITAL_PINS)
+    return false;
+  if (trigger == rpc_pb_ReflexTrigger_REFLEX_TRIGGER_TIMER &&
+      msg.period_ms == 0U)
+    return false;
+  if (msg.out_pin >= bridge::config::DIGITAL_PINS) return false;
+
+  Rule next = {};
+  next.period_ms = msg.period_ms;
+  next.next_ms = ::millis() + msg.period_ms;
+  next.threshold =
+      static_cast<uint16_t>(etl::min<uint32_t>(msg.threshold, UINT16_MAX));
+  next.hysteresis =
+      static_cast<uint16_t>(etl::min<uint32_t>(msg.hysteresis, UINT16_MAX));
+  next.value = static_cast<uint16_t>(etl::min<uint32_t>(msg.value, 255U));
+  next.restore_value =
+      static_cast<uint16_t>(etl::min<uint32_t>(msg.restore_value, 255U));
+  next.trigger = trigger;
+  next.pin = static_cast<uint8_t>(msg.pin);
+  next.action = static_cast<uint8_t>(msg.action);
+  next.out_pin = static_cast<uint8_t>(msg.out_pin);
+  next.restore = msg.restore;
+  next.notify = msg.notify;
+  next.used = true;
+  BRIDGE_ATOMIC_BLOCK { r = next; }
+  return true;
+}
+
+bool ReflexClass::_analogCondition(const Rule& r, uint16_t x) {
+  // Hysteresis widens the band only once the rule is active, so a signal
+  // hovering around the threshold does not chatter the output.
+  const uint32_t v = x;
+  if (r.trigger == rpc_pb_ReflexTrigger_REFLEX_TRIGGER_ANALOG_ABOVE)
+    return r.active ? (v + r.hysteresis > r.threshold) : (v > r.threshold);
+  return r.active ? (v < static_cast<uint32_t>(r.threshold) + r.hysteresis)
+                  : (v < r.threshold);
+}
+
+void ReflexClass::_apply(const Rule& r, uint16_t value) {
+  switch (r.action) {
+    case rpc_pb_ReflexAction_REFLEX_ACTION_ANALOG_WRITE:
+      bridge::hal::fastAnalogWrite(r.out_pin, static_cast<int>(value));
+      break;
+    case rpc_pb_ReflexAction_REFLEX_ACTION_TOGGLE: {
+      const uint32_t bit = 1UL << r.out_pin;
+      bridge::hal::digitalWriteMask(bit,
+                                    bridge::hal::digitalReadPort(bit) ^ bit);
+      break;
+    }
+    default:
+      bridge::hal::fastDigitalWrite(r.out_pin, value ? HIGH : LOW);
+      break;
+  }
+}
+
+void ReflexClass::_notify(uint8_t id, bool active, uint32_t now) {
+  if (_notices.full()) {
+    if (_dropped < UINT16_MAX) ++_dropped;
+    return;
+  }
+  _notices.push(Notice{now, id, active});
+}
+
+// Runs with interrupts masked (from the ISR or an atomic block in process()).
+void ReflexClass::_update(uint8_t id, Rule& r, bool cond, uint32_t now) {
+  if (cond == r.active) return;
+  r.active = cond;
+  if (cond) {
+    _apply(r, r.value);
+  } else if (r.restore) {
+    _apply(r, r.restore_value);
+  } else {
+    return;
+  }
+  if (r.notify) _notify(id, cond, now);
+}
+
+void ReflexClass::onPinLevel(uint8_t pin, uint8_t level) {
+  const uint32_t now = ::millis();
+  for (uint8_t i = 0; i < _rules.size(); ++i) {
+    Rule& r = _rules[i];
+    if (!r.used || r.pin != pin || !_isDigital(r.trigger)) continue;
+    const bool want_high =
+        r.trigger == rpc_pb_ReflexTrigger_REFLEX_TRIGGER_PIN_HIGH;
+    _update(i, r, (level != 0U) == want_high, now);
+  }
+}
+
+void ReflexClass::_flush() {
+  if (!Bridge.isSynchronized()) return;
+  for (;;) {
+    rpc::payload::ReflexFired msg = rpc_pb_ReflexFired_init_default;
+    BRIDGE_ATOMIC_BLOCK {
+      if (_notices.empty()) return;
+      const Notice& n = _notices.front();
+      msg.rule_id = n.rule_id;
+      msg.active = n.active;
+      msg.timestamp_ms = n.timestamp_ms;
+    }
+    // TX busy: keep the notice for the next pass. _notify() never evicts,
+    // so the front is still the one just copied.
+    if (!Bridge.send(rpc::CommandId::CMD_REFLEX_FIRED, 0, msg)) return;
+    BRIDGE_ATOMIC_BLOCK { _notices.pop(); }
+  }
+}
+
+void ReflexClass::process() {
+  const uint32_t now = ::millis();
+  for (uint8_t i = 0; i < _rules.size(); ++i) {
+    Rule& r = _rules[i];
+    if (!r.used) continue;
+    if (r.trigger == rpc_pb_ReflexTrigger_REFLEX_TRIGGER_TIMER) {
+      if (static_cast<int32_t>(now - r.next_ms) < 0) continue;
+      r.next_ms += r.period_ms;
+      if (static_cast<int32_t>(now - r.next_ms) >= 0)
+        r.next_ms = now + r.period_ms;
+      BRIDGE_ATOMIC_BLOCK {
+        _apply(r, r.value);
+        if (r.notify) _notify(i, true, now);
+      }
+      continue;
+    }
+    if (_isDigital(r.trigger)) {
+      // Sampled inside the critical section so a concurrent ISR update
+      // cannot be undone by a stale level.
+      BRIDGE_ATOMIC_BLOCK {
+        const bool high = ::digitalRead(r.pin) == HIGH;
+        const bool want_high =
+            r.trigger == rpc_pb_ReflexTrigger_REFLEX_TRIGGER_PIN_HIGH;
+        _update(i, r, high == want_high, now);
+      }
+      continue;
+    }
+    const uint16_t x = static_cast<uint16_t>(bridge::hal::analogRead(r.pin));
+    BRIDGE_ATOMIC_BLOCK { _update(i, r, _analogCondition(r, x), now); }
+  }
+  _flush();
+}
+
+size_t ReflexClass::activeRules() {
+  return static_cast<size_t>(etl::count_if(
+      _rules.begin(), _rules.end(), [](const Rule& r) { return r.used; }));
+}
+
+void ReflexClass::onLost() {
+  BRIDGE_ATOMIC_BLOCK {
+    for (auto& r : _rules) r = Rule{};
+    _notices.clear();
+    _dropped = 0;
+  }
+}
+
+ReflexType Reflex;
+
+#endif  // BRIDGE_ENABLE_REFLEX
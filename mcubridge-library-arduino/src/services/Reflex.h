@@ -0,0 +1,79 @@
+#ifndef SERVICES_REFLEX_H
+#define SERVICES_REFLEX_H
+
+#include "config/bridge_config.h"
+
+#if BRIDGE_ENABLE_REFLEX
+
+#undef min
+#undef max
+#include <etl/array.h>
+#include <etl/circular_buffer.h>
+
+#include "protocol/rpc_structs.h"
+
+/**
+ * @brief Statically allocated "condition -> output" rules run on the MCU.
+ *
+ * Linux installs the rules; the MCU evaluates them every process() pass and,
+ * for digital conditions on pins that have an interrupt-driven PinEvents
+ * subscription, straight from the pin-change ISR. A rule acts when its
+ * condition becomes true and, with restore set, again when it clears. Timer
+ * rules act every period_ms. Notifications are queued and sent best-effort
+ * as CMD_REFLEX_FIRED so the control path never waits for the link.
+ */
+class ReflexClass {
+ public:
+  ReflexClass();
+
+  /** Install, replace or (trigger == NONE) remove rule msg.rule_id. */
+  static bool configure(const rpc::payload::ReflexRule& msg);
+  static void process();
+  static void onLost();
+
+  /** [ISR] Debounced level of @p pin changed (called by PinEvents). */
+  static void onPinLevel(uint8_t pin, uint8_t level);
+
+  static size_t activeRules();
+  static uint16_t droppedNotices() { return _dropped; }
+
+ private:
+  struct Rule {
+    uint32_t next_ms;
+    uint32_t period_ms;
+    uint16_t threshold;
+    uint16_t hysteresis;
+    uint16_t value;
+    uint16_t restore_value;
+    uint8_t trigger;
+    uint8_t pin;
+    uint8_t action;
+    uint8_t out_pin;
+    bool restore;
+    bool notify;
+    bool used;
+    bool active;
+  };
+  struct Notice {
+    uint32_t timestamp_ms;
+    uint8_t rule_id;
+    bool active;
+  };
+
+  static bool _isDigital(uint8_t trigger);
+  static bool _analogCondition(const Rule& r, uint16_t x);
+  static void _update(uint8_t id, Rule& r, bool cond, uint32_t now);
+  static void _apply(const Rule& r, uint16_t value);
+  static void _notify(uint8_t id, bool active, uint32_t now);
+  static void _flush();
+
+  static etl::array<Rule, bridge::config::MAX_REFLEX_RULES> _rules;
+  static etl::circular_buffer<Notice, 4> _notices;
+  static uint16_t _dropped;
+};
+
+using ReflexType = ReflexClass;
+extern ReflexType Reflex;
+
+#endif  // BRIDGE_ENABLE_REFLEX
+#endif  // SERVICES_REFLEX_H
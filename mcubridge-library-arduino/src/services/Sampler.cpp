@@ -0,0 +1,254 @@
+#include "services/Sampler.h"
+
+#include <etl/algorithm.h>
+
+#if BRIDGE_ENABLE_SAMPLER
+
+#include "Bridge.h"
+#include "hal/hal.h"
+
+namespace {
+
+// Delta encoding: one signed byte per sample, or kDeltaEscape followed by the
+// raw little-endian value when the step does not fit.
+constexpr uint8_t kDeltaEscape = 0x80U;
+
+inline size_t _putRaw(uint8_t* out, uint16_t v) {
+  out[0] = static_cast<uint8_t>(v & 0xFFU);
+  out[1] = static_cast<uint8_t>(v >> 8);
+  return 2U;
+}
+
+inline bool _fitsDelta(int32_t d) { return d >= -127 && d <= 127; }
+
+}  // namespace
+
+etl::array<SamplerClass::Batch, 2> SamplerClass::_buffers = {};
+etl::array<uint8_t, bridge::config::ANALOG_PINS> SamplerClass::_channels = {};
+uint32_t SamplerClass::_period_us = 0;
+uint32_t SamplerClass::_next_us = 0;
+uint32_t SamplerClass::_seq = 0;
+uint16_t* SamplerClass::_out = nullptr;
+volatile uint32_t SamplerClass::_overruns = 0;
+uint16_t SamplerClass::_batch_scans = 0;
+uint8_t SamplerClass::_channel_count = 0;
+uint8_t SamplerClass::_fill = 0;
+volatile uint8_t SamplerClass::_conv = SamplerClass::kNoScan;
+volatile int8_t SamplerClass::_ready = -1;
+bool SamplerClass::_delta = false;
+bool SamplerClass::_gap = false;
+bool SamplerClass::_timer = false;
+volatile bool SamplerClass::_running = false;
+
+SamplerClass::SamplerClass() {}
+
+bool SamplerClass::start(const rpc::payload::StreamConfig& cfg) {
+  stop();
+  constexpr uint32_t kValidMask =
+      (1UL << bridge::config::ANALOG_PINS) - 1UL;
+  if (cfg.channel_mask == 0U || (cfg.channel_mask & ~kValidMask) != 0U)
+    return false;
+
+  uint8_t count = 0;
+  for (uint8_t ch = 0; ch < bridge::config::ANALOG_PINS; ++ch) {
+    if (cfg.channel_mask & (1UL << ch)) _channels[count++] = ch;
+  }
+  // The minimum period is per conversion: a scan of N channels takes N ADC
+  // conversions and must finish well before the next tick.
+  if (cfg.period_us < bridge::config::STREAM_MIN_PERIOD_US * count)
+    return false;
+
+  const uint16_t max_scans = static_cast<uint16_t>(kBufferSamples / count);
+  _batch_scans =
+      (cfg.batch_scans == 0U)
+          ? max_scans
+          : static_cast<uint16_t>(
+                etl::min<uint32_t>(cfg.batch_scans, max_scans));
+  _channel_count = count;
+  _period_us = cfg.period_us;
+  _delta = cfg.delta;
+  _seq = 0;
+  _overruns = 0;
+  _fill = 0;
+  _gap = false;
+  _ready = -1;
+  for (auto& b : _buffers) b.scans = 0;
+  _next_us = ::micros();
+  _running = true;
+  _timer = bridge::hal::startPeriodicTimer(_period_us, &SamplerClass::_onTick);
+  return true;
+}
+
+void SamplerClass::stop() {
+  if (_timer) bridge::hal::stopPeriodicTimer();
+  BRIDGE_ATOMIC_BLOCK {
+    _timer = false;
+    _running = false;
+    _ready = -1;
+  }
+  // A scan still converting ends at its next ADC interrupt, which sees
+  // _running cleared; wait for it so start() cannot reuse the buffers first.
+  while (_conv != kNoScan) {
+  }
+}
+
+// [ISR] Timer tick: the scan is sampled now. The first conversion starts
+// here and _onConversion() chains the others from the ADC interrupt.
+void SamplerClass::_onTick() {
+  if (!_running) return;
+  if (_conv == kNoScan) {
+    _out = _beginScan(::micros());
+    _conv = 0;
+    if (bridge::hal::startAnalogConversion(_channels[0],
+                                           &SamplerClass::_onConversion)) {
+      return;
+    }
+    _conv = kNoScan;
+  }
+  // The last scan is still converting, or analogRead() holds the ADC.
+  _overruns = _overruns + 1U;
+  _gap = true;
+}
+
+// [ISR] One channel converted: store it and start the next one, or finish
+// the scan.
+void SamplerClass::_onConversion(uint16_t value) {
+  if (!_running) {
+    _conv = kNoScan;
+    return;
+  }
+  uint8_t i = _conv;
+  _out[i++] = value;
+  if (i == _channel_count) {
+    _endScan();
+  } else if (bridge::hal::startAnalogConversion(
+                 _channels[i], &SamplerClass::_onConversion)) {
+    _conv = i;
+    return;
+  } else {
+    // Lost the ADC halfway: the partial scan is dropped.
+    _overruns = _overruns + 1U;
+    _gap = true;
+  }
+  _conv = kNoScan;
+}
+
+// The next scan's slot in the filling half. After a gap that half is closed
+// first, so the scans of a batch stay exactly one period apart.
+uint16_t* SamplerClass::_beginScan(uint32_t now_us) {
+  if (_gap) {
+    _gap = false;
+    _closeBatch();
+  }
+  Batch& b = _buffers[_fill];
+  if (b.scans == 0U) b.start_us = now_us;
+  return &b.samples[static_cast<size_t>(b.scans) * _channel_count];
+}
+
+void SamplerClass::_endScan() {
+  if (++_buffers[_fill].scans >= _batch_scans) _closeBatch();
+}
+
+// Hand the filling half to process(). While the other half is still being
+// sent it is dropped instead, rather than overwrite data the sender reads.
+void SamplerClass::_closeBatch() {
+  Batch& b = _buffers[_fill];
+  if (b.scans == 0U) return;
+  if (_ready >= 0) {
+    _overruns = _overruns + b.scans;
+    b.scans = 0;
+    return;
+  }
+  _ready = static_cast<int8_t>(_fill);
+  _fill ^= 1U;
+  _buffers[_fill].scans = 0;
+}
+
+void SamplerClass::_emit(const Batch& batch) {
+  rpc::payload::StreamData msg = rpc_pb_StreamData_init_default;
+  constexpr size_t kFrameBytes = sizeof(msg.samples.bytes);
+  static_assert(bridge::config::ANALOG_PINS * 2U <= kFrameBytes,
+                "A raw scan must fit in one CMD_STREAM_DATA frame");
+  const uint8_t n = _channel_count;
+
+  uint16_t scan = 0;
+  while (scan < batch.scans) {
+    msg = rpc_pb_StreamData_init_default;
+    msg.seq = _seq;
+    msg.start_us = batch.start_us + static_cast<uint32_t>(scan) * _period_us;
+    uint8_t* out = msg.samples.bytes;
+    size_t len = 0;
+    uint16_t scans = 0;
+    // Each frame restarts from a raw scan so it decodes on its own even if
+    // the previous one was lost.
+    for (; scan < batch.scans; ++scan, ++scans) {
+      const uint16_t* cur = &batch.samples[static_cast<size_t>(scan) * n];
+      const uint16_t* prev = (_delta && scans > 0U) ? cur - n : nullptr;
+      size_t need = 0;
+      for (uint8_t i = 0; i < n; ++i) {
+        if (!prev) {
+          need += 2U;
+        } else {
+          need += _fitsDelta(static_cast<int32_t>(cur[i]) - prev[i]) ? 1U : 3U;
+        }
+      }
+      if (len + need > kFrameBytes) break;
+      for (uint8_t i = 0; i < n; ++i) {
+        if (!prev) {
+          len += _putRaw(out + len, cur[i]);
+          continue;
+        }
+        const int32_t d = static_cast<int32_t>(cur[i]) - prev[i];
+        if (_fitsDelta(d)) {
+          out[len++] = static_cast<uint8_t>(static_cast<int8_t>(d));
+        } else {
+          out[len++] = kDeltaEscape;
+          len += _putRaw(out + len, cur[i]);
+        }
+      }
+    }
+    msg.samples.size = static_cast<pb_size_t>(len);
+    msg.scans = scans;
+    BRIDGE_ATOMIC_BLOCK { msg.overruns = _overruns; }
+    if (!Bridge.send(rpc::CommandId::CMD_STREAM_DATA, 0, msg)) {
+      BRIDGE_ATOMIC_BLOCK {
+        _overruns = _overruns + (batch.scans - scan + scans);
+      }
+      return;
+    }
+    ++_seq;
+  }
+}
+
+void SamplerClass::process() {
+  if (!_running) return;
+  // Timer-driven scans fill the buffers from interrupts; only send here.
+  if (!_timer) {
+    const uint32_t now = ::micros();
+    uint8_t caught_up = 0;
+    while (static_cast<int32_t>(now - _next_us) >= 0) {
+      if (caught_up++ == kMaxCatchUpScans) {
+        const uint32_t missed = (now - _next_us) / _period_us + 1U;
+        _overruns = _overruns + missed;
+        _next_us += missed * _period_us;
+        _gap = true;
+        break;
+      }
+      uint16_t* out = _beginScan(_next_us);
+      for (uint8_t i = 0; i < _channel_count; ++i) {
+        out[i] = static_cast<uint16_t>(bridge::hal::analogRead(_channels[i]));
+      }
+      _endScan();
+      _next_us += _period_us;
+    }
+  }
+  int8_t ready = -1;
+  BRIDGE_ATOMIC_BLOCK { ready = _ready; }
+  if (ready < 0) return;
+  _emit(_buffers[static_cast<size_t>(ready)]);
+  BRIDGE_ATOMIC_BLOCK { _ready = -1; }
+}
+
+SamplerType Sampler;
+
+#endif  // BRIDGE_ENABLE_SAMPLER
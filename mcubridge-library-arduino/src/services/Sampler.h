@@ -0,0 +1,86 @@
+#ifndef SERVICES_SAMPLER_H
+#define SERVICES_SAMPLER_H
+
+#include "config/bridge_config.h"
+
+#if BRIDGE_ENABLE_SAMPLER
+
+#undef min
+#undef max
+#include <etl/array.h>
+
+#include "protocol/rpc_structs.h"
+
+/**
+ * @brief Periodic analog acquisition pushed to Linux as CMD_STREAM_DATA.
+ *
+ * One scan reads every channel in the configured mask. Scans are written into
+ * one half of a static double buffer while the other half is being sent, so
+ * the sampling side never waits for the serial link. When both halves are
+ * busy the scan batch is dropped and accounted as overruns. Scans are paced
+ * by a hardware timer when the HAL offers one: its tick starts the first
+ * conversion and the ADC-complete interrupt chains the rest, so every scan is
+ * sampled on its tick and no interrupt waits on the ADC. A tick that finds the
+ * ADC busy is an overrun. Without a timer, process() paces scans by micros()
+ * and stamps them with their nominal times. Either way a gap between scans
+ * ends the batch, so each frame's scans are exactly one period apart.
+ */
+class SamplerClass {
+ public:
+  SamplerClass();
+
+  /** Validate @p cfg and (re)start acquisition. */
+  static bool start(const rpc::payload::StreamConfig& cfg);
+  static void stop();
+  static void process();
+  static void onLost() { stop(); }
+
+  static bool running() { return _running; }
+  static uint32_t overruns() { return _overruns; }
+
+ private:
+  static constexpr size_t kBufferSamples =
+      bridge::config::STREAM_BUFFER_SAMPLES;
+  // Scans sampled back-to-back by the micros() scheduler before it gives up
+  // on catching up and accounts the backlog as overruns. The timer path never
+  // catches up: a tick that cannot be sampled on time is an overrun.
+  static constexpr uint8_t kMaxCatchUpScans = 4;
+  // _conv when no timer-driven scan is converting.
+  static constexpr uint8_t kNoScan = 0xFFU;
+
+  struct Batch {
+    etl::array<uint16_t, kBufferSamples> samples;
+    uint32_t start_us;
+    uint16_t scans;
+  };
+
+  static void _onTick();
+  static void _onConversion(uint16_t value);
+  static uint16_t* _beginScan(uint32_t now_us);
+  static void _endScan();
+  static void _closeBatch();
+  static void _emit(const Batch& batch);
+
+  static etl::array<Batch, 2> _buffers;
+  static etl::array<uint8_t, bridge::config::ANALOG_PINS> _channels;
+  static uint32_t _period_us;
+  static uint32_t _next_us;
+  static uint32_t _seq;
+  static uint16_t* _out;
+  static volatile uint32_t _overruns;
+  static uint16_t _batch_scans;
+  static uint8_t _channel_count;
+  static uint8_t _fill;
+  static volatile uint8_t _conv;
+  static volatile int8_t _ready;
+  static bool _delta;
+  static bool _gap;
+  static bool _timer;
+  static volatile bool _running;
+};
+
+using SamplerType = SamplerClass;
+extern SamplerType Sampler;
+
+#endif  // BRIDGE_ENABLE_SAMPLER
+#endif  // SERVICES_SAMPLER_H
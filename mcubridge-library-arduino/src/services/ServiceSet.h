@@ -0,0 +1,81 @@
+#ifndef SERVICES_SERVICE_SET_H
+#define SERVICES_SERVICE_SET_H
+
+namespace bridge {
+namespace router {
+struct CommandContext;
+}  // namespace router
+
+namespace services {
+
+/** Entry points of a ServiceSet, for code that only knows it at runtime. */
+struct Hooks {
+  void (*process)();
+  void (*on_lost)();
+  bool (*on_command)(const router::CommandContext& ctx);
+};
+
+namespace detail {
+// Each hook calls the member when the service has it and is a no-op
+// otherwise: the int/long overloads pick the first when it compiles.
+template <typename S>
+auto process(S& s, int) -> decltype(s.process(), void()) {
+  s.process();
+}
+template <typename S>
+void process(S&, long) {}
+
+template <typename S>
+auto onLost(S& s, int) -> decltype(s.onLost(), void()) {
+  s.onLost();
+}
+template <typename S>
+void onLost(S&, long) {}
+
+template <typename S>
+auto onCommand(S& s, const router::CommandContext& ctx, int)
+    -> decltype(static_cast<bool>(s.onCommand(ctx))) {
+  return s.onCommand(ctx);
+}
+template <typename S>
+bool onCommand(S&, const router::CommandContext&, long) {
+  return false;
+}
+}  // namespace detail
+
+/**
+ * @brief A list of service objects, composed at compile time.
+ *
+ * A service is any object with static storage duration. It can have
+ * process() (called on every pass of Bridge.process()), onLost() (called
+ * when the link drops), and bool onCommand(const CommandContext&), which
+ * claims a command the built-in dispatch table does not know. The hooks
+ * expand to direct calls to whichever of these each service has, so a
+ * service that is not in the list costs nothing. A service that is in the
+ * list costs only the calls it defines.
+ *
+ * @code
+ * using Mine = ServiceSet<Console, MySensor>::With<MyActuator>;
+ * Mine::process();
+ * @endcode
+ */
+template <auto&... Services>
+struct ServiceSet {
+  /** This set with @p Next appended, for lists built under #if. */
+  template <auto& Next>
+  using With = ServiceSet<Services..., Next>;
+
+  static void process() { (detail::process(Services, 0), ...); }
+  static void onLost() { (detail::onLost(Services, 0), ...); }
+  /** Offer @p ctx to each service in order; true once one takes it. */
+  static bool onCommand(const router::CommandContext& ctx) {
+    return (detail::onCommand(Services, ctx, 0) || ...);
+  }
+
+  static constexpr Hooks hooks = {&process, &onLost, &onCommand};
+};
+
+}  // namespace services
+}  // namespace bridge
+
+#endif  // SERVICES_SERVICE_SET_H
@@ -0,0 +1,113 @@
+#include "services/Telemetry.h"
+
+#include <etl/algorithm.h>
+
+#if BRIDGE_ENABLE_TELEMETRY
+
+#include "Bridge.h"
+
+etl::array<TelemetryClass::Job, bridge::config::MAX_TELEMETRY_JOBS>
+    TelemetryClass::_jobs = {};
+
+TelemetryClass::TelemetryClass() {}
+
+bool TelemetryClass::configure(const rpc::payload::TelemetryJob& msg) {
+  if (msg.job_id >= _jobs.size()) return false;
+  Job& job = _jobs[msg.job_id];
+  if (msg.period_ms == 0U) {
+    job.active = false;
+    job.pending = false;
+    return true;
+  }
+  const uint8_t max_pins = msg.analog ? bridge::config::ANALOG_PINS
+                                      : bridge::config::DIGITAL_PINS;
+  if (msg.pin >= max_pins) return false;
+
+  job = Job{};
+  job.pin = static_cast<uint8_t>(msg.pin);
+  job.analog = msg.analog;
+  job.period_ms = msg.period_ms;
+  job.heartbeat_ms = msg.heartbeat_ms;
+  job.deadband =
+      static_cast<uint16_t>(etl::min<uint32_t>(msg.deadband, UINT16_MAX));
+  job.next_ms = ::millis();
+  job.active = true;
+  return true;
+}
+
+void TelemetryClass::_sample(Job& job, uint32_t now) {
+  const uint16_t value =
+      job.analog ? static_cast<uint16_t>(bridge::hal::analogRead(job.pin))
+                 : static_cast<uint16_t>(::digitalRead(job.pin) == HIGH);
+  const uint16_t delta = (value > job.reported) ? value - job.reported
+                                                : job.reported - value;
+  const bool changed = !job.primed || delta > job.deadband;
+  const bool heartbeat =
+      job.heartbeat_ms != 0U && (now - job.reported_ms) >= job.heartbeat_ms;
+  if (!job.pending && !changed && !heartbeat) return;
+  job.value = value;
+  job.sample_ms = now;
+  job.pending = true;
+}
+
+void TelemetryClass::_flush() {
+  if (!Bridge.isSynchronized()) return;
+  rpc::payload::TelemetryReport msg = rpc_pb_TelemetryReport_init_default;
+  constexpr size_t kMaxSamples =
+      sizeof(msg.samples) / sizeof(msg.samples[0]);
+  etl::array<uint8_t, kMaxSamples> slots = {};
+  size_t count = 0U;
+  for (size_t i = 0; i < _jobs.size() && count < kMaxSamples; ++i) {
+    const Job& job = _jobs[i];
+    if (!job.active || !job.pending) continue;
+    auto& s = msg.samples[count];
+    s.job_id = static_cast<uint32_t>(i);
+    s.pin = job.pin;
+    s.analog = job.analog;
+    s.value = job.value;
+    s.timestamp_ms = job.sample_ms;
+    slots[count++] = static_cast<uint8_t>(i);
+  }
+  if (count == 0U) return;
+  msg.samples_count = static_cast<pb_size_t>(count);
+  // Pending TX queue full: the jobs stay pending and are re-sent, with
+  // fresher values, on a later pass.
+  if (!Bridge.send(rpc::CommandId::CMD_TELEMETRY_REPORT, 0, msg)) return;
+  const uint32_t now = ::millis();
+  for (size_t k = 0; k < count; ++k) {
+    Job& job = _jobs[slots[k]];
+    job.pending = false;
+    job.primed = true;
+    job.reported = job.value;
+    job.reported_ms = now;
+  }
+}
+
+void TelemetryClass::process() {
+  const uint32_t now = ::millis();
+  for (auto& job : _jobs) {
+    if (!job.active) continue;
+    if (static_cast<int32_t>(now - job.next_ms) < 0) continue;
+    _sample(job, now);
+    job.next_ms += job.period_ms;
+    // Missed periods are skipped rather than sampled in a burst.
+    if (static_cast<int32_t>(now - job.next_ms) >= 0)
+      job.next_ms = now + job.period_ms;
+  }
+  _flush();
+}
+
+size_t TelemetryClass::pending() {
+  return static_cast<size_t>(
+      etl::count_if(_jobs.begin(), _jobs.end(), [](const Job& job) {
+        return job.active && job.pending;
+      }));
+}
+
+void TelemetryClass::onLost() {
+  for (auto& job : _jobs) job = Job{};
+}
+
+TelemetryType Telemetry;
+
+#endif  // BRIDGE_ENABLE_TELEMETRY
@@ -0,0 +1,61 @@
+#ifndef SERVICES_TELEMETRY_H
+#define SERVICES_TELEMETRY_H
+
+#include "config/bridge_config.h"
+
+#if BRIDGE_ENABLE_TELEMETRY
+
+#undef min
+#undef max
+#include <etl/array.h>
+
+#include "protocol/rpc_structs.h"
+
+/**
+ * @brief Report-by-exception sampling jobs pushed as CMD_TELEMETRY_REPORT.
+ *
+ * Each slot samples one pin every period_ms and queues a report only when the
+ * value moved by more than its deadband since the last report, or when
+ * heartbeat_ms elapsed without one. A queued report keeps being refreshed with
+ * the latest sample until the link accepts it, so a busy link delays values
+ * but never delivers stale ones.
+ */
+class TelemetryClass {
+ public:
+  TelemetryClass();
+
+  /** Install, replace or (period_ms == 0) clear the job in msg.job_id. */
+  static bool configure(const rpc::payload::TelemetryJob& msg);
+  static void process();
+  static void onLost();
+
+  static size_t pending();
+
+ private:
+  struct Job {
+    uint32_t next_ms;
+    uint32_t reported_ms;
+    uint32_t sample_ms;
+    uint32_t period_ms;
+    uint32_t heartbeat_ms;
+    uint16_t deadband;
+    uint16_t reported;
+    uint16_t value;
+    uint8_t pin;
+    bool analog;
+    bool active;
+    bool primed;
+    bool pending;
+  };
+
+  static void _sample(Job& job, uint32_t now);
+  static void _flush();
+
+  static etl::array<Job, bridge::config::MAX_TELEMETRY_JOBS> _jobs;
+};
+
+using TelemetryType = TelemetryClass;
+extern TelemetryType Telemetry;
+
+#endif  // BRIDGE_ENABLE_TELEMETRY
+#endif  // SERVICES_TELEMETRY_H
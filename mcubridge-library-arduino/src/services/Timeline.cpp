@@ -0,0 +1,106 @@
+#include "services/Timeline.h"
+
+#include <etl/algorithm.h>
+
+#if BRIDGE_ENABLE_TIMELINE
+
+#include "hal/PinMap.h"
+#include "hal/hal.h"
+
+namespace {
+constexpr int32_t kMaxLeadUs =
+    static_cast<int32_t>(rpc::RPC_SCHEDULE_MAX_LEAD_MS * 1000UL);
+constexpr int32_t kSpinUs = BRIDGE_TIMELINE_SPIN_US;
+// Writes applied later than this after their deadline count as late.
+constexpr uint32_t kLateUs = 100U;
+}  // namespace
+
+etl::vector<TimelineClass::Entry, bridge::config::MAX_SCHEDULED_OPS>
+    TimelineClass::_queue;
+uint16_t TimelineClass::_late = 0;
+uint16_t TimelineClass::_peak = 0;
+
+TimelineClass::TimelineClass() {}
+
+bool TimelineClass::schedule(const rpc::payload::ScheduleGpio& msg) {
+  Entry e = {};
+  e.at_us = msg.execute_at_us;
+  e.op = static_cast<uint8_t>(msg.op);
+  switch (msg.op) {
+    case rpc_pb_ScheduleOp_SCHEDULE_OP_DIGITAL_WRITE_MASK:
+      e.mask = msg.mask & bridge::hal::pinmap::kDigitalPinMask;
+      e.value = msg.value;
+      if (e.mask == 0U) return false;
+      break;
+    case rpc_pb_ScheduleOp_SCHEDULE_OP_DIGITAL_WRITE:
+    case rpc_pb_ScheduleOp_SCHEDULE_OP_ANALOG_WRITE:
+      if (msg.pin >= bridge::config::DIGITAL_PINS) return false;
+      e.pin = static_cast<uint8_t>(msg.pin);
+      e.value = etl::min<uint32_t>(msg.value, 255U);
+      break;
+    default:
+      return false;
+  }
+
+  const uint32_t now = ::micros();
+  const int32_t lead = static_cast<int32_t>(e.at_us - now);
+  if (lead > kMaxLeadUs) return false;
+  if (lead <= 0) {
+    // Arrived after its deadline (link outage, late retransmit): act now
+    // rather than drop it, but make the miss visible.
+    BRIDGE_ATOMIC_BLOCK { _apply(e); }
+    if (now - e.at_us > kLateUs && _late < UINT16_MAX) ++_late;
+    return true;
+  }
+  if (_queue.full()) return false;
+  // upper_bound keeps writes with equal deadlines in arrival order.
+  const auto pos = etl::upper_bound(
+      _queue.begin(), _queue.end(), e,
+      [](const Entry& a, const Entry& b) { return _before(a.at_us, b.at_us); });
+  _queue.insert(pos, e);
+  _peak = etl::max(_peak, static_cast<uint16_t>(_queue.size()));
+  return true;
+}
+
+void TimelineClass::_apply(const Entry& e) {
+  switch (e.op) {
+    case rpc_pb_ScheduleOp_SCHEDULE_OP_DIGITAL_WRITE_MASK:
+      bridge::hal::digitalWriteMask(e.mask, e.value);
+      break;
+    case rpc_pb_ScheduleOp_SCHEDULE_OP_ANALOG_WRITE:
+      bridge::hal::fastAnalogWrite(e.pin, static_cast<int>(e.value));
+      break;
+    default:
+      bridge::hal::fastDigitalWrite(e.pin, e.value ? HIGH : LOW);
+      break;
+  }
+}
+
+void TimelineClass::_runDue(uint32_t now) {
+  size_t due = 0;
+  while (due < _queue.size() && !_before(now, _queue[due].at_us)) ++due;
+  BRIDGE_ATOMIC_BLOCK {
+    for (size_t i = 0; i < due; ++i) _apply(_queue[i]);
+  }
+  for (size_t i = 0; i < due; ++i) {
+    if (now - _queue[i].at_us > kLateUs && _late < UINT16_MAX) ++_late;
+  }
+  _queue.erase(_queue.begin(), _queue.begin() + due);
+}
+
+void TimelineClass::process() {
+  if (_queue.empty()) return;
+  const uint32_t at = _queue.front().at_us;
+  int32_t lead = static_cast<int32_t>(at - ::micros());
+  if (lead > kSpinUs) return;
+  // Close enough to spin: trading a few hundred microseconds of loop time
+  // for an edge that does not depend on when the next loop() pass lands.
+  while (lead > 0) lead = static_cast<int32_t>(at - ::micros());
+  _runDue(::micros());
+}
+
+void TimelineClass::onLost() { _queue.clear(); }
+
+TimelineType Timeline;
+
+#endif  // BRIDGE_ENABLE_TIMELINE
@@ -0,0 +1,63 @@
+#ifndef SERVICES_TIMELINE_H
+#define SERVICES_TIMELINE_H
+
+#include "config/bridge_config.h"
+
+#if BRIDGE_ENABLE_TIMELINE
+
+#undef min
+#undef max
+#include <etl/vector.h>
+
+#include "protocol/rpc_structs.h"
+
+/**
+ * @brief Deadline-ordered queue of GPIO writes timed against micros().
+ *
+ * Linux converts its own clock to the MCU clock with the CMD_CLOCK_SYNC
+ * exchange and sends each write ahead of time with an absolute
+ * execute_at_us, so link latency and retransmits no longer show up as
+ * output jitter. process() busy-waits the last BRIDGE_TIMELINE_SPIN_US
+ * before a deadline and applies every write due at the same instant in one
+ * critical section. Deadlines already in the past run at once and are
+ * counted as late.
+ */
+class TimelineClass {
+ public:
+  TimelineClass();
+
+  /** Queue (or, if already due, apply) one write. */
+  static bool schedule(const rpc::payload::ScheduleGpio& msg);
+  static void process();
+  static void onLost();
+
+  static size_t pending() { return _queue.size(); }
+  static uint16_t lateCount() { return _late; }
+  /** Highest queue depth since boot, for CMD_GET_MEMORY_PROFILE. */
+  static uint16_t peak() { return _peak; }
+
+ private:
+  struct Entry {
+    uint32_t at_us;
+    uint32_t mask;
+    uint32_t value;
+    uint8_t op;
+    uint8_t pin;
+  };
+
+  static bool _before(uint32_t a, uint32_t b) {
+    return static_cast<int32_t>(a - b) < 0;
+  }
+  static void _apply(const Entry& e);
+  static void _runDue(uint32_t now);
+
+  static etl::vector<Entry, bridge::config::MAX_SCHEDULED_OPS> _queue;
+  static uint16_t _late;
+  static uint16_t _peak;
+};
+
+using TimelineType = TimelineClass;
+extern TimelineType Timeline;
+
+#endif  // BRIDGE_ENABLE_TIMELINE
+#endif  // SERVICES_TIMELINE_H
@@ -0,0 +1,155 @@
+#include "services/Waveform.h"
+
+#include <etl/algorithm.h>
+
+#if BRIDGE_ENABLE_WAVEFORM
+
+#include "hal/hal.h"
+
+namespace {
+inline bool _validStep(uint32_t pin, uint32_t delay_us) {
+  return pin < bridge::config::DIGITAL_PINS &&
+         delay_us >= bridge::config::WAVEFORM_MIN_STEP_US;
+}
+}  // namespace
+
+etl::vector<WaveformClass::Step, bridge::config::MAX_WAVEFORM_STEPS>
+    WaveformClass::_steps;
+uint32_t WaveformClass::_next_us = 0;
+uint32_t WaveformClass::_loops_left = 0;
+uint32_t WaveformClass::_late = 0;
+uint16_t WaveformClass::_index = 0;
+bool WaveformClass::_forever = false;
+bool WaveformClass::_timer = false;
+volatile bool WaveformClass::_playing = false;
+
+WaveformClass::WaveformClass() {}
+
+bool WaveformClass::load(const rpc::payload::WaveformLoad& msg) {
+  static_assert(sizeof(msg.steps) / sizeof(msg.steps[0]) ==
+                    rpc::RPC_WAVEFORM_LOAD_MAX_STEPS,
+                "mcubridge.options and the load constants disagree");
+  static_assert(sizeof(msg.duty.bytes) == rpc::RPC_WAVEFORM_LOAD_MAX_DUTY,
+                "mcubridge.options and the load constants disagree");
+  stop();
+  if (msg.offset == 0U) {
+    _steps.clear();
+  } else if (msg.offset != _steps.size()) {
+    // A chunk went missing or arrived twice: refuse rather than play a
+    // program with a hole in it.
+    return false;
+  }
+
+  // Validate the whole chunk first so a refused chunk leaves the program
+  // as it was.
+  const size_t count = static_cast<size_t>(msg.steps_count) + msg.duty.size;
+  if (count > _steps.available()) return false;
+  for (pb_size_t i = 0; i < msg.steps_count; ++i) {
+    if (!_validStep(msg.steps[i].pin, msg.steps[i].delay_us)) return false;
+  }
+  if (msg.duty.size > 0U && !_validStep(msg.duty_pin, msg.duty_period_us))
+    return false;
+
+  for (pb_size_t i = 0; i < msg.steps_count; ++i) {
+    const auto& s = msg.steps[i];
+    _append(s.pin, s.value, s.delay_us, s.pwm);
+  }
+  for (pb_size_t i = 0; i < msg.duty.size; ++i) {
+    _append(msg.duty_pin, msg.duty.bytes[i], msg.duty_period_us, true);
+  }
+  return true;
+}
+
+void WaveformClass::_append(uint32_t pin, uint32_t value, uint32_t delay_us,
+                            bool pwm) {
+  Step s = {};
+  s.delay_us = delay_us;
+  s.pin = static_cast<uint8_t>(pin);
+  s.value = pwm ? static_cast<uint8_t>(etl::min<uint32_t>(value, 255U))
+                : static_cast<uint8_t>(value != 0U ? HIGH : LOW);
+  s.pwm = pwm;
+  _steps.push_back(s);
+}
+
+bool WaveformClass::start(const rpc::payload::WaveformStart& msg) {
+  stop();
+  if (_steps.empty()) return false;
+  _index = 0;
+  _forever = (msg.loops == 0U);
+  _loops_left = msg.loops;
+  _late = 0;
+  _playing = true;
+  const uint32_t delay_us = _step();
+  if (delay_us == 0U) return true;
+  _next_us = ::micros() + delay_us;
+  _timer = bridge::hal::startPeriodicTimer(delay_us, &WaveformClass::_onTick);
+  return true;
+}
+
+void WaveformClass::stop() {
+  if (_timer) bridge::hal::stopPeriodicTimer();
+  BRIDGE_ATOMIC_BLOCK {
+    _timer = false;
+    _playing = false;
+  }
+}
+
+void WaveformClass::onLost() {
+  stop();
+  _steps.clear();
+}
+
+// Applies the current step and advances. Returns how long to hold it, or 0
+// once the last loop has finished.
+uint32_t WaveformClass::_step() {
+  const Step& s = _steps[_index];
+  if (s.pwm) {
+    bridge::hal::fastAnalogWrite(s.pin, s.value);
+  } else {
+    bridge::hal::fastDigitalWrite(s.pin, s.value);
+  }
+  if (++_index < _steps.size()) return s.delay_us;
+  _index = 0;
+  if (!_forever && --_loops_left == 0U) {
+    _playing = false;
+    return 0U;
+  }
+  return s.delay_us;
+}
+
+// [ISR] Timer callback when the HAL provides one. It re-arms the timer with
+// the delay of the step it just applied; a delay the timer cannot express
+// hands the rest of the playback over to process().
+void WaveformClass::_onTick() {
+  if (!_playing) return;
+  const uint32_t delay_us = _step();
+  if (delay_us != 0U &&
+      bridge::hal::startPeriodicTimer(delay_us, &WaveformClass::_onTick)) {
+    return;
+  }
+  bridge::hal::stopPeriodicTimer();
+  _next_us = ::micros() + delay_us;
+  _timer = false;
+}
+
+void WaveformClass::process() {
+  bool timer = false;
+  BRIDGE_ATOMIC_BLOCK { timer = _timer; }
+  if (timer) return;
+  const uint32_t now = ::micros();
+  uint8_t caught_up = 0;
+  while (_playing && static_cast<int32_t>(now - _next_us) >= 0) {
+    if (caught_up++ == kMaxCatchUpSteps) {
+      // Too far behind (long loop() pass): restart the timing from now
+      // instead of racing through the missed steps.
+      ++_late;
+      _next_us = now;
+      break;
+    }
+    _next_us += _step();
+  }
+}
+
+WaveformType Waveform;
+
+#endif  // BRIDGE_ENABLE_WAVEFORM
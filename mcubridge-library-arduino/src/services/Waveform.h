@@ -0,0 +1,71 @@
+#ifndef SERVICES_WAVEFORM_H
+#define SERVICES_WAVEFORM_H
+
+#include "config/bridge_config.h"
+
+#if BRIDGE_ENABLE_WAVEFORM
+
+#undef min
+#undef max
+#include <etl/vector.h>
+
+#include "protocol/rpc_structs.h"
+
+/**
+ * @brief Plays a preloaded sequence of (pin, value, delay) steps.
+ *
+ * Linux uploads the program in CMD_WAVEFORM_LOAD chunks, either explicit
+ * steps or a PWM duty table, into a static buffer and then starts it with a
+ * loop count. Each step is applied from the hardware timer interrupt when
+ * the HAL offers one (the timer is re-armed with the next step's delay),
+ * otherwise from process() against micros() with nominal deadlines, so
+ * timing errors do not accumulate across steps or loops. Loading a new
+ * program stops playback; outputs keep their last value when it ends.
+ */
+class WaveformClass {
+ public:
+  WaveformClass();
+
+  /** Append one chunk to the program (offset 0 replaces it). */
+  static bool load(const rpc::payload::WaveformLoad& msg);
+  static bool start(const rpc::payload::WaveformStart& msg);
+  static void stop();
+  static void process();
+  static void onLost();
+
+  static bool playing() { return _playing; }
+  static size_t length() { return _steps.size(); }
+  static uint32_t lateCount() { return _late; }
+
+ private:
+  struct Step {
+    uint32_t delay_us;
+    uint8_t pin;
+    uint8_t value;
+    bool pwm;
+  };
+
+  // Steps applied back-to-back by the micros() scheduler before it gives up
+  // on catching up and restarts the timing from now.
+  static constexpr uint8_t kMaxCatchUpSteps = 4;
+
+  static void _append(uint32_t pin, uint32_t value, uint32_t delay_us,
+                      bool pwm);
+  static void _onTick();
+  static uint32_t _step();
+
+  static etl::vector<Step, bridge::config::MAX_WAVEFORM_STEPS> _steps;
+  static uint32_t _next_us;
+  static uint32_t _loops_left;
+  static uint32_t _late;
+  static uint16_t _index;
+  static bool _forever;
+  static bool _timer;
+  static volatile bool _playing;
+};
+
+using WaveformType = WaveformClass;
+extern WaveformType Waveform;
+
+#endif  // BRIDGE_ENABLE_WAVEFORM
+#endif  // SERVICES_WAVEFORM_H
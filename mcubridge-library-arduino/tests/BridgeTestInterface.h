@@ -87,6 +87,8 @@ class TestAccessor : public BridgeClass {
   void onRxDedupe() { _onRxDedupe(); }
   void setPendingBaudrate(uint32_t b) { _pending_baudrate = b; }
   void onBaudrateChange() { _onBaudrateChange(); }
+  void onBaudrateConfirmTimeout() { _onBaudrateConfirmTimeout(); }
+  uint32_t getBaudrate() const { return _baudrate; }
   void invokeWatchdog() { _watchdogTask(); }
   void invokeSerialTask() { _serialTask(); }
   void invokeTimerTask() { _timerTask(); }
@@ -121,6 +123,20 @@ class TestAccessor : public BridgeClass {
   }
   void setRxNonceCounter(uint64_t counter) { _rx_nonce_counter = counter; }
 
+  size_t pendingRequests() const { return _requests.size(); }
+  // Sequence id of the last request sent.
+  uint16_t lastRequestSequence() const { return _tx_sequence_id; }
+  // Answer the last request sent as Linux would, without framing.
+  template <typename T>
+  bool completeRequest(rpc::CommandId response, const T& msg,
+                       bool last = true) {
+    return _requests.complete(_tx_sequence_id, rpc::to_underlying(response),
+                              msg, last);
+  }
+  void onRequestTimeout() { _onRequestTimeout(); }
+  // Run a timer's callback as _timers would when it expires.
+  void fireTimer(bridge::scheduler::TimerId id) { _timer_callbacks[id](); }
+
   void setIdle() {
     if (!_fsm.is_started()) _fsm.start();
     _fsm.receive(bridge::fsm::EvReset());
@@ -13,6 +13,7 @@
 #include "Bridge.h"
 #include "host_serial_stream.h"
 #include "services/Console.h"
+#include "services/LoopProfiler.h"
 
 // External delegate for stream
 Stream* g_arduino_stream_delegate = nullptr;
@@ -35,8 +36,36 @@ unsigned long millis() {
   return (ts.tv_sec * 1000) + (ts.tv_nsec / 1000000);
 }
 
+unsigned long micros() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (ts.tv_sec * 1000000UL) + (ts.tv_nsec / 1000);
+}
+
 void delay(unsigned long ms) { usleep(ms * 1000); }
 
+#if BRIDGE_ENABLE_LOOP_PROFILER
+// Benchmark summary: one line per Bridge.process() phase, each bucket shown
+// as "<lower bound in us>:<count>" and empty buckets skipped.
+static void dump_loop_profile() {
+  static const char* const kNames[LoopProfilerClass::kPhases] = {
+      "total", "watchdog", "serial", "timers", "mailbox", "services"};
+  for (uint8_t p = 0; p < LoopProfilerClass::kPhases; ++p) {
+    rpc_pb_LoopProfile prof = rpc_pb_LoopProfile_init_default;
+    LoopProfiler.snapshot(static_cast<rpc_pb_LoopPhase>(p), prof);
+    fprintf(stderr, "[profile] %-8s samples=%u max=%uus", kNames[p],
+            static_cast<unsigned>(prof.samples),
+            static_cast<unsigned>(prof.max_us));
+    for (pb_size_t b = 0; b < prof.buckets_count; ++b) {
+      if (prof.buckets[b] == 0U) continue;
+      fprintf(stderr, " %lu:%u", b == 0U ? 0UL : 1UL << b,
+              static_cast<unsigned>(prof.buckets[b]));
+    }
+    fprintf(stderr, "\n");
+  }
+}
+#endif
+
 int main(int argc, char** argv) {
   (void)argc;
   (void)argv;
@@ -68,5 +97,8 @@ int main(int argc, char** argv) {
     usleep(1000);
   }
   fprintf(stderr, "McuBridge Emulator Terminating...\n");
+#if BRIDGE_ENABLE_LOOP_PROFILER
+  dump_loop_profile();
+#endif
   return 0;
 }
\ No newline at end of file
@@ -2,6 +2,13 @@
 #include <Arduino.h>
 #include <etl/array.h>
 
+#if BRIDGE_ENABLE_THREADED
+#include <pb_decode.h>
+
+#include <atomic>
+#include <thread>
+#endif
+
 #include "Bridge.h"
 #include "BridgeTestInterface.h"
 #include "test_support.h"
@@ -94,6 +101,65 @@ void test_bridge_fsm_illegal_transitions() {
   TEST_ASSERT_TRUE(true);
 }
 
+#if BRIDGE_ENABLE_THREADED
+void test_threaded_submit_contention() {
+  constexpr uint32_t kProducers = 4;
+  constexpr uint32_t kPerProducer = 32;
+  BiStream stream;
+  reset_bridge_core(Bridge, stream);
+  auto& ba = TestAccessor::create(Bridge);
+  ba.setSynchronized();
+  // Plaintext keeps the payloads readable here.
+  ba.setSharedSecret(etl::span<const uint8_t>());
+
+  TEST_ASSERT_TRUE(Bridge.startTask());
+  TEST_ASSERT_FALSE(Bridge.startTask());
+
+  std::atomic<uint32_t> sent{0};
+  etl::array<std::thread, kProducers> producers;
+  for (uint32_t p = 0; p < kProducers; ++p) {
+    producers[p] = std::thread([p, &sent] {
+      for (uint32_t i = 0; i < kPerProducer; ++i) {
+        rpc::payload::ReflexFired msg = rpc_pb_ReflexFired_init_default;
+        msg.rule_id = p * 1000U + i;
+        bridge::Completion done;
+        while (!Bridge.submit(rpc::CommandId::CMD_REFLEX_FIRED, msg, &done)) {
+          bridge::hal::idleTask();
+        }
+        if (done.wait()) sent.fetch_add(1, std::memory_order_relaxed);
+      }
+    });
+  }
+  for (auto& t : producers) t.join();
+  Bridge.stopTask();
+  TEST_ASSERT_TRUE(Bridge.startTask());
+  Bridge.stopTask();
+
+  TEST_ASSERT_EQUAL_UINT32(kProducers * kPerProducer, sent.load());
+
+  // Every frame went out once, and each producer's in submission order.
+  etl::array<uint32_t, kProducers> next = {};
+  uint32_t frames = 0;
+  size_t cursor = 0;
+  rpc_pb_RpcEnvelope frame;
+  while (extract_next_valid_frame(stream.tx_buf, cursor, frame)) {
+    if (frame.command_id !=
+        rpc::to_underlying(rpc::CommandId::CMD_REFLEX_FIRED)) {
+      continue;
+    }
+    const auto& bytes = frame.payload_type.encrypted_payload_with_tag;
+    pb_istream_t in = pb_istream_from_buffer(bytes.bytes, bytes.size);
+    rpc::payload::ReflexFired msg = rpc_pb_ReflexFired_init_default;
+    TEST_ASSERT_TRUE(pb_decode(&in, rpc_pb_ReflexFired_fields, &msg));
+    const uint32_t p = msg.rule_id / 1000U;
+    TEST_ASSERT_TRUE(p < kProducers);
+    TEST_ASSERT_EQUAL_UINT32(next[p]++, msg.rule_id % 1000U);
+    ++frames;
+  }
+  TEST_ASSERT_EQUAL_UINT32(kProducers * kPerProducer, frames);
+}
+#endif
+
 }  // namespace
 
 int main() {
@@ -102,5 +168,8 @@ int main() {
   RUN_TEST(test_bridge_packet_corruption_chaos);
   RUN_TEST(test_bridge_dispatch_security_denial);
   RUN_TEST(test_bridge_fsm_illegal_transitions);
+#if BRIDGE_ENABLE_THREADED
+  RUN_TEST(test_threaded_submit_contention);
+#endif
   return UNITY_END();
 }
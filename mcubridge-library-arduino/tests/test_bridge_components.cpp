@@ -1,14 +1,30 @@
 #include <stddef.h>
 #include <stdint.h>
+#include <stdio.h>
 #include <string.h>
 
 #define BRIDGE_ENABLE_TEST_INTERFACE 1
 #include "Bridge.h"
+#include "BridgeFaultInjection.h"
 #include "BridgeTestInterface.h"
+#include "hal/PinMap.h"
+#include "hal/hal.h"
+#include "services/Aggregator.h"
 #include "services/Console.h"
 #include "services/DataStore.h"
+#include "services/Events.h"
+#include "services/FrameTrace.h"
+#include "services/I2CService.h"
+#include "services/KVStore.h"
+#include "services/LoopProfiler.h"
 #include "services/Mailbox.h"
+#include "services/PinEvents.h"
 #include "services/Process.h"
+#include "services/Reflex.h"
+#include "services/Sampler.h"
+#include "services/Telemetry.h"
+#include "services/Timeline.h"
+#include "services/Waveform.h"
 #include "test_support.h"
 
 // Define the global delegates and stubs for HardwareSerial stub
@@ -169,6 +185,1361 @@ void test_mailbox_api() {
 #endif
 }
 
+void test_port_mask_commands() {
+  BiStream stream;
+  reset_bridge_comp(stream);
+  auto& ba = TestAccessor::create(Bridge);
+
+  rpc_pb_RpcEnvelope frame = rpc_pb_RpcEnvelope_init_default;
+  frame.version = rpc::PROTOCOL_VERSION;
+  frame.command_id =
+      rpc::to_underlying(rpc::CommandId::CMD_DIGITAL_WRITE_MASK);
+  rpc_pb_DigitalWriteMask write_msg = rpc_pb_DigitalWriteMask_init_default;
+  write_msg.mask = 0x00F0U;
+  write_msg.value = 0x0050U;
+  bridge::test::set_pb_payload(frame, write_msg);
+  stream.tx_buf.clear();
+  ba.dispatch(frame);
+  TEST_ASSERT_FALSE(ba.isFault());
+  TEST_ASSERT_TRUE(stream.tx_buf.len > 0);  // ACK
+
+  frame = rpc_pb_RpcEnvelope_init_default;
+  frame.version = rpc::PROTOCOL_VERSION;
+  frame.command_id = rpc::to_underlying(rpc::CommandId::CMD_DIGITAL_READ_PORT);
+  rpc_pb_DigitalReadPort read_msg = rpc_pb_DigitalReadPort_init_default;
+  read_msg.mask = 0xFFFFFFFFU;
+  bridge::test::set_pb_payload(frame, read_msg);
+  stream.tx_buf.clear();
+  ba.dispatch(frame);
+  TEST_ASSERT_FALSE(ba.isFault());
+  TEST_ASSERT_TRUE(stream.tx_buf.len > 0);  // DIGITAL_READ_PORT_RESP
+
+  // Bits outside the advertised pin range are never reported.
+  TEST_ASSERT_EQUAL_UINT32(
+      0U, bridge::hal::digitalReadPort(0xFFFFFFFFU) &
+              ~bridge::hal::pinmap::kDigitalPinMask);
+}
+
+void test_pin_event_subscriptions() {
+  BiStream stream;
+  reset_bridge_comp(stream);
+  auto& ba = TestAccessor::create(Bridge);
+  PinEvents.onLost();
+
+  rpc_pb_RpcEnvelope frame = rpc_pb_RpcEnvelope_init_default;
+  frame.version = rpc::PROTOCOL_VERSION;
+  frame.command_id = rpc::to_underlying(rpc::CommandId::CMD_PIN_SUBSCRIBE);
+  rpc_pb_PinSubscribe sub = rpc_pb_PinSubscribe_init_default;
+  sub.pin = 2;
+  sub.edge = rpc_pb_PinEdge_PIN_EDGE_CHANGE;
+  sub.debounce_ms = 5;
+  bridge::test::set_pb_payload(frame, sub);
+  ba.dispatch(frame);
+  TEST_ASSERT_FALSE(ba.isFault());
+
+  // Idle inputs (stub reads LOW) generate no edges and no traffic.
+  stream.tx_buf.clear();
+  Bridge.process();
+  TEST_ASSERT_EQUAL_UINT32(0U, PinEvents.pending());
+  TEST_ASSERT_EQUAL_UINT32(0U, stream.tx_buf.len);
+
+  // Out-of-range pin and table exhaustion are rejected.
+  sub.pin = bridge::config::DIGITAL_PINS;
+  TEST_ASSERT_FALSE(PinEvents.subscribe(sub));
+  for (uint8_t pin = 3; pin < 3 + bridge::config::MAX_PIN_SUBSCRIPTIONS - 1;
+       ++pin) {
+    sub.pin = pin;
+    TEST_ASSERT_TRUE(PinEvents.subscribe(sub));
+  }
+  sub.pin = 3 + bridge::config::MAX_PIN_SUBSCRIPTIONS;
+  TEST_ASSERT_FALSE(PinEvents.subscribe(sub));
+
+  // Cancelling frees the slot again.
+  sub.pin = 2;
+  sub.edge = rpc_pb_PinEdge_PIN_EDGE_NONE;
+  TEST_ASSERT_TRUE(PinEvents.subscribe(sub));
+  sub.pin = 3 + bridge::config::MAX_PIN_SUBSCRIPTIONS;
+  sub.edge = rpc_pb_PinEdge_PIN_EDGE_RISING;
+  TEST_ASSERT_TRUE(PinEvents.subscribe(sub));
+  PinEvents.onLost();
+}
+
+void test_isr_events() {
+  // Indices are single bytes: run the ring across their wrap.
+  bridge::IsrRing<uint16_t, 4> ring;
+  for (uint16_t i = 0; i < 300; ++i) {
+    TEST_ASSERT_TRUE(ring.push(i));
+    TEST_ASSERT_EQUAL_UINT8(1U, ring.size());
+    TEST_ASSERT_EQUAL_UINT16(i, ring.peek(0));
+    ring.pop(1);
+  }
+  for (uint16_t i = 0; i < 4; ++i) TEST_ASSERT_TRUE(ring.push(i));
+  TEST_ASSERT_FALSE(ring.push(4));
+  TEST_ASSERT_EQUAL_UINT8(1U, ring.overflows());
+  TEST_ASSERT_EQUAL_UINT8(4U, ring.peak());
+  ring.clear();
+  TEST_ASSERT_EQUAL_UINT8(0U, ring.size());
+
+  BiStream stream;
+  reset_bridge_comp(stream);
+  Events.onLost();
+
+  // Nothing pushed: no traffic.
+  stream.tx_buf.clear();
+  Events.process();
+  TEST_ASSERT_EQUAL_UINT32(0U, stream.tx_buf.len);
+
+  // Overfill the ring as a burst of interrupts would.
+  constexpr size_t kRing = bridge::config::EVENT_RING_SIZE;
+  for (size_t i = 0; i < kRing; ++i) {
+    TEST_ASSERT_TRUE(Events.push(7, static_cast<uint16_t>(i)));
+  }
+  TEST_ASSERT_FALSE(Events.push(7, 0xFFFF));
+  TEST_ASSERT_FALSE(Events.push(8));
+  TEST_ASSERT_EQUAL_UINT32(kRing, Events.pending());
+  TEST_ASSERT_EQUAL_UINT8(kRing, Events.ringPeak());
+
+  // One batch (up to 4 events plus the dropped count) per pass.
+  Events.process();
+  TEST_ASSERT_TRUE(stream.tx_buf.len > 0);  // CMD_EVENT_BATCH
+  TEST_ASSERT_EQUAL_UINT32(kRing - 4U, Events.pending());
+
+  // Link loss discards what was captured for the old session.
+  Events.onLost();
+  TEST_ASSERT_EQUAL_UINT32(0U, Events.pending());
+  stream.tx_buf.clear();
+  Events.process();
+  TEST_ASSERT_EQUAL_UINT32(0U, stream.tx_buf.len);
+}
+
+void test_sampler_stream() {
+  BiStream stream;
+  reset_bridge_comp(stream);
+  auto& ba = TestAccessor::create(Bridge);
+
+  rpc_pb_RpcEnvelope frame = rpc_pb_RpcEnvelope_init_default;
+  frame.version = rpc::PROTOCOL_VERSION;
+  frame.command_id = rpc::to_underlying(rpc::CommandId::CMD_STREAM_START);
+  rpc_pb_StreamConfig cfg = rpc_pb_StreamConfig_init_default;
+  cfg.channel_mask = 0x03U;
+  cfg.period_us = 1000U;
+  cfg.batch_scans = 1U;
+  cfg.delta = true;
+  bridge::test::set_pb_payload(frame, cfg);
+  ba.dispatch(frame);
+  TEST_ASSERT_FALSE(ba.isFault());
+  TEST_ASSERT_TRUE(Sampler.running());
+
+  // The first scan is due immediately and fills a one-scan batch.
+  stream.tx_buf.clear();
+  Bridge.process();
+  TEST_ASSERT_TRUE(stream.tx_buf.len > 0);  // CMD_STREAM_DATA
+  TEST_ASSERT_EQUAL_UINT32(0U, Sampler.overruns());
+
+  // Invalid channel masks and periods below the ADC budget are rejected.
+  cfg.channel_mask = 1UL << bridge::config::ANALOG_PINS;
+  TEST_ASSERT_FALSE(Sampler.start(cfg));
+  TEST_ASSERT_FALSE(Sampler.running());
+  cfg.channel_mask = 0x03U;
+  cfg.period_us = bridge::config::STREAM_MIN_PERIOD_US;
+  TEST_ASSERT_FALSE(Sampler.start(cfg));
+
+  cfg.period_us = 1000U;
+  TEST_ASSERT_TRUE(Sampler.start(cfg));
+  frame = rpc_pb_RpcEnvelope_init_default;
+  frame.version = rpc::PROTOCOL_VERSION;
+  frame.command_id = rpc::to_underlying(rpc::CommandId::CMD_STREAM_STOP);
+  ba.dispatch(frame);
+  TEST_ASSERT_FALSE(ba.isFault());
+  TEST_ASSERT_FALSE(Sampler.running());
+}
+
+namespace {
+// Timer1 and the ADC interrupt, driven by hand so the timer path of the
+// Sampler runs on the host. Off unless a test sets g_fake_timer.
+bool g_fake_timer = false;
+void (*g_fake_tick)() = nullptr;
+void (*g_fake_adc_done)(uint16_t) = nullptr;
+uint8_t g_fake_adc_pin = 0xFFU;
+
+// Finish the conversion in flight, as the ADC-complete interrupt does.
+void fake_adc_complete(uint16_t value) {
+  void (*done)(uint16_t) = g_fake_adc_done;
+  TEST_ASSERT_NOT_NULL(done);
+  g_fake_adc_done = nullptr;
+  done(value);
+}
+
+rpc_pb_StreamData next_stream_data(BiStream& stream, size_t& cursor) {
+  rpc_pb_RpcEnvelope reply = rpc_pb_RpcEnvelope_init_default;
+  TEST_ASSERT_TRUE(extract_next_valid_frame(stream.tx_buf, cursor, reply));
+  TEST_ASSERT_EQUAL_UINT16(rpc::to_underlying(rpc::CommandId::CMD_STREAM_DATA),
+                           reply.command_id);
+  TEST_ASSERT_EQUAL(rpc::Payload::get_tag<rpc_pb_StreamData>(),
+                    reply.which_payload_type);
+  return rpc::Payload::get<rpc_pb_StreamData>(reply);
+}
+}  // namespace
+
+namespace bridge::hal {
+bool startPeriodicTimer(uint32_t, void (*callback)()) {
+  if (!g_fake_timer) return false;
+  g_fake_tick = callback;
+  return true;
+}
+void stopPeriodicTimer() { g_fake_tick = nullptr; }
+bool startAnalogConversion(uint8_t pin, void (*done)(uint16_t value)) {
+  if (!g_fake_timer || g_fake_adc_done != nullptr) return false;
+  g_fake_adc_pin = pin;
+  g_fake_adc_done = done;
+  return true;
+}
+}  // namespace bridge::hal
+
+void test_sampler_timer_scans() {
+  BiStream stream;
+  reset_bridge_comp(stream);
+  auto& ba = TestAccessor::create(Bridge);
+  // Plaintext keeps the frames readable here; AEAD is covered elsewhere.
+  ba.setSharedSecret(etl::span<const uint8_t>());
+  g_fake_timer = true;
+
+  rpc_pb_StreamConfig cfg = rpc_pb_StreamConfig_init_default;
+  cfg.channel_mask = 0x03U;
+  cfg.period_us = 1000U;
+  cfg.batch_scans = 2U;
+  TEST_ASSERT_TRUE(Sampler.start(cfg));
+  TEST_ASSERT_NOT_NULL(g_fake_tick);
+
+  // With the timer running, process() only sends what the ticks sampled.
+  stream.tx_buf.clear();
+  Bridge.process();
+  TEST_ASSERT_EQUAL_UINT32(0U, stream.tx_buf.len);
+  TEST_ASSERT_NULL(g_fake_adc_done);
+
+  // Each tick converts A0; its completion chains A1.
+  for (uint16_t scan = 0; scan < 2U; ++scan) {
+    g_fake_tick();
+    TEST_ASSERT_EQUAL_UINT8(0U, g_fake_adc_pin);
+    fake_adc_complete(static_cast<uint16_t>(100U + scan));
+    TEST_ASSERT_EQUAL_UINT8(1U, g_fake_adc_pin);
+    fake_adc_complete(static_cast<uint16_t>(200U + scan));
+  }
+  TEST_ASSERT_NULL(g_fake_adc_done);
+  Bridge.process();
+  size_t cursor = 0;
+  rpc_pb_StreamData data = next_stream_data(stream, cursor);
+  TEST_ASSERT_EQUAL_UINT32(0U, data.seq);
+  TEST_ASSERT_EQUAL_UINT32(2U, data.scans);
+  TEST_ASSERT_EQUAL_UINT32(0U, data.overruns);
+  TEST_ASSERT_EQUAL(8, data.samples.size);
+  TEST_ASSERT_EQUAL_UINT8(100U, data.samples.bytes[0]);
+  TEST_ASSERT_EQUAL_UINT8(200U, data.samples.bytes[2]);
+  TEST_ASSERT_EQUAL_UINT8(101U, data.samples.bytes[4]);
+  TEST_ASSERT_EQUAL_UINT8(201U, data.samples.bytes[6]);
+
+  // A tick while the last scan is still converting is an overrun, not a
+  // late sample, and the gap ends the batch.
+  g_fake_tick();
+  g_fake_tick();
+  TEST_ASSERT_EQUAL_UINT32(1U, Sampler.overruns());
+  fake_adc_complete(300U);
+  fake_adc_complete(400U);
+  g_fake_tick();
+  fake_adc_complete(301U);
+  fake_adc_complete(401U);
+  Bridge.process();
+  data = next_stream_data(stream, cursor);
+  TEST_ASSERT_EQUAL_UINT32(1U, data.seq);
+  TEST_ASSERT_EQUAL_UINT32(1U, data.scans);
+  TEST_ASSERT_EQUAL_UINT32(1U, data.overruns);
+  TEST_ASSERT_EQUAL(4, data.samples.size);
+  TEST_ASSERT_EQUAL_UINT8(44U, data.samples.bytes[0]);  // 300
+  TEST_ASSERT_EQUAL_UINT8(144U, data.samples.bytes[2]);  // 400
+
+  // Nothing is left converting, so stop() returns at once.
+  Sampler.stop();
+  TEST_ASSERT_NULL(g_fake_tick);
+  g_fake_timer = false;
+}
+
+void test_telemetry_jobs() {
+  BiStream stream;
+  reset_bridge_comp(stream);
+  auto& ba = TestAccessor::create(Bridge);
+  Telemetry.onLost();
+
+  rpc_pb_RpcEnvelope frame = rpc_pb_RpcEnvelope_init_default;
+  frame.version = rpc::PROTOCOL_VERSION;
+  frame.command_id = rpc::to_underlying(rpc::CommandId::CMD_TELEMETRY_JOB);
+  rpc_pb_TelemetryJob job = rpc_pb_TelemetryJob_init_default;
+  job.job_id = 0;
+  job.pin = 0;
+  job.analog = true;
+  job.period_ms = 100;
+  job.deadband = 4;
+  job.heartbeat_ms = 60000;
+  bridge::test::set_pb_payload(frame, job);
+  ba.dispatch(frame);
+  TEST_ASSERT_FALSE(ba.isFault());
+
+  // The first sample is always reported; an unchanged value is not.
+  stream.tx_buf.clear();
+  Bridge.process();
+  TEST_ASSERT_TRUE(stream.tx_buf.len > 0);  // CMD_TELEMETRY_REPORT
+  TEST_ASSERT_EQUAL_UINT32(0U, Telemetry.pending());
+
+  // Unknown slots and out-of-range pins are rejected; period 0 clears.
+  job.job_id = bridge::config::MAX_TELEMETRY_JOBS;
+  TEST_ASSERT_FALSE(Telemetry.configure(job));
+  job.job_id = 1;
+  job.pin = bridge::config::ANALOG_PINS;
+  TEST_ASSERT_FALSE(Telemetry.configure(job));
+  job.job_id = 0;
+  job.period_ms = 0;
+  TEST_ASSERT_TRUE(Telemetry.configure(job));
+  Telemetry.onLost();
+}
+
+void test_aggregation_windows() {
+  BiStream stream;
+  reset_bridge_comp(stream);
+  auto& ba = TestAccessor::create(Bridge);
+
+  rpc_pb_RpcEnvelope frame = rpc_pb_RpcEnvelope_init_default;
+  frame.version = rpc::PROTOCOL_VERSION;
+  frame.command_id = rpc::to_underlying(rpc::CommandId::CMD_AGGREGATE_CONFIG);
+  rpc_pb_AggregateConfig cfg = rpc_pb_AggregateConfig_init_default;
+  cfg.channel_mask = 0x01U;
+  cfg.sample_period_ms = 10U;
+  cfg.window_ms = 100U;
+  bridge::test::set_pb_payload(frame, cfg);
+  ba.dispatch(frame);
+  TEST_ASSERT_FALSE(ba.isFault());
+  TEST_ASSERT_TRUE(Aggregator.running());
+
+#if defined(ARDUINO_STUB_CUSTOM_MILLIS)
+  // One sample in the first window, then the window closes and its single
+  // per-channel report drains on the same pass.
+  Aggregator.process();
+  bridge::test::fault::advance_clock_ms(cfg.window_ms);
+  stream.tx_buf.clear();
+  Aggregator.process();
+  TEST_ASSERT_EQUAL_UINT8(0U, Aggregator.pendingReports());
+  TEST_ASSERT_TRUE(stream.tx_buf.len > 0);  // CMD_AGGREGATE_REPORT
+#endif
+
+  // Window shorter than the sample period and unknown channels are rejected.
+  cfg.window_ms = 5U;
+  TEST_ASSERT_FALSE(Aggregator.configure(cfg));
+  cfg.window_ms = 100U;
+  cfg.channel_mask = 1UL << bridge::config::ANALOG_PINS;
+  TEST_ASSERT_FALSE(Aggregator.configure(cfg));
+  cfg.channel_mask = 0U;
+  TEST_ASSERT_TRUE(Aggregator.configure(cfg));
+  TEST_ASSERT_FALSE(Aggregator.running());
+}
+
+void test_reflex_rules() {
+  BiStream stream;
+  reset_bridge_comp(stream);
+  auto& ba = TestAccessor::create(Bridge);
+  Reflex.onLost();
+
+  rpc_pb_RpcEnvelope frame = rpc_pb_RpcEnvelope_init_default;
+  frame.version = rpc::PROTOCOL_VERSION;
+  frame.command_id = rpc::to_underlying(rpc::CommandId::CMD_REFLEX_RULE);
+  rpc_pb_ReflexRule rule = rpc_pb_ReflexRule_init_default;
+  rule.rule_id = 0;
+  rule.trigger = rpc_pb_ReflexTrigger_REFLEX_TRIGGER_PIN_LOW;
+  rule.pin = 2;
+  rule.action = rpc_pb_ReflexAction_REFLEX_ACTION_DIGITAL_WRITE;
+  rule.out_pin = 13;
+  rule.value = 1;
+  rule.notify = true;
+  bridge::test::set_pb_payload(frame, rule);
+  ba.dispatch(frame);
+  TEST_ASSERT_FALSE(ba.isFault());
+  TEST_ASSERT_EQUAL_UINT32(1U, Reflex.activeRules());
+
+  // Stub inputs read LOW: the rule fires on the first pass and notifies.
+  // With TX busy the notice is kept rather than lost.
+  stream.tx_buf.clear();
+  ba.setTxEnabled(false);
+  Reflex.process();
+  TEST_ASSERT_EQUAL_UINT32(0U, stream.tx_buf.len);
+  ba.setTxEnabled(true);
+  Reflex.process();
+  TEST_ASSERT_TRUE(stream.tx_buf.len > 0);  // CMD_REFLEX_FIRED
+  TEST_ASSERT_EQUAL_UINT16(0U, Reflex.droppedNotices());
+  stream.tx_buf.clear();
+  Reflex.process();
+  TEST_ASSERT_EQUAL_UINT32(0U, stream.tx_buf.len);  // edge, not level
+
+  // Out-of-range slots/pins and zero-period timers are rejected.
+  rule.rule_id = bridge::config::MAX_REFLEX_RULES;
+  TEST_ASSERT_FALSE(Reflex.configure(rule));
+  rule.rule_id = 1;
+  rule.out_pin = bridge::config::DIGITAL_PINS;
+  TEST_ASSERT_FALSE(Reflex.configure(rule));
+  rule.out_pin = 13;
+  rule.trigger = rpc_pb_ReflexTrigger_REFLEX_TRIGGER_TIMER;
+  rule.period_ms = 0;
+  TEST_ASSERT_FALSE(Reflex.configure(rule));
+
+  rule.rule_id = 0;
+  rule.trigger = rpc_pb_ReflexTrigger_REFLEX_TRIGGER_NONE;
+  TEST_ASSERT_TRUE(Reflex.configure(rule));
+  TEST_ASSERT_EQUAL_UINT32(0U, Reflex.activeRules());
+}
+
+void test_scheduled_gpio() {
+  BiStream stream;
+  reset_bridge_comp(stream);
+  auto& ba = TestAccessor::create(Bridge);
+  Timeline.onLost();
+
+  // Clock-sync probes are answered straight away with both MCU timestamps.
+  rpc_pb_RpcEnvelope frame = rpc_pb_RpcEnvelope_init_default;
+  frame.version = rpc::PROTOCOL_VERSION;
+  frame.command_id = rpc::to_underlying(rpc::CommandId::CMD_CLOCK_SYNC);
+  rpc_pb_ClockSync probe = rpc_pb_ClockSync_init_default;
+  probe.t1_us = 42;
+  bridge::test::set_pb_payload(frame, probe);
+  stream.tx_buf.clear();
+  ba.dispatch(frame);
+  TEST_ASSERT_TRUE(stream.tx_buf.len > 0);  // CMD_CLOCK_SYNC_RESP
+
+  frame = rpc_pb_RpcEnvelope_init_default;
+  frame.version = rpc::PROTOCOL_VERSION;
+  frame.command_id = rpc::to_underlying(rpc::CommandId::CMD_SCHEDULE_GPIO);
+  rpc_pb_ScheduleGpio op = rpc_pb_ScheduleGpio_init_default;
+  op.op = rpc_pb_ScheduleOp_SCHEDULE_OP_DIGITAL_WRITE;
+  op.pin = 13;
+  op.value = 1;
+  op.execute_at_us = static_cast<uint32_t>(::micros()) + 10000U;
+  bridge::test::set_pb_payload(frame, op);
+  ba.dispatch(frame);
+  TEST_ASSERT_FALSE(ba.isFault());
+  TEST_ASSERT_EQUAL_UINT32(1U, Timeline.pending());
+
+  // Far from its deadline process() neither spins nor fires.
+  Timeline.process();
+  TEST_ASSERT_EQUAL_UINT32(1U, Timeline.pending());
+
+  // Deadlines already behind micros() run at once and are counted as late.
+  op.execute_at_us = static_cast<uint32_t>(::micros()) - 1000U;
+  TEST_ASSERT_TRUE(Timeline.schedule(op));
+  TEST_ASSERT_EQUAL_UINT32(1U, Timeline.pending());
+  TEST_ASSERT_EQUAL_UINT16(1U, Timeline.lateCount());
+
+#if defined(ARDUINO_STUB_CUSTOM_MILLIS)
+  bridge::test::fault::advance_clock_ms(10);
+  Timeline.process();
+  TEST_ASSERT_EQUAL_UINT32(0U, Timeline.pending());
+#endif
+
+  // Beyond the lead limit, bad pins and empty masks are rejected.
+  op.execute_at_us = static_cast<uint32_t>(::micros()) +
+                     rpc::RPC_SCHEDULE_MAX_LEAD_MS * 1000UL + 1000U;
+  TEST_ASSERT_FALSE(Timeline.schedule(op));
+  op.execute_at_us = static_cast<uint32_t>(::micros()) + 10000U;
+  op.pin = bridge::config::DIGITAL_PINS;
+  TEST_ASSERT_FALSE(Timeline.schedule(op));
+  op.op = rpc_pb_ScheduleOp_SCHEDULE_OP_DIGITAL_WRITE_MASK;
+  op.mask = 0;
+  TEST_ASSERT_FALSE(Timeline.schedule(op));
+
+  Timeline.onLost();
+  TEST_ASSERT_EQUAL_UINT32(0U, Timeline.pending());
+}
+
+void test_gpio_batch() {
+  BiStream stream;
+  reset_bridge_comp(stream);
+  auto& ba = TestAccessor::create(Bridge);
+
+  rpc_pb_RpcEnvelope frame = rpc_pb_RpcEnvelope_init_default;
+  frame.version = rpc::PROTOCOL_VERSION;
+  frame.command_id = rpc::to_underlying(rpc::CommandId::CMD_GPIO_BATCH);
+  rpc_pb_GpioBatch batch = rpc_pb_GpioBatch_init_default;
+  batch.ops_count = 3;
+  batch.ops[0].op = rpc_pb_GpioOpType_GPIO_OP_PIN_MODE;
+  batch.ops[0].pin = 13;
+  batch.ops[0].value = rpc_pb_PinModeType_PIN_OUTPUT;
+  batch.ops[1].op = rpc_pb_GpioOpType_GPIO_OP_DIGITAL_WRITE;
+  batch.ops[1].pin = 13;
+  batch.ops[1].value = 1;
+  batch.ops[2].op = rpc_pb_GpioOpType_GPIO_OP_ANALOG_WRITE;
+  batch.ops[2].pin = 9;
+  batch.ops[2].value = 128;
+  bridge::test::set_pb_payload(frame, batch);
+  stream.tx_buf.clear();
+  stubUnmaskedPinWrites() = 0;
+  ba.dispatch(frame);
+  TEST_ASSERT_FALSE(ba.isFault());
+  TEST_ASSERT_TRUE(stream.tx_buf.len > 0);  // single ACK for the batch
+  // The fast writes nest their own critical sections inside the batch's:
+  // interrupts stay masked for every write and come back afterwards.
+  TEST_ASSERT_EQUAL_UINT32(0U, stubUnmaskedPinWrites());
+  TEST_ASSERT_TRUE(interruptsEnabled());
+
+  // One bad op rejects the whole batch before anything is applied.
+  batch.ops[2].pin = bridge::config::DIGITAL_PINS;
+  frame.sequence_id = 1;
+  bridge::test::set_pb_payload(frame, batch);
+  stream.tx_buf.clear();
+  ba.dispatch(frame);
+  TEST_ASSERT_FALSE(ba.isFault());
+  TEST_ASSERT_TRUE(stream.tx_buf.len > 0);  // STATUS_ERROR
+}
+
+void test_waveform_playback() {
+  BiStream stream;
+  reset_bridge_comp(stream);
+  auto& ba = TestAccessor::create(Bridge);
+  Waveform.onLost();
+
+  rpc_pb_RpcEnvelope frame = rpc_pb_RpcEnvelope_init_default;
+  frame.version = rpc::PROTOCOL_VERSION;
+  frame.command_id = rpc::to_underlying(rpc::CommandId::CMD_WAVEFORM_LOAD);
+  rpc_pb_WaveformLoad chunk = rpc_pb_WaveformLoad_init_default;
+  chunk.steps_count = 2;
+  chunk.steps[0].pin = 13;
+  chunk.steps[0].value = 1;
+  chunk.steps[0].delay_us = 1000;
+  chunk.steps[1].pin = 13;
+  chunk.steps[1].value = 0;
+  chunk.steps[1].delay_us = 1000;
+  bridge::test::set_pb_payload(frame, chunk);
+  ba.dispatch(frame);
+  TEST_ASSERT_FALSE(ba.isFault());
+  TEST_ASSERT_EQUAL_UINT32(2U, Waveform.length());
+
+  // Chunks must be contiguous; a gap leaves the program untouched.
+  chunk.offset = 5;
+  TEST_ASSERT_FALSE(Waveform.load(chunk));
+  TEST_ASSERT_EQUAL_UINT32(2U, Waveform.length());
+
+  // A duty table expands to one PWM step per byte.
+  chunk = rpc_pb_WaveformLoad_init_default;
+  chunk.offset = 2;
+  chunk.duty_pin = 9;
+  chunk.duty_period_us = 2000;
+  chunk.duty.size = 3;
+  chunk.duty.bytes[0] = 0;
+  chunk.duty.bytes[1] = 128;
+  chunk.duty.bytes[2] = 255;
+  TEST_ASSERT_TRUE(Waveform.load(chunk));
+  TEST_ASSERT_EQUAL_UINT32(5U, Waveform.length());
+
+  // Steps shorter than the minimum and bad pins are refused.
+  chunk.offset = 5;
+  chunk.duty_period_us = bridge::config::WAVEFORM_MIN_STEP_US - 1U;
+  TEST_ASSERT_FALSE(Waveform.load(chunk));
+  chunk.duty_period_us = 2000;
+  chunk.duty_pin = bridge::config::DIGITAL_PINS;
+  TEST_ASSERT_FALSE(Waveform.load(chunk));
+  TEST_ASSERT_EQUAL_UINT32(5U, Waveform.length());
+
+  frame = rpc_pb_RpcEnvelope_init_default;
+  frame.version = rpc::PROTOCOL_VERSION;
+  frame.sequence_id = 1;
+  frame.command_id = rpc::to_underlying(rpc::CommandId::CMD_WAVEFORM_START);
+  rpc_pb_WaveformStart start = rpc_pb_WaveformStart_init_default;
+  start.loops = 1;
+  bridge::test::set_pb_payload(frame, start);
+  ba.dispatch(frame);
+  TEST_ASSERT_FALSE(ba.isFault());
+  TEST_ASSERT_TRUE(Waveform.playing());
+
+  // The first step is applied at once; the rest wait for their deadlines.
+  Waveform.process();
+  TEST_ASSERT_TRUE(Waveform.playing());
+
+#if defined(ARDUINO_STUB_CUSTOM_MILLIS)
+  bridge::test::fault::advance_clock_ms(1);
+  Waveform.process();
+  TEST_ASSERT_TRUE(Waveform.playing());
+  // A single loop ends after the last step and leaves the outputs as-is.
+  bridge::test::fault::advance_clock_ms(20);
+  Waveform.process();
+  TEST_ASSERT_FALSE(Waveform.playing());
+  TEST_ASSERT_EQUAL_UINT32(0U, Waveform.lateCount());
+#endif
+
+  // loops = 0 plays until CMD_WAVEFORM_STOP.
+  start.loops = 0;
+  TEST_ASSERT_TRUE(Waveform.start(start));
+  frame = rpc_pb_RpcEnvelope_init_default;
+  frame.version = rpc::PROTOCOL_VERSION;
+  frame.sequence_id = 2;
+  frame.command_id = rpc::to_underlying(rpc::CommandId::CMD_WAVEFORM_STOP);
+  ba.dispatch(frame);
+  TEST_ASSERT_FALSE(Waveform.playing());
+
+  Waveform.onLost();
+  TEST_ASSERT_EQUAL_UINT32(0U, Waveform.length());
+  TEST_ASSERT_FALSE(Waveform.start(start));
+}
+
+void test_memory_profile() {
+  BiStream stream;
+  reset_bridge_comp(stream);
+  auto& ba = TestAccessor::create(Bridge);
+
+  // Queue peaks are high-water marks: they survive the buffer draining.
+  const uint8_t text[] = {'a', 'b', 'c'};
+  Console.begin();
+  Console.write(text, sizeof(text));
+  TEST_ASSERT_TRUE(Console.txPeak() >= sizeof(text));
+  Console.process();
+  TEST_ASSERT_TRUE(Console.txPeak() >= sizeof(text));
+
+  rpc_pb_RpcEnvelope frame = rpc_pb_RpcEnvelope_init_default;
+  frame.version = rpc::PROTOCOL_VERSION;
+  frame.command_id =
+      rpc::to_underlying(rpc::CommandId::CMD_GET_MEMORY_PROFILE);
+  stream.tx_buf.clear();
+  ba.dispatch(frame);
+  TEST_ASSERT_FALSE(ba.isFault());
+  TEST_ASSERT_TRUE(stream.tx_buf.len > 0);  // CMD_GET_MEMORY_PROFILE_RESP
+
+  // Without linker symbols or a painted stack the host reports zeros
+  // instead of guessing.
+  uint16_t peak = 1, headroom = 1;
+  bridge::hal::stackUsage(peak, headroom);
+  TEST_ASSERT_EQUAL_UINT16(0U, peak);
+  TEST_ASSERT_EQUAL_UINT16(0U, headroom);
+}
+
+void test_loop_profiler() {
+#if BRIDGE_ENABLE_LOOP_PROFILER
+  // Bucket N holds [2^N, 2^(N+1)) us; the last one also takes the overflow.
+  TEST_ASSERT_EQUAL_UINT8(0U, LoopProfilerClass::bucketOf(0));
+  TEST_ASSERT_EQUAL_UINT8(0U, LoopProfilerClass::bucketOf(1));
+  TEST_ASSERT_EQUAL_UINT8(1U, LoopProfilerClass::bucketOf(2));
+  TEST_ASSERT_EQUAL_UINT8(1U, LoopProfilerClass::bucketOf(3));
+  TEST_ASSERT_EQUAL_UINT8(10U, LoopProfilerClass::bucketOf(1024));
+  TEST_ASSERT_EQUAL_UINT8(LoopProfilerClass::kBuckets - 1U,
+                          LoopProfilerClass::bucketOf(UINT32_MAX));
+
+  BiStream stream;
+  reset_bridge_comp(stream);
+  auto& ba = TestAccessor::create(Bridge);
+  for (uint8_t p = 0; p < LoopProfilerClass::kPhases; ++p) {
+    LoopProfiler.reset(static_cast<rpc_pb_LoopPhase>(p));
+  }
+
+  for (int i = 0; i < 3; ++i) Bridge.process();
+  rpc_pb_LoopProfile prof = rpc_pb_LoopProfile_init_default;
+  TEST_ASSERT_TRUE(
+      LoopProfiler.snapshot(rpc_pb_LoopPhase_LOOP_PHASE_SERIAL, prof));
+  TEST_ASSERT_EQUAL_UINT32(3U, prof.samples);
+  TEST_ASSERT_EQUAL(LoopProfilerClass::kBuckets, prof.buckets_count);
+  uint32_t total = 0;
+  for (pb_size_t b = 0; b < prof.buckets_count; ++b) total += prof.buckets[b];
+  TEST_ASSERT_EQUAL_UINT32(3U, total);
+
+  LoopProfiler.record(rpc_pb_LoopPhase_LOOP_PHASE_TOTAL, 5000);
+  TEST_ASSERT_TRUE(
+      LoopProfiler.snapshot(rpc_pb_LoopPhase_LOOP_PHASE_TOTAL, prof));
+  TEST_ASSERT_EQUAL_UINT32(4U, prof.samples);
+  TEST_ASSERT_EQUAL_UINT32(5000U, prof.max_us);
+  TEST_ASSERT_EQUAL_UINT32(1U, prof.buckets[12]);
+
+  // Read-and-clear over the wire; unknown phases are refused.
+  rpc_pb_RpcEnvelope frame = rpc_pb_RpcEnvelope_init_default;
+  frame.version = rpc::PROTOCOL_VERSION;
+  frame.command_id = rpc::to_underlying(rpc::CommandId::CMD_GET_LOOP_PROFILE);
+  rpc_pb_LoopProfileQuery query = rpc_pb_LoopProfileQuery_init_default;
+  query.phase = rpc_pb_LoopPhase_LOOP_PHASE_TOTAL;
+  query.reset = true;
+  bridge::test::set_pb_payload(frame, query);
+  stream.tx_buf.clear();
+  ba.dispatch(frame);
+  TEST_ASSERT_FALSE(ba.isFault());
+  TEST_ASSERT_TRUE(stream.tx_buf.len > 0);  // CMD_GET_LOOP_PROFILE_RESP
+  LoopProfiler.snapshot(rpc_pb_LoopPhase_LOOP_PHASE_TOTAL, prof);
+  TEST_ASSERT_EQUAL_UINT32(0U, prof.samples);
+  TEST_ASSERT_EQUAL_UINT32(0U, prof.max_us);
+
+  TEST_ASSERT_FALSE(LoopProfiler.snapshot(
+      static_cast<rpc_pb_LoopPhase>(LoopProfilerClass::kPhases), prof));
+#endif
+}
+
+void test_i2c_service() {
+#if BRIDGE_ENABLE_I2C
+  BiStream stream;
+  reset_bridge_comp(stream);
+  auto& ba = TestAccessor::create(Bridge);
+  const uint8_t dev = TwoWire::kDeviceAddress;
+  for (size_t i = 0; i < sizeof(Wire.registers); ++i) {
+    Wire.registers[i] = static_cast<uint8_t>(i);
+  }
+
+  uint8_t in[4] = {};
+  TEST_ASSERT_EQUAL(rpc_pb_I2cStatus_I2C_BUS_ERROR,
+                    I2CService.transfer(dev, {}, etl::span<uint8_t>(in), false));
+
+  rpc_pb_RpcEnvelope frame = rpc_pb_RpcEnvelope_init_default;
+  frame.version = rpc::PROTOCOL_VERSION;
+  frame.command_id = rpc::to_underlying(rpc::CommandId::CMD_I2C_BEGIN);
+  rpc_pb_I2cConfig cfg = rpc_pb_I2cConfig_init_default;
+  cfg.frequency = 400000;
+  bridge::test::set_pb_payload(frame, cfg);
+  ba.dispatch(frame);
+  TEST_ASSERT_TRUE(I2CService.running());
+  TEST_ASSERT_EQUAL_UINT32(400000U, Wire.clock());
+
+  // Write then read with a repeated start: register 0x10 onwards.
+  const uint8_t reg = 0x10;
+  TEST_ASSERT_EQUAL(rpc_pb_I2cStatus_I2C_OK,
+                    I2CService.transfer(dev, etl::span<const uint8_t>(&reg, 1),
+                                        etl::span<uint8_t>(in), false));
+  TEST_ASSERT_EQUAL_UINT8(0x10, in[0]);
+  TEST_ASSERT_EQUAL_UINT8(0x13, in[3]);
+  // A plain read continues from the device's pointer.
+  TEST_ASSERT_EQUAL(rpc_pb_I2cStatus_I2C_OK,
+                    I2CService.transfer(dev, {}, etl::span<uint8_t>(in, 1),
+                                        true));
+  TEST_ASSERT_EQUAL_UINT8(0x14, in[0]);
+  TEST_ASSERT_EQUAL(rpc_pb_I2cStatus_I2C_NACK_ADDRESS,
+                    I2CService.transfer(0x21, etl::span<const uint8_t>(&reg, 1),
+                                        etl::span<uint8_t>(in), false));
+  uint8_t big[rpc::RPC_I2C_TRANSFER_MAX_BYTES + 1] = {};
+  TEST_ASSERT_EQUAL(rpc_pb_I2cStatus_I2C_DATA_TOO_LONG,
+                    I2CService.transfer(dev, {}, etl::span<uint8_t>(big),
+                                        false));
+
+  // Batch: two register blocks in one response; stops at the first error.
+  rpc_pb_I2cReadRegisters batch = rpc_pb_I2cReadRegisters_init_default;
+  batch.address = dev;
+  batch.reads_count = 2;
+  batch.reads[0].reg = 0x20;
+  batch.reads[0].len = 2;
+  batch.reads[1].reg = 0x40;
+  batch.reads[1].len = 3;
+  rpc_pb_I2cReadRegistersResponse resp =
+      rpc_pb_I2cReadRegistersResponse_init_default;
+  I2CService.readRegisters(batch, resp);
+  TEST_ASSERT_EQUAL(rpc_pb_I2cStatus_I2C_OK, resp.status);
+  TEST_ASSERT_EQUAL_UINT32(2U, resp.completed);
+  TEST_ASSERT_EQUAL(5, resp.data.size);
+  TEST_ASSERT_EQUAL_UINT8(0x21, resp.data.bytes[1]);
+  TEST_ASSERT_EQUAL_UINT8(0x40, resp.data.bytes[2]);
+
+  batch.reads[1].len = rpc::RPC_I2C_BATCH_MAX_BYTES;
+  I2CService.readRegisters(batch, resp);
+  TEST_ASSERT_EQUAL(rpc_pb_I2cStatus_I2C_DATA_TOO_LONG, resp.status);
+  TEST_ASSERT_EQUAL_UINT32(1U, resp.completed);
+
+  frame = rpc_pb_RpcEnvelope_init_default;
+  frame.version = rpc::PROTOCOL_VERSION;
+  frame.command_id =
+      rpc::to_underlying(rpc::CommandId::CMD_I2C_READ_REGISTERS);
+  batch.reads_count = 1;
+  bridge::test::set_pb_payload(frame, batch);
+  stream.tx_buf.clear();
+  ba.dispatch(frame);
+  TEST_ASSERT_FALSE(ba.isFault());
+  TEST_ASSERT_TRUE(stream.tx_buf.len > 0);  // CMD_I2C_READ_REGISTERS_RESP
+
+  // Losing the link releases the bus.
+  I2CService.onLost();
+  TEST_ASSERT_FALSE(I2CService.running());
+  TEST_ASSERT_FALSE(Wire.running());
+#endif
+}
+
+#if BRIDGE_ENABLE_EEPROM
+extern uint32_t g_host_nv_bytes_written;
+#endif
+
+void test_kv_store() {
+#if BRIDGE_ENABLE_EEPROM
+  // Blank EEPROM: Bridge.begin() formats it.
+  ::remove("/tmp/mcubridge-host-eeprom.bin");
+  BiStream stream;
+  reset_bridge_comp(stream);
+  TEST_ASSERT_TRUE(KVStore.mounted());
+  TEST_ASSERT_EQUAL(0, KVStore.count());
+
+  const uint8_t v1[] = {1, 2, 3};
+  uint8_t out[KVStoreClass::kMaxValue] = {};
+  size_t len = 0;
+  TEST_ASSERT_TRUE(KVStore.put("speed", v1));
+  TEST_ASSERT_TRUE(KVStore.get("speed", out, len));
+  TEST_ASSERT_EQUAL(3, len);
+  TEST_ASSERT_EQUAL_UINT8(3, out[2]);
+  TEST_ASSERT_FALSE(KVStore.get("nope", out, len));
+
+  // An identical value is not written again.
+  const uint32_t written = g_host_nv_bytes_written;
+  TEST_ASSERT_TRUE(KVStore.put("speed", v1));
+  TEST_ASSERT_EQUAL_UINT32(written, g_host_nv_bytes_written);
+
+  uint8_t too_big[KVStoreClass::kMaxValue + 1] = {};
+  TEST_ASSERT_FALSE(KVStore.put("speed", too_big));
+  TEST_ASSERT_FALSE(KVStore.put("", v1));
+
+  const uint8_t v2[] = {9};
+  TEST_ASSERT_TRUE(KVStore.put("speed", v2));
+  TEST_ASSERT_TRUE(KVStore.put("mode", v1));
+  TEST_ASSERT_TRUE(KVStore.remove("mode"));
+
+  // After a reset the pairs are there before the link is.
+  reset_bridge_comp(stream);
+  TEST_ASSERT_EQUAL(1, KVStore.count());
+  TEST_ASSERT_FALSE(KVStore.contains("mode"));
+  TEST_ASSERT_TRUE(KVStore.get("speed", out, len));
+  TEST_ASSERT_EQUAL(1, len);
+  TEST_ASSERT_EQUAL_UINT8(9, out[0]);
+
+  // Filling the bank compacts the live pairs into the other one.
+  const uint16_t generation = KVStore.generation();
+  uint8_t blob[KVStoreClass::kMaxValue] = {};
+  for (uint8_t i = 0; i < 20; ++i) {
+    blob[0] = i;
+    TEST_ASSERT_TRUE(KVStore.put("blob", blob));
+  }
+  TEST_ASSERT_NOT_EQUAL(generation, KVStore.generation());
+  TEST_ASSERT_TRUE(KVStore.begin());
+  TEST_ASSERT_EQUAL(2, KVStore.count());
+  TEST_ASSERT_TRUE(KVStore.get("blob", out, len));
+  TEST_ASSERT_EQUAL_UINT8(19, out[0]);
+  TEST_ASSERT_TRUE(KVStore.get("speed", out, len));
+  TEST_ASSERT_EQUAL_UINT8(9, out[0]);
+
+  // Mirrored puts also go to the Linux DataStore.
+  stream.tx_buf.clear();
+  TEST_ASSERT_TRUE(KVStore.put("speed", v2, true));
+  TEST_ASSERT_TRUE(stream.tx_buf.len > 0);
+
+  // Garbage in both bank headers: start over with an empty store.
+  const uint8_t junk[4] = {0, 0, 0, 0};
+  TEST_ASSERT_TRUE(bridge::hal::nvWrite(0, junk).has_value());
+  TEST_ASSERT_TRUE(
+      bridge::hal::nvWrite(bridge::hal::nvSize() / 2U, junk).has_value());
+  TEST_ASSERT_TRUE(KVStore.begin());
+  TEST_ASSERT_EQUAL(0, KVStore.count());
+#endif
+}
+
+void test_link_stats() {
+  using C = BridgeClass::LinkCounter;
+  BiStream stream;
+  reset_bridge_comp(stream);
+  auto& ba = TestAccessor::create(Bridge);
+
+  // Counters saturate instead of wrapping back to small values.
+  Bridge.countLink(C::RX_DUPLICATES, UINT16_MAX);
+  Bridge.countLink(C::RX_DUPLICATES, 5);
+  TEST_ASSERT_EQUAL_UINT16(UINT16_MAX, Bridge.linkCount(C::RX_DUPLICATES));
+
+  // Console bytes that do not fit the RX buffer are counted, not lost
+  // silently.
+  const uint16_t overflow = Bridge.linkCount(C::CONSOLE_RX_OVERFLOW);
+  Console.begin();
+  rpc::payload::ConsoleWrite cw = {};
+  cw.data.size = sizeof(cw.data.bytes);
+  for (size_t i = 0;
+       i <= bridge::config::CONSOLE_RX_BUFFER_SIZE / sizeof(cw.data.bytes);
+       ++i) {
+    Console._push(cw);
+  }
+  TEST_ASSERT_TRUE(Bridge.linkCount(C::CONSOLE_RX_OVERFLOW) > overflow);
+
+  rpc_pb_RpcEnvelope frame = rpc_pb_RpcEnvelope_init_default;
+  frame.version = rpc::PROTOCOL_VERSION;
+  frame.command_id = rpc::to_underlying(rpc::CommandId::CMD_GET_LINK_STATS);
+  rpc_pb_LinkStatsQuery query = rpc_pb_LinkStatsQuery_init_default;
+  bridge::test::set_pb_payload(frame, query);
+  stream.tx_buf.clear();
+  const uint16_t tx_frames = Bridge.linkCount(C::TX_FRAMES);
+  ba.dispatch(frame);
+  TEST_ASSERT_FALSE(ba.isFault());
+  TEST_ASSERT_TRUE(stream.tx_buf.len > 0);  // CMD_GET_LINK_STATS_RESP
+  TEST_ASSERT_TRUE(Bridge.linkCount(C::TX_FRAMES) > tx_frames);
+  TEST_ASSERT_EQUAL_UINT16(UINT16_MAX, Bridge.linkCount(C::RX_DUPLICATES));
+
+  // Read-and-clear: the daemon owns the running totals.
+  query.reset = true;
+  bridge::test::set_pb_payload(frame, query);
+  ba.dispatch(frame);
+  TEST_ASSERT_EQUAL_UINT16(0U, Bridge.linkCount(C::RX_DUPLICATES));
+  TEST_ASSERT_EQUAL_UINT16(0U, Bridge.linkCount(C::CONSOLE_RX_OVERFLOW));
+  TEST_ASSERT_EQUAL_UINT16(0U, Bridge.linkCount(C::TX_FRAMES));
+}
+
+void test_frame_trace() {
+#if BRIDGE_ENABLE_FRAME_TRACE
+  BiStream stream;
+  FrameTrace.clear();
+  reset_bridge_comp(stream);
+  auto& ba = TestAccessor::create(Bridge);
+  rpc_pb_FrameTrace trace = rpc_pb_FrameTrace_init_default;
+
+  // begin() leaves a boot marker first.
+  FrameTrace.snapshot(0, trace);
+  TEST_ASSERT_EQUAL_UINT32(0U, trace.start);
+  TEST_ASSERT_TRUE(trace.events.size >= FrameTraceClass::kRecordSize);
+  TEST_ASSERT_EQUAL_UINT8(
+      (rpc_pb_FrameTraceDirection_FRAME_TRACE_EVENT << 6) |
+          rpc_pb_FrameTraceResult_FRAME_TRACE_BOOT,
+      trace.events.bytes[9]);
+
+  // A request and its direct response: RX then TX, read over the wire.
+  const uint32_t before = FrameTrace.end();
+  rpc_pb_RpcEnvelope frame = rpc_pb_RpcEnvelope_init_default;
+  frame.version = rpc::PROTOCOL_VERSION;
+  frame.sequence_id = 7;
+  frame.command_id = rpc::to_underlying(rpc::CommandId::CMD_GET_FRAME_TRACE);
+  rpc_pb_FrameTraceQuery query = rpc_pb_FrameTraceQuery_init_default;
+  query.start = before;
+  bridge::test::set_pb_payload(frame, query);
+  stream.tx_buf.clear();
+  ba.dispatch(frame);
+  TEST_ASSERT_TRUE(stream.tx_buf.len > 0);  // CMD_GET_FRAME_TRACE_RESP
+  TEST_ASSERT_EQUAL_UINT32(before + 2U, FrameTrace.end());
+
+  FrameTrace.snapshot(before, trace);
+  TEST_ASSERT_EQUAL_UINT32(before, trace.start);
+  TEST_ASSERT_EQUAL(2U * FrameTraceClass::kRecordSize, trace.events.size);
+  const uint8_t* rx = trace.events.bytes;
+  TEST_ASSERT_EQUAL_UINT16(
+      rpc::to_underlying(rpc::CommandId::CMD_GET_FRAME_TRACE),
+      rx[4] | (rx[5] << 8));
+  TEST_ASSERT_EQUAL_UINT16(7U, rx[6] | (rx[7] << 8));
+  TEST_ASSERT_EQUAL_UINT8(rpc_pb_FrameTraceResult_FRAME_TRACE_OK, rx[9]);
+  const uint8_t* tx = rx + FrameTraceClass::kRecordSize;
+  TEST_ASSERT_EQUAL_UINT16(
+      rpc::to_underlying(rpc::CommandId::CMD_GET_FRAME_TRACE_RESP),
+      tx[4] | (tx[5] << 8));
+  TEST_ASSERT_EQUAL_UINT8(rpc_pb_FrameTraceDirection_FRAME_TRACE_TX,
+                          tx[9] >> 6);
+
+  // A reset keeps the ring: the new boot marker goes after the old events.
+  Bridge.enterSafeState();
+  FrameTrace.begin();
+  TEST_ASSERT_EQUAL_UINT32(before + 4U, FrameTrace.end());
+
+  // Once the ring wraps, reads start at the oldest event still kept.
+  for (uint8_t i = 0; i < FrameTraceClass::kDepth; ++i) {
+    FrameTrace.record(rpc_pb_FrameTraceDirection_FRAME_TRACE_RX, i, i, 0,
+                      rpc_pb_FrameTraceResult_FRAME_TRACE_OK, 0);
+  }
+  FrameTrace.snapshot(0, trace);
+  TEST_ASSERT_EQUAL_UINT32(FrameTrace.end() - FrameTraceClass::kDepth,
+                           trace.start);
+  TEST_ASSERT_EQUAL(
+      rpc::RPC_FRAME_TRACE_CHUNK_RECORDS * FrameTraceClass::kRecordSize,
+      trace.events.size);
+#endif
+}
+
+void test_frame_timestamps() {
+  BiStream stream;
+  reset_bridge_comp(stream);
+  auto& ba = TestAccessor::create(Bridge);
+
+  rpc_pb_RpcEnvelope frame = rpc_pb_RpcEnvelope_init_default;
+  frame.version = rpc::PROTOCOL_VERSION;
+  frame.sequence_id = 11;
+  frame.command_id = rpc::to_underlying(rpc::CommandId::CMD_GET_LINK_STATS);
+  rpc_pb_LinkStatsQuery query = rpc_pb_LinkStatsQuery_init_default;
+  bridge::test::set_pb_payload(frame, query);
+
+  // Until the daemon stamps a frame, replies stay unstamped.
+  stream.tx_buf.clear();
+  ba.dispatch(frame);
+  rpc_pb_RpcEnvelope reply = rpc_pb_RpcEnvelope_init_default;
+  size_t cursor = 0;
+  TEST_ASSERT_TRUE(extract_next_valid_frame(stream.tx_buf, cursor, reply));
+  TEST_ASSERT_EQUAL_UINT32(0U, reply.sent_us);
+  TEST_ASSERT_EQUAL_UINT32(0U, reply.echo_us);
+
+  frame.sequence_id = 12;
+  frame.sent_us = 0xCAFE0001U;
+  stream.tx_buf.clear();
+  ba.dispatch(frame);
+  cursor = 0;
+  TEST_ASSERT_TRUE(extract_next_valid_frame(stream.tx_buf, cursor, reply));
+  TEST_ASSERT_EQUAL_UINT32(12U, reply.sequence_id);
+#if BRIDGE_ENABLE_FRAME_TIMESTAMPS
+  TEST_ASSERT_EQUAL_UINT32(0xCAFE0001U, reply.echo_us);
+  TEST_ASSERT_TRUE(reply.sent_us != 0U);
+#endif
+
+  // Frames that answer nothing carry the MCU clock but no echo.
+  stream.tx_buf.clear();
+  TEST_ASSERT_TRUE(Bridge.sendFrame(rpc::CommandId::CMD_XOFF));
+  cursor = 0;
+  TEST_ASSERT_TRUE(extract_next_valid_frame(stream.tx_buf, cursor, reply));
+  TEST_ASSERT_EQUAL_UINT32(0U, reply.echo_us);
+
+  // A link reset waits for the next daemon to stamp its frames again.
+  rpc_pb_RpcEnvelope reset = rpc_pb_RpcEnvelope_init_default;
+  reset.version = rpc::PROTOCOL_VERSION;
+  reset.sequence_id = 13;
+  reset.command_id = rpc::to_underlying(rpc::CommandId::CMD_LINK_RESET);
+  stream.tx_buf.clear();
+  ba.dispatch(reset);
+  cursor = 0;
+  TEST_ASSERT_TRUE(extract_next_valid_frame(stream.tx_buf, cursor, reply));
+  TEST_ASSERT_EQUAL_UINT32(0U, reply.sent_us);
+}
+
+void test_baudrate_calibration() {
+  BiStream stream;
+  reset_bridge_comp(stream);
+  auto& ba = TestAccessor::create(Bridge);
+  TEST_ASSERT_EQUAL_UINT32(rpc::RPC_DEFAULT_BAUDRATE, ba.getBaudrate());
+
+  rpc_pb_RpcEnvelope frame = rpc_pb_RpcEnvelope_init_default;
+  frame.version = rpc::PROTOCOL_VERSION;
+  frame.sequence_id = 21;
+  frame.command_id = rpc::to_underlying(rpc::CommandId::CMD_SET_BAUDRATE);
+  rpc_pb_SetBaudratePacket set = rpc_pb_SetBaudratePacket_init_default;
+  set.baudrate = 230400;
+  set.confirm_timeout_ms = 200;
+  bridge::test::set_pb_payload(frame, set);
+
+  // The reply goes out at the old rate, before the switch.
+  stream.tx_buf.clear();
+  ba.dispatch(frame);
+  rpc_pb_RpcEnvelope reply = rpc_pb_RpcEnvelope_init_default;
+  size_t cursor = 0;
+  bool answered = false;
+  while (extract_next_valid_frame(stream.tx_buf, cursor, reply)) {
+    answered |= reply.command_id ==
+                rpc::to_underlying(rpc::CommandId::CMD_SET_BAUDRATE_RESP);
+  }
+  TEST_ASSERT_TRUE(answered);
+  TEST_ASSERT_EQUAL_UINT32(rpc::RPC_DEFAULT_BAUDRATE, ba.getBaudrate());
+
+  // Nothing arrived at the trial rate: go back.
+  ba.onBaudrateChange();
+  TEST_ASSERT_EQUAL_UINT32(230400U, ba.getBaudrate());
+  ba.onBaudrateConfirmTimeout();
+  TEST_ASSERT_EQUAL_UINT32(rpc::RPC_DEFAULT_BAUDRATE, ba.getBaudrate());
+
+  // A valid frame at the trial rate keeps it.
+  frame.sequence_id = 22;
+  ba.dispatch(frame);
+  ba.onBaudrateChange();
+  rpc_pb_RpcEnvelope probe = rpc_pb_RpcEnvelope_init_default;
+  probe.version = rpc::PROTOCOL_VERSION;
+  probe.sequence_id = 23;
+  probe.command_id = rpc::to_underlying(rpc::CommandId::CMD_LINK_PROBE);
+  rpc_pb_LinkProbe pattern = rpc_pb_LinkProbe_init_default;
+  pattern.pattern.size = 4;
+  pattern.pattern.bytes[0] = 0x55;
+  pattern.pattern.bytes[3] = 0xAA;
+  bridge::test::set_pb_payload(probe, pattern);
+  // Plaintext keeps the frame readable here; AEAD is covered elsewhere.
+  ba.setSharedSecret(etl::span<const uint8_t>());
+  etl::array<uint8_t, 256> raw;
+  const size_t raw_len = rpc::serialize_frame(probe, raw);
+  stream.tx_buf.clear();
+  ba.invokePacketReceived(etl::span<const uint8_t>(raw.data(), raw_len));
+  ba.onBaudrateConfirmTimeout();
+  TEST_ASSERT_EQUAL_UINT32(230400U, ba.getBaudrate());
+
+  // The probe comes back unchanged.
+  cursor = 0;
+  TEST_ASSERT_TRUE(extract_next_valid_frame(stream.tx_buf, cursor, reply));
+  TEST_ASSERT_EQUAL_UINT16(
+      rpc::to_underlying(rpc::CommandId::CMD_LINK_PROBE_RESP),
+      reply.command_id);
+  TEST_ASSERT_EQUAL(rpc::Payload::get_tag<rpc_pb_LinkProbe>(),
+                    reply.which_payload_type);
+  const rpc_pb_LinkProbe& echoed = rpc::Payload::get<rpc_pb_LinkProbe>(reply);
+  TEST_ASSERT_EQUAL(4, echoed.pattern.size);
+  TEST_ASSERT_EQUAL_UINT8(0xAA, echoed.pattern.bytes[3]);
+}
+
+namespace {
+struct ProbeService {
+  uint8_t polls = 0;
+  uint8_t lost = 0;
+  uint16_t claimed = 0;
+  void process() { ++polls; }
+  void onLost() { ++lost; }
+  bool onCommand(const bridge::router::CommandContext& ctx) {
+    if (ctx.raw_command != 999U) return false;
+    claimed = ctx.raw_command;
+    return true;
+  }
+};
+// Only process(): the other hooks must skip it.
+struct PollOnlyService {
+  uint8_t polls = 0;
+  void process() { ++polls; }
+};
+ProbeService g_probe_service;
+PollOnlyService g_poll_only_service;
+}  // namespace
+
+void test_user_services() {
+  BiStream stream;
+  reset_bridge_comp(stream);
+  auto& ba = TestAccessor::create(Bridge);
+  Bridge.useServices<g_probe_service, g_poll_only_service>();
+
+  Bridge.process();
+  TEST_ASSERT_EQUAL_UINT8(1, g_probe_service.polls);
+  TEST_ASSERT_EQUAL_UINT8(1, g_poll_only_service.polls);
+
+  // A command missing from the dispatch table goes to the services first...
+  rpc_pb_RpcEnvelope frame = rpc_pb_RpcEnvelope_init_default;
+  frame.version = rpc::PROTOCOL_VERSION;
+  frame.command_id = 999;
+  frame.sequence_id = 1;
+  stream.tx_buf.clear();
+  ba.dispatch(frame);
+  TEST_ASSERT_EQUAL_UINT16(999, g_probe_service.claimed);
+  TEST_ASSERT_EQUAL(0, stream.tx_buf.len);
+
+  // ...and one no service claims still gets STATUS_ERROR.
+  frame.command_id = 998;
+  frame.sequence_id = 2;
+  ba.dispatch(frame);
+  TEST_ASSERT_TRUE(stream.tx_buf.len > 0);
+
+  Bridge.enterSafeState();
+  TEST_ASSERT_EQUAL_UINT8(1, g_probe_service.lost);
+}
+
+namespace {
+struct RequestLog {
+  uint8_t calls = 0;
+  bridge::RequestStatus status = bridge::RequestStatus::OK;
+  uint32_t pid = 0;
+};
+RequestLog g_request_log[4];
+// The handler is just the index of its log: any delegate-sized type works.
+void log_request(const uint8_t& slot, bridge::RequestStatus status,
+                 const rpc_pb_ProcessRunAsyncResponse* msg) {
+  RequestLog& log = g_request_log[slot];
+  ++log.calls;
+  log.status = status;
+  log.pid = msg != nullptr ? msg->pid : 0U;
+}
+uint16_t send_logged_request(uint8_t slot, uint32_t timeout_ms) {
+  rpc_pb_ProcessRunAsync run = rpc_pb_ProcessRunAsync_init_default;
+  TEST_ASSERT_TRUE(Bridge.request<&log_request>(
+      rpc::CommandId::CMD_PROCESS_RUN_ASYNC, run,
+      rpc::CommandId::CMD_PROCESS_RUN_ASYNC_RESP, slot, timeout_ms));
+  return TestAccessor::create(Bridge).lastRequestSequence();
+}
+rpc_pb_RpcEnvelope run_async_resp(uint16_t seq, uint32_t pid) {
+  rpc_pb_RpcEnvelope frame = rpc_pb_RpcEnvelope_init_default;
+  frame.version = rpc::PROTOCOL_VERSION;
+  frame.command_id =
+      rpc::to_underlying(rpc::CommandId::CMD_PROCESS_RUN_ASYNC_RESP);
+  frame.sequence_id = seq;
+  rpc_pb_ProcessRunAsyncResponse resp =
+      rpc_pb_ProcessRunAsyncResponse_init_default;
+  resp.pid = pid;
+  bridge::test::set_pb_payload(frame, resp);
+  return frame;
+}
+}  // namespace
+
+void test_request_table() {
+  BiStream stream;
+  reset_bridge_comp(stream);
+  auto& ba = TestAccessor::create(Bridge);
+  ba.setSynchronized();
+  for (RequestLog& log : g_request_log) log = RequestLog();
+
+  const uint16_t first = send_logged_request(0, 1000);
+  const uint16_t second = send_logged_request(1, 1000);
+  TEST_ASSERT_NOT_EQUAL(first, second);
+  TEST_ASSERT_EQUAL(2, ba.pendingRequests());
+
+  // Answers are matched by sequence, not arrival order, and one whose
+  // sequence matches the last Linux command is not taken for a duplicate.
+  rpc_pb_RpcEnvelope version = rpc_pb_RpcEnvelope_init_default;
+  version.version = rpc::PROTOCOL_VERSION;
+  version.command_id = rpc::to_underlying(rpc::CommandId::CMD_GET_VERSION);
+  version.sequence_id = second;
+  ba.dispatch(version);
+  ba.dispatch(run_async_resp(second, 22));
+  TEST_ASSERT_EQUAL_UINT8(0, g_request_log[0].calls);
+  TEST_ASSERT_EQUAL_UINT8(1, g_request_log[1].calls);
+  TEST_ASSERT_EQUAL_UINT32(22, g_request_log[1].pid);
+  ba.dispatch(run_async_resp(first, 11));
+  TEST_ASSERT_EQUAL_UINT8(1, g_request_log[0].calls);
+  TEST_ASSERT_EQUAL(bridge::RequestStatus::OK, g_request_log[0].status);
+  TEST_ASSERT_EQUAL_UINT32(11, g_request_log[0].pid);
+  // A late repeat finds nothing to complete.
+  ba.dispatch(run_async_resp(first, 11));
+  TEST_ASSERT_EQUAL_UINT8(1, g_request_log[0].calls);
+  TEST_ASSERT_EQUAL(0, ba.pendingRequests());
+
+  // No answer before the deadline.
+  send_logged_request(2, 0);
+  ba.onRequestTimeout();
+  TEST_ASSERT_EQUAL_UINT8(1, g_request_log[2].calls);
+  TEST_ASSERT_EQUAL(bridge::RequestStatus::TIMEOUT, g_request_log[2].status);
+
+  // Linux refuses it.
+  rpc_pb_RpcEnvelope error = rpc_pb_RpcEnvelope_init_default;
+  error.version = rpc::PROTOCOL_VERSION;
+  error.command_id = rpc::to_underlying(rpc::StatusCode::STATUS_ERROR);
+  error.sequence_id = send_logged_request(3, 1000);
+  ba.dispatch(error);
+  TEST_ASSERT_EQUAL_UINT8(1, g_request_log[3].calls);
+  TEST_ASSERT_EQUAL(bridge::RequestStatus::REJECTED, g_request_log[3].status);
+
+  // The link drops with requests open.
+  send_logged_request(0, 1000);
+  Bridge.enterSafeState();
+  TEST_ASSERT_EQUAL_UINT8(2, g_request_log[0].calls);
+  TEST_ASSERT_EQUAL(bridge::RequestStatus::LOST, g_request_log[0].status);
+  TEST_ASSERT_EQUAL(0, ba.pendingRequests());
+}
+
+void test_second_instance() {
+  BiStream stream;
+  reset_bridge_comp(stream);
+  {
+    BiStream other_stream;
+    TestAccessor other(other_stream);
+    other.begin(rpc::RPC_DEFAULT_BAUDRATE, "top-secret");
+    other.setSynchronized();
+    TEST_ASSERT_EQUAL_PTR(&other, BridgeClass::current());
+
+    TEST_ASSERT_TRUE(
+        other.sendFrame(rpc::CommandId::CMD_CONSOLE_WRITE, 1, {}));
+    TEST_ASSERT_TRUE(other.isAwaitingAck());
+    TEST_ASSERT_FALSE(TestAccessor::create(Bridge).isAwaitingAck());
+
+    // The ack timer retransmits on the bridge that armed it.
+    stream.clear();
+    other_stream.clear();
+    other.fireTimer(bridge::scheduler::TIMER_ACK_TIMEOUT);
+    TEST_ASSERT_GREATER_THAN(0, other_stream.tx_buf.remaining());
+    TEST_ASSERT_EQUAL(0, stream.tx_buf.remaining());
+
+    Bridge.process();
+    TEST_ASSERT_EQUAL_PTR(&Bridge, BridgeClass::current());
+    other.process();
+  }
+  // A destroyed bridge no longer receives ETL errors.
+  TEST_ASSERT_NULL(BridgeClass::current());
+}
+
+#if BRIDGE_BOND_MAX_LINKS > 1
+// Frames @p env as Linux would and queues it on @p stream.
+void feed_envelope(BiStream& stream, const rpc_pb_RpcEnvelope& env) {
+  etl::array<uint8_t, 256> raw;
+  etl::array<uint8_t, 300> encoded;
+  const size_t raw_len = rpc::serialize_frame(env, raw);
+  const size_t len = TestCOBS::encode(raw.data(), raw_len, encoded.data());
+  stream.feed(encoded.data(), len);
+  const uint8_t delimiter = rpc::RPC_FRAME_DELIMITER;
+  stream.feed(&delimiter, 1);
+}
+
+// The bond_seq of each CMD_GET_VERSION_RESP in @p stream, by sequence id.
+void collect_versions(const BiStream& stream, uint32_t (&bond_by_seq)[8]) {
+  size_t cursor = 0;
+  rpc_pb_RpcEnvelope frame;
+  while (extract_next_valid_frame(stream.tx_buf, cursor, frame)) {
+    if (frame.command_id ==
+            rpc::to_underlying(rpc::CommandId::CMD_GET_VERSION_RESP) &&
+        frame.sequence_id < 8U) {
+      bond_by_seq[frame.sequence_id] = frame.bond_seq;
+    }
+  }
+}
+
+void test_bonded_links() {
+  BiStream stream;
+  BiStream second;
+  Bridge.~BridgeClass();
+  new (&Bridge) bridge::test::TestAccessor(stream);
+  TEST_ASSERT_TRUE(Bridge.addLink(second));
+  for (size_t i = 2; i < bridge::config::BOND_MAX_LINKS; ++i) {
+    TEST_ASSERT_TRUE(Bridge.addLink(second));
+  }
+  TEST_ASSERT_FALSE(Bridge.addLink(second));
+  Bridge.begin(rpc::RPC_DEFAULT_BAUDRATE, "top-secret");
+  auto& ba = TestAccessor::create(Bridge);
+  ba.setSynchronized();
+  // Plaintext keeps the frames readable here; AEAD is covered elsewhere.
+  ba.setSharedSecret(etl::span<const uint8_t>());
+
+  // Frame 1 overtakes frame 0 on the second link and waits for it.
+  rpc_pb_RpcEnvelope version = rpc::build_envelope(
+      rpc::to_underlying(rpc::CommandId::CMD_GET_VERSION), 2);
+  version.bond_seq = 2;
+  feed_envelope(second, version);
+  Bridge.process();
+  uint32_t bond_by_seq[8] = {};
+  collect_versions(stream, bond_by_seq);
+  collect_versions(second, bond_by_seq);
+  TEST_ASSERT_EQUAL_UINT32(0, bond_by_seq[2]);
+
+  version.sequence_id = 1;
+  version.bond_seq = 1;
+  feed_envelope(stream, version);
+  Bridge.process();
+  // Both answered in order, numbered, and striped over both links.
+  collect_versions(stream, bond_by_seq);
+  collect_versions(second, bond_by_seq);
+  TEST_ASSERT_NOT_EQUAL(0, bond_by_seq[1]);
+  TEST_ASSERT_TRUE(bond_by_seq[2] > bond_by_seq[1]);
+  TEST_ASSERT_TRUE(stream.tx_buf.len > 0);
+  TEST_ASSERT_TRUE(second.tx_buf.len > 0);
+
+  // A frame already handled is dropped.
+  const uint16_t duplicates = Bridge.linkCount(
+      BridgeClass::LinkCounter::RX_DUPLICATES);
+  feed_envelope(second, version);
+  Bridge.process();
+  TEST_ASSERT_EQUAL_UINT16(
+      duplicates + 1U,
+      Bridge.linkCount(BridgeClass::LinkCounter::RX_DUPLICATES));
+
+#if defined(ARDUINO_STUB_CUSTOM_MILLIS)
+  // bond_seq 3 is lost on its link: 4 goes through once the gap expires.
+  version.sequence_id = 4;
+  version.bond_seq = 4;
+  feed_envelope(second, version);
+  Bridge.process();
+  bond_by_seq[4] = 0;
+  collect_versions(stream, bond_by_seq);
+  collect_versions(second, bond_by_seq);
+  TEST_ASSERT_EQUAL_UINT32(0, bond_by_seq[4]);
+  bridge::test::fault::advance_clock_ms(bridge::config::BOND_GAP_MS);
+  Bridge.process();
+  collect_versions(stream, bond_by_seq);
+  collect_versions(second, bond_by_seq);
+  TEST_ASSERT_NOT_EQUAL(0, bond_by_seq[4]);
+#endif
+
+  // The safe state ends bonding: frames go out unnumbered on the first link.
+  Bridge.enterSafeState();
+  ba.setSynchronized();
+  ba.setTxEnabled(true);
+  stream.clear();
+  second.clear();
+  version.sequence_id = 5;
+  version.bond_seq = 0;
+  feed_envelope(stream, version);
+  Bridge.process();
+  bond_by_seq[5] = 1;
+  collect_versions(stream, bond_by_seq);
+  TEST_ASSERT_EQUAL_UINT32(0, bond_by_seq[5]);
+  TEST_ASSERT_EQUAL(0, second.tx_buf.len);
+}
+#endif
+
 int main() {
   UNITY_BEGIN();
   RUN_TEST(test_all_handlers_coverage);
@@ -176,5 +1547,30 @@ int main() {
   RUN_TEST(test_console_api);
   RUN_TEST(test_datastore_api);
   RUN_TEST(test_mailbox_api);
+  RUN_TEST(test_port_mask_commands);
+  RUN_TEST(test_pin_event_subscriptions);
+  RUN_TEST(test_isr_events);
+  RUN_TEST(test_sampler_stream);
+  RUN_TEST(test_sampler_timer_scans);
+  RUN_TEST(test_telemetry_jobs);
+  RUN_TEST(test_aggregation_windows);
+  RUN_TEST(test_reflex_rules);
+  RUN_TEST(test_scheduled_gpio);
+  RUN_TEST(test_gpio_batch);
+  RUN_TEST(test_waveform_playback);
+  RUN_TEST(test_memory_profile);
+  RUN_TEST(test_loop_profiler);
+  RUN_TEST(test_i2c_service);
+  RUN_TEST(test_kv_store);
+  RUN_TEST(test_link_stats);
+  RUN_TEST(test_frame_trace);
+  RUN_TEST(test_frame_timestamps);
+  RUN_TEST(test_baudrate_calibration);
+  RUN_TEST(test_user_services);
+  RUN_TEST(test_request_table);
+  RUN_TEST(test_second_instance);
+#if BRIDGE_BOND_MAX_LINKS > 1
+  RUN_TEST(test_bonded_links);
+#endif
   return UNITY_END();
 }
\ No newline at end of file
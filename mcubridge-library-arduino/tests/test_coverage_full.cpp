@@ -146,7 +146,7 @@ void test_bridge_coverage() {
           dummy_datastore_get>());
   rpc::payload::DatastoreGetResponse ds_get_p;
   rpc::payload::copy_to_pb_bytes(ds_get_p.value, ds_val, 2);
-  DataStore._onResponse(ds_get_p);
+  ba.completeRequest(rpc::CommandId::CMD_DATASTORE_GET_RESP, ds_get_p);
 
   rpc_pb_RpcEnvelope f_dsg = {};
   f_dsg.command_id = (uint16_t)rpc::CommandId::CMD_DATASTORE_GET_RESP;
@@ -193,7 +193,7 @@ void test_bridge_coverage() {
 
   rpc::payload::FileReadResponse fr_p;
   rpc::payload::copy_to_pb_bytes(fr_p.content, ds_val, 2);
-  FileSystem._onResponse(fr_p);
+  ba.completeRequest(rpc::CommandId::CMD_FILE_READ_RESP, fr_p, false);
 
   rpc_pb_RpcEnvelope f_fr = {};
   f_fr.command_id = (uint16_t)rpc::CommandId::CMD_FILE_READ_RESP;
@@ -242,7 +242,9 @@ void test_bridge_coverage() {
 
   rpc::payload::ProcessRunAsyncResponse prar;
   prar.pid = 123;
-  Process._onRunAsyncResponse(prar);
+  Process._onRunAsyncResponse(
+      etl::delegate<void(int32_t)>::create<dummy_process_run>(),
+      bridge::RequestStatus::OK, &prar);
 
   rpc_pb_RpcEnvelope f_prar = {};
   f_prar.command_id = (uint16_t)rpc::CommandId::CMD_PROCESS_RUN_ASYNC_RESP;
@@ -252,7 +254,10 @@ void test_bridge_coverage() {
   rpc::payload::ProcessPollResponse ppr_p;
   ppr_p.status = 0;
   ppr_p.exit_code = 0;
-  Process._onPollResponse(ppr_p);
+  Process._onPollResponse(
+      etl::delegate<void(rpc::StatusCode, uint16_t, etl::span<const uint8_t>,
+                         etl::span<const uint8_t>)>::create<dummy_process_poll>(),
+      bridge::RequestStatus::OK, &ppr_p);
 
   rpc_pb_RpcEnvelope f_ppr = {};
   f_ppr.command_id = (uint16_t)rpc::CommandId::CMD_PROCESS_POLL_RESP;
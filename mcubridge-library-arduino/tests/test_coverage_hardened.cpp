@@ -107,8 +107,9 @@ void test_filesystem_read_edge_cases() {
       bridge::test::fault::FaultPoint::FILESYSTEM_TIMEOUT);
   FileSystem._onRead(req_large);
 
-  // Coverage for observer notification
-  FileSystem.onLost();
+  // A read still open when the link drops ends with an empty chunk.
+  FileSystem.read("test_large.txt", FileSystemType::FileSystemReadHandler{});
+  Bridge.enterSafeState();
 }
 
 void test_spi_timeout_and_error_paths() {
@@ -150,12 +151,8 @@ void test_process_poll_and_kill() {
   Process.runAsync("ls", {},
                    etl::delegate<void(int32_t)>::create<async_handler>());
 
-  // Internal handlers (coverage only)
-  Process._onRunAsyncResponse({});
-  Process._onPollResponse({});
-
-  // Coverage for observer notification
-  Process.onLost();
+  // reset() ends both requests (pid -1, STATUS_ERROR).
+  Process.reset();
 }
 
 void test_process_branch_error_paths() {
@@ -165,25 +162,35 @@ void test_process_branch_error_paths() {
   ba.setSynchronized();
   Process.reset();
 
-  // Fill run queue (size=1) and trigger full-queue error callback path.
+  // Fill the request table and trigger the full-table error callback path.
   captured_pid = 0;
-  Process.runAsync(
-      "ls", {}, etl::delegate<void(int32_t)>::create<capture_async_handler>());
+  for (size_t i = 0; i < bridge::config::MAX_PENDING_REQUESTS; ++i) {
+    Process.runAsync(
+        "ls", {},
+        etl::delegate<void(int32_t)>::create<capture_async_handler>());
+  }
+  TEST_ASSERT_EQUAL(0, captured_pid);
   Process.runAsync(
       "pwd", {}, etl::delegate<void(int32_t)>::create<capture_async_handler>());
   TEST_ASSERT_EQUAL(-1, captured_pid);
-  TEST_ASSERT_EQUAL(1, Process._pending_run_async.size());
-  Process._onRunAsyncResponse([]() {
-    rpc::payload::ProcessRunAsyncResponse p;
-    p.pid = 42;
-    return p;
-  }());
+  TEST_ASSERT_EQUAL(bridge::config::MAX_PENDING_REQUESTS,
+                    ba.pendingRequests());
+  TEST_ASSERT_TRUE(ba.completeRequest(
+      rpc::CommandId::CMD_PROCESS_RUN_ASYNC_RESP, []() {
+        rpc::payload::ProcessRunAsyncResponse p;
+        p.pid = 42;
+        return p;
+      }()));
   TEST_ASSERT_EQUAL(42, captured_pid);
 
-  // Valid send with invalid callback should not enqueue a pending run.
+  // reset() ends the runs still open.
   Process.reset();
+  TEST_ASSERT_EQUAL(-1, captured_pid);
+  TEST_ASSERT_EQUAL(0, ba.pendingRequests());
+
+  // Valid send with invalid callback should not open a request.
   Process.runAsync("ls", {}, ProcessType::ProcessRunHandler{});
-  TEST_ASSERT_EQUAL(0, Process._pending_run_async.size());
+  TEST_ASSERT_EQUAL(0, ba.pendingRequests());
 
   // Force append_token failure via oversized arg, and hit lambda early return.
   etl::array<char, rpc::MAX_PAYLOAD_SIZE + 1> long_arg_storage = {};
@@ -226,18 +233,22 @@ void test_process_branch_error_paths() {
   auto& ba_recovered = TestAccessor::create(Bridge);
   ba_recovered.setSynchronized();
 
-  // Poll queue full path (size=1), then invalid-handler path.
+  // Full request table path, then invalid-handler path.
   Process.reset();
-  Process.poll(10,
-               ProcessType::ProcessPollHandler::create<capture_poll_handler>());
-  TEST_ASSERT_EQUAL(1, Process._pending_polls.size());
+  for (size_t i = 0; i < bridge::config::MAX_PENDING_REQUESTS; ++i) {
+    Process.poll(
+        10, ProcessType::ProcessPollHandler::create<capture_poll_handler>());
+  }
+  TEST_ASSERT_EQUAL(bridge::config::MAX_PENDING_REQUESTS,
+                    ba_recovered.pendingRequests());
   Process.poll(11,
                ProcessType::ProcessPollHandler::create<capture_poll_handler>());
-  TEST_ASSERT_EQUAL(1, Process._pending_polls.size());
+  TEST_ASSERT_EQUAL(bridge::config::MAX_PENDING_REQUESTS,
+                    ba_recovered.pendingRequests());
 
   Process.reset();
   Process.poll(12, ProcessType::ProcessPollHandler{});
-  TEST_ASSERT_EQUAL(0, Process._pending_polls.size());
+  TEST_ASSERT_EQUAL(0, ba_recovered.pendingRequests());
 
   // Force send failure in poll path.
   ba_recovered.clearSynchronized();
@@ -338,20 +349,24 @@ void test_mailbox_and_datastore_variants() {
   // Coverage for observer notification
   Mailbox.onLost();
 
-  DataStore._pending_gets.clear();
   DataStore.get("alpha",
                 DataStoreType::GetHandler::create<datastore_get_handler>());
   DataStore.get("beta",
                 DataStoreType::GetHandler::create<datastore_get_handler>());
-  DataStore._onResponse({});
-  DataStore._pending_gets.clear();
+  TEST_ASSERT_TRUE(ba.completeRequest(rpc::CommandId::CMD_DATASTORE_GET_RESP,
+                                      rpc::payload::DatastoreGetResponse{}));
+  // A response nobody is waiting for is dropped.
+  TEST_ASSERT_FALSE(ba.completeRequest(rpc::CommandId::CMD_DATASTORE_GET_RESP,
+                                       rpc::payload::DatastoreGetResponse{}));
 
   // Empty put and get
   DataStore.set("", etl::span<const uint8_t>());
   DataStoreType::GetHandler invalid_get_handler;
   invalid_get_handler.clear();
   DataStore.get("", invalid_get_handler);
-  DataStore._onResponse(rpc::payload::DatastoreGetResponse{});
+  TEST_ASSERT_TRUE(ba.completeRequest(rpc::CommandId::CMD_DATASTORE_GET_RESP,
+                                      rpc::payload::DatastoreGetResponse{}));
+  Bridge.enterSafeState();
 }
 
 void test_bridge_fsm_resets() {
@@ -700,15 +715,15 @@ void test_uncovered_branch_and_coverage_boost() {
   DataStore.get("alpha",
                 DataStoreType::GetHandler::create<datastore_get_handler>());
 
-  // 3. DataStore.get Queue Full
-  DataStore._pending_gets.clear();
-  for (size_t i = 0; i < bridge::config::MAX_PENDING_DATASTORE; ++i) {
+  // 3. DataStore.get with the request table full
+  while (ba.pendingRequests() < bridge::config::MAX_PENDING_REQUESTS) {
     DataStore.get("key",
                   DataStoreType::GetHandler::create<datastore_get_handler>());
   }
-  // Try one more to trigger full-queue branch
+  // Try one more to trigger full-table branch
   DataStore.get("overflow",
                 DataStoreType::GetHandler::create<datastore_get_handler>());
+  Bridge.cancelRequests(rpc::CommandId::CMD_DATASTORE_GET_RESP);
 
   // 4. Protobuf encoding failure path in _sendEncryptedHelper
   // A command payload exceeding the 64-byte pool limit.
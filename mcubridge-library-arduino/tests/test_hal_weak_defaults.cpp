@@ -39,18 +39,56 @@ void test_hal_weak_defaults_without_mock() {
   TEST_ASSERT_EQUAL(static_cast<int>(bridge::hal::HalError::NOT_IMPLEMENTED),
                     static_cast<int>(remove_res.error()));
 
+  uint8_t nv[4];
+  TEST_ASSERT_EQUAL_UINT16(0U, bridge::hal::nvSize());
+  TEST_ASSERT_FALSE(bridge::hal::nvRead(0, etl::span<uint8_t>(nv)).has_value());
+  TEST_ASSERT_TRUE(bridge::hal::nvCommit().has_value());
+
   rpc_pb_Capabilities caps = rpc_pb_Capabilities_init_default;
   bridge::hal::fillCapabilities(caps);
   TEST_ASSERT_FALSE(caps.sd);
+  TEST_ASSERT_FALSE(caps.eeprom);
 
   g_host_has_sd = original_sd;
   g_host_fs_enabled = original_fs;
 }
 
+// Without a direct-port pin map the fast GPIO layer is the Arduino API, for
+// in-range pins, out-of-range pins and pins with PWM attached alike.
+void test_fast_gpio_falls_back_to_arduino_api() {
+  bridge::hal::fastPinMode(13, OUTPUT);
+  bridge::hal::fastDigitalWrite(13, HIGH);
+  TEST_ASSERT_EQUAL(::digitalRead(13), bridge::hal::fastDigitalRead(13));
+
+  bridge::hal::fastAnalogWrite(9, 128);
+  TEST_ASSERT_EQUAL(::digitalRead(9), bridge::hal::fastDigitalRead(9));
+  bridge::hal::fastDigitalWrite(9, LOW);
+
+  TEST_ASSERT_EQUAL(::digitalRead(200), bridge::hal::fastDigitalRead(200));
+  bridge::hal::fastAnalogWrite(200, 0);
+}
+
+// The mask operations detach PWM left by fastAnalogWrite() on the pins they
+// touch, and only on those, like the single-pin path.
+void test_mask_gpio_detaches_pwm() {
+  bridge::hal::fastAnalogWrite(5, 128);
+  bridge::hal::fastAnalogWrite(6, 64);
+  bridge::hal::fastAnalogWrite(9, 255);  // plain HIGH: no timer left on
+  TEST_ASSERT_EQUAL_HEX32((1UL << 5) | (1UL << 6), bridge::hal::pwmPins());
+
+  bridge::hal::digitalWriteMask((1UL << 5) | (1UL << 9), 1UL << 5);
+  TEST_ASSERT_EQUAL_HEX32(1UL << 6, bridge::hal::pwmPins());
+
+  TEST_ASSERT_EQUAL_HEX32(0U, bridge::hal::digitalReadPort(1UL << 6));
+  TEST_ASSERT_EQUAL_HEX32(0U, bridge::hal::pwmPins());
+}
+
 #if defined(__STDC_HOSTED__) && (__STDC_HOSTED__ == 1)
 int main() {
   UNITY_BEGIN();
   RUN_TEST(test_hal_weak_defaults_without_mock);
+  RUN_TEST(test_fast_gpio_falls_back_to_arduino_api);
+  RUN_TEST(test_mask_gpio_detaches_pwm);
   return UNITY_END();
 }
 #endif
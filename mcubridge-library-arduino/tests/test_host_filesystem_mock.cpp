@@ -1,4 +1,5 @@
 #include <errno.h>
+#include <etl/algorithm.h>
 #include <etl/string.h>
 #include <stdio.h>
 #include <string.h>
@@ -13,6 +14,11 @@
 
 bool g_host_has_sd = true;
 bool g_host_fs_enabled = true;
+// File-backed EEPROM: erased bytes read as 0xFF, like the real thing.
+// Shrink g_host_nv_size to force compactions; g_host_nv_bytes_written counts
+// the bytes that actually changed (the wear a real EEPROM would see).
+uint16_t g_host_nv_size = 1024;
+uint32_t g_host_nv_bytes_written = 0;
 
 namespace bridge {
 namespace hal {
@@ -120,5 +126,56 @@ etl::expected<void, HalError> removeFile(etl::string_view path) {
              : etl::unexpected<HalError>(HalError::IO_ERROR);
 }
 
+constexpr char kHostNvPath[] = "/tmp/mcubridge-host-eeprom.bin";
+
+uint16_t nvSize() { return g_host_nv_size; }
+
+etl::expected<void, HalError> nvRead(uint16_t addr, etl::span<uint8_t> out) {
+  if (static_cast<uint32_t>(addr) + out.size() > g_host_nv_size)
+    return etl::unexpected<HalError>(HalError::INVALID_ARGUMENT);
+  etl::fill(out.begin(), out.end(), 0xFF);
+  FILE* file = fopen(kHostNvPath, "rb");
+  if (file == nullptr) return {};
+  if (fseek(file, addr, SEEK_SET) == 0) {
+    (void)fread(out.data(), 1U, out.size(), file);
+  }
+  fclose(file);
+  return {};
+}
+
+etl::expected<void, HalError> nvWrite(uint16_t addr,
+                                      etl::span<const uint8_t> data) {
+  if (static_cast<uint32_t>(addr) + data.size() > g_host_nv_size)
+    return etl::unexpected<HalError>(HalError::INVALID_ARGUMENT);
+  uint8_t old[64];
+  FILE* file = fopen(kHostNvPath, "r+b");
+  if (file == nullptr) file = fopen(kHostNvPath, "w+b");
+  if (file == nullptr) return etl::unexpected<HalError>(HalError::IO_ERROR);
+  // Pad up to addr with erased bytes so the gap reads back as 0xFF.
+  fseek(file, 0, SEEK_END);
+  for (long end = ftell(file); end < static_cast<long>(addr); ++end) {
+    fputc(0xFF, file);
+  }
+  size_t done = 0;
+  bool failed = false;
+  while (done < data.size() && !failed) {
+    const size_t n = etl::min(sizeof(old), data.size() - done);
+    const uint8_t* chunk = data.data() + done;
+    etl::fill_n(old, n, 0xFF);
+    fseek(file, static_cast<long>(addr + done), SEEK_SET);
+    (void)fread(old, 1U, n, file);
+    for (size_t i = 0; i < n; ++i) {
+      if (old[i] != chunk[i]) ++g_host_nv_bytes_written;
+    }
+    fseek(file, static_cast<long>(addr + done), SEEK_SET);
+    failed = fwrite(chunk, 1U, n, file) != n;
+    done += n;
+  }
+  fflush(file);
+  fclose(file);
+  return failed ? etl::unexpected<HalError>(HalError::IO_ERROR)
+                : etl::expected<void, HalError>{};
+}
+
 }  // namespace hal
 }  // namespace bridge
@@ -80,6 +80,8 @@ def get_default_config() -> dict[str, Any]:
         serial_response_timeout=const.DEFAULT_SERIAL_RESPONSE_TIMEOUT,
         serial_retry_attempts=protocol.DEFAULT_RETRY_LIMIT,
         serial_fallback_threshold=protocol.DEFAULT_SERIAL_FALLBACK_THRESHOLD,
+        serial_auto_baud=False,
+        serial_bond_ports=[],
         serial_handshake_min_interval=const.DEFAULT_SERIAL_HANDSHAKE_MIN_INTERVAL,
         serial_handshake_fatal_failures=protocol.DEFAULT_SERIAL_HANDSHAKE_FATAL_FAILURES,
         cloud_enabled=True,
@@ -44,6 +44,22 @@ DEFAULT_SERIAL_RETRY_TIMEOUT: float = 10.0
 DEFAULT_SERIAL_RESPONSE_TIMEOUT: float = 20.0
 # Baudrate negotiation timeout
 SERIAL_BAUDRATE_NEGOTIATION_TIMEOUT: float = 2.0
+# Wait after CMD_SET_BAUDRATE_RESP: covers the MCU's baudrate_change_delay_ms
+SERIAL_BAUDRATE_SETTLE_SECONDS: float = 0.1
+# Link calibration (serial_auto_baud): rates tried above the safe baud, up to serial_baud
+SERIAL_CALIBRATION_BAUDRATES: tuple[int, ...] = (115200, 230400, 250000, 460800, 500000, 921600, 1000000)
+# Echoes per rate, and the deadline for each
+SERIAL_CALIBRATION_PROBES: int = 16
+SERIAL_CALIBRATION_PROBE_TIMEOUT: float = 0.5
+# How long the MCU waits for a valid frame at a trial rate before going back
+SERIAL_CALIBRATION_CONFIRM_MS: int = 1000
+# Corrupted share of the frames seen in a link-stats poll that triggers a new calibration
+SERIAL_RECALIBRATION_ERROR_RATE: float = 0.01
+SERIAL_RECALIBRATION_MIN_FRAMES: int = 100
+# Bonded links (serial_bond_ports): MCU frames held back for the ones before
+# them, and how long a gap may stay open before it counts as lost
+SERIAL_BOND_REORDER_WINDOW: int = 16
+SERIAL_BOND_GAP_TIMEOUT: float = 0.05
 DEFAULT_SERIAL_HANDSHAKE_MIN_INTERVAL: float = 0.0
 # How many fatal handshake failures before restarting the serial task
 
@@ -223,6 +239,15 @@ __all__ = [
     "SUPERVISOR_MIN_RESTART_WINDOW",
     "WATCHDOG_MIN_INTERVAL",
     "SERIAL_BAUDRATE_NEGOTIATION_TIMEOUT",
+    "SERIAL_BAUDRATE_SETTLE_SECONDS",
+    "SERIAL_CALIBRATION_BAUDRATES",
+    "SERIAL_CALIBRATION_PROBES",
+    "SERIAL_CALIBRATION_PROBE_TIMEOUT",
+    "SERIAL_CALIBRATION_CONFIRM_MS",
+    "SERIAL_RECALIBRATION_ERROR_RATE",
+    "SERIAL_RECALIBRATION_MIN_FRAMES",
+    "SERIAL_BOND_REORDER_WINDOW",
+    "SERIAL_BOND_GAP_TIMEOUT",
     "SPOOL_BACKOFF_MULTIPLIER",
     "SPOOL_BACKOFF_MIN_SECONDS",
     "SPOOL_BACKOFF_MAX_SECONDS",
@@ -147,10 +147,11 @@ def load_runtime_config(overrides: dict[str, Any] | None = None) -> RuntimeConfi
 
     msg = pb.RuntimeConfig()
 
-    if isinstance(raw_values.get("allowed_commands"), str):
-        raw_values["allowed_commands"] = raw_values["allowed_commands"].split()
-    elif raw_values.get("allowed_commands") is None:
-        raw_values["allowed_commands"] = []
+    for list_field in ("allowed_commands", "serial_bond_ports"):
+        if isinstance(raw_values.get(list_field), str):
+            raw_values[list_field] = raw_values[list_field].split()
+        elif raw_values.get(list_field) is None:
+            raw_values[list_field] = []
 
     for field in msg.DESCRIPTOR.fields:
         if field.name in ("allowed_policy", "topic_authorization"):
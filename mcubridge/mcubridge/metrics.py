@@ -248,6 +248,18 @@ class RuntimeStateCollector(Collector):
         link_sync.add_metric([], 1.0 if state.is_synchronized else 0.0)
         yield link_sync
 
+        # 3. MCU Link Health (Dimensional, accumulated from CMD_GET_LINK_STATS)
+        mcu_link = GaugeMetricFamily(
+            "mcubridge_mcu_link",
+            "Link counters and high-water marks reported by the MCU",
+            labels=["counter"],
+        )
+        [
+            mcu_link.add_metric([field.name], float(value))
+            for field, value in state.serial_flow_stats.mcu.ListFields()
+        ]
+        yield mcu_link
+
         # 4. Supervisor Health (Dimensional)
         super_health = GaugeMetricFamily(
             "mcubridge_supervisor_worker_restarts",
@@ -49,8 +49,15 @@ def build_frame(
     nonce: bytes | None = None,
     tag: bytes | None = None,
     session_key: bytes | None = None,
+    sent_us: int = 0,
+    bond_seq: int = 0,
 ) -> bytes:
-    """Builds a binary frame using a Protobuf envelope directly. [SIL-2]"""
+    """Builds a binary frame using a Protobuf envelope directly. [SIL-2]
+
+    A non-zero ``sent_us`` stamps the frame with the host clock so the MCU
+    echoes it back (see Capabilities.frame_timestamps). A non-zero
+    ``bond_seq`` numbers it for a bonded link (serial_bond_ports).
+    """
     if not (0 <= command_id <= protocol.UINT16_MAX):
         raise ValueError(f"Invalid command ID: {command_id}")
 
@@ -62,6 +69,8 @@ def build_frame(
         command_id=command_id,
         sequence_id=sequence_id,
         nonce=nonce or (b"\x00" * _NONCE_SIZE),
+        sent_us=sent_us,
+        bond_seq=bond_seq,
     )
 
     # AEAD Encryption (if session key provided)
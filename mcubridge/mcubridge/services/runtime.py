@@ -41,6 +41,12 @@ from ..config.const import (
     DEFAULT_SYNC_TIMEOUT_SECONDS,
     STREAM_POLL_TIMEOUT_SECONDS,
     PROCESS_TERM_GRACE_PERIOD_SECONDS,
+    SERIAL_CALIBRATION_BAUDRATES,
+    SERIAL_CALIBRATION_CONFIRM_MS,
+    SERIAL_CALIBRATION_PROBES,
+    SERIAL_CALIBRATION_PROBE_TIMEOUT,
+    SERIAL_RECALIBRATION_ERROR_RATE,
+    SERIAL_RECALIBRATION_MIN_FRAMES,
 )
 from ..config.settings import RuntimeConfig
 from ..protocol import protocol, structures
@@ -48,12 +54,18 @@ from ..protocol.protocol import (
     Command,
     DatastoreAction,
     FileAction,
+    I2CAction,
     MailboxAction,
     PinAction,
+    ReflexAction,
+    ScheduleAction,
     ShellAction,
     SpiAction,
     Status,
+    StreamAction,
+    TelemetryAction,
     SystemAction,
+    WaveAction,
     response_to_request,
 )
 
@@ -102,6 +114,9 @@ _PRE_SYNC_ALLOWED_COMMANDS: Final = {
 
 _STATUS_VALUES: Final = {s.value for s in Status}
 
+# Alternating bits, zeros (COBS overhead) and all-ones, at the LinkProbe limit.
+_LINK_PROBE_PATTERN: Final = bytes((0x55, 0xAA, 0x00, 0xFF)) * 12
+
 
 @dataclass
 class _PendingMcuRead:
@@ -208,6 +223,12 @@ class BridgeService:
                 Status.ACK.value: self._on_mcu_ack,
                 Command.CMD_DIGITAL_READ_RESP.value: self._on_mcu_digital_read_resp,
                 Command.CMD_ANALOG_READ_RESP.value: self._on_mcu_analog_read_resp,
+                Command.CMD_PIN_EVENT.value: self._on_mcu_pin_event,
+                Command.CMD_STREAM_DATA.value: self._on_mcu_stream_data,
+                Command.CMD_TELEMETRY_REPORT.value: self._on_mcu_telemetry_report,
+                Command.CMD_AGGREGATE_REPORT.value: self._on_mcu_aggregate_report,
+                Command.CMD_REFLEX_FIRED.value: self._on_mcu_reflex_fired,
+                Command.CMD_EVENT_BATCH.value: self._on_mcu_event_batch,
                 Command.CMD_PROCESS_KILL.value: self._on_mcu_process_kill,
                 Command.CMD_DIGITAL_READ.value: self._unsupported_digital,
                 Command.CMD_ANALOG_READ.value: self._unsupported_analog,
@@ -450,10 +471,20 @@ class BridgeService:
         await self.handshake.synchronize()
         if self.state.is_synchronized:
             await self._request_mcu_version()
+            if self.config.serial_auto_baud:
+                await self._calibrate_baudrate()
+            await self._sync_mcu_clock()
+            await self._enable_bonding()
             await self._flush_console_queue()
+            await self._restore_pin_subscriptions()
+            await self._restore_stream()
+            await self._restore_telemetry_jobs()
+            await self._restore_reflex_rules()
+            await self._restore_waveform()
 
     async def on_serial_disconnected(self) -> None:
         self.state.mark_transport_disconnected()
+        self.state.mcu_clock.reset()
         for q in (self.state.pending_digital_reads, self.state.pending_analog_reads):
             q.clear()
         self.state.mcu_is_paused = False
@@ -505,7 +536,18 @@ class BridgeService:
             )
 
         if route := parse_topic(self.state.cloud_topic_prefix, request.topic):
-            if route.topic in (Topic.DIGITAL, Topic.ANALOG, Topic.CONSOLE, Topic.SPI):
+            if route.topic in (
+                Topic.DIGITAL,
+                Topic.ANALOG,
+                Topic.CONSOLE,
+                Topic.SPI,
+                Topic.I2C,
+                Topic.STREAM,
+                Topic.TELEMETRY,
+                Topic.REFLEX,
+                Topic.SCHEDULE,
+                Topic.WAVE,
+            ):
                 try:
                     async with asyncio.timeout(DEFAULT_SYNC_TIMEOUT_SECONDS):
                         await self.state.link_sync_event.wait()
@@ -535,6 +577,18 @@ class BridgeService:
                     await self._handle_shell(route, request)
                 case Topic.SPI:
                     await self._handle_spi(route, request)
+                case Topic.I2C:
+                    await self._handle_i2c(route, request)
+                case Topic.STREAM:
+                    await self._handle_stream(route, request)
+                case Topic.TELEMETRY:
+                    await self._handle_telemetry(route, request)
+                case Topic.REFLEX:
+                    await self._handle_reflex(route, request)
+                case Topic.SCHEDULE:
+                    await self._handle_schedule(route, request)
+                case Topic.WAVE:
+                    await self._handle_wave(route, request)
                 case Topic.DIGITAL | Topic.ANALOG:
                     await self._handle_pin(route, request)
                 case Topic.SYSTEM:
@@ -578,6 +632,7 @@ class BridgeService:
         res = await serial.send(
             Command.CMD_DATASTORE_GET_RESP.value,
             pb.DatastoreGetResponse(value=val[:255]),
+            seq,
         )
         return bool(res)
 
@@ -642,12 +697,12 @@ class BridgeService:
         if path and await asyncio.to_thread(path.is_file):
             data = await asyncio.to_thread(path.read_bytes)
             if not data:
-                await serial.send(Command.CMD_FILE_READ_RESP.value, pb.FileReadResponse(content=b""))
+                await serial.send(Command.CMD_FILE_READ_RESP.value, pb.FileReadResponse(content=b""), seq)
             else:
                 for chunk in iter_chunks(data, protocol.MAX_PAYLOAD_SIZE - 3):
-                    await serial.send(Command.CMD_FILE_READ_RESP.value, pb.FileReadResponse(content=chunk))
+                    await serial.send(Command.CMD_FILE_READ_RESP.value, pb.FileReadResponse(content=chunk), seq)
             return
-        await serial.send(Status.ERROR.value, pb.GenericResponse(message="Read failed"))
+        await serial.send(Status.ERROR.value, pb.GenericResponse(message="Read failed"), seq)
 
     async def _on_mcu_file_remove(self, seq: int, p: pb.FileRemove) -> bool:
         serial = self.serial
@@ -680,9 +735,10 @@ class BridgeService:
                 res = await serial.send(
                     Command.CMD_PROCESS_RUN_ASYNC_RESP.value,
                     pb.ProcessRunAsyncResponse(pid=pid),
+                    seq,
                 )
                 return bool(res)
-        await serial.send(Status.ERROR.value, pb.GenericResponse(message="Exec failed"))
+        await serial.send(Status.ERROR.value, pb.GenericResponse(message="Exec failed"), seq)
         return False
 
     async def _on_mcu_process_poll(self, seq: int, p: pb.ProcessPoll) -> bool:
@@ -693,6 +749,7 @@ class BridgeService:
         res = await serial.send(
             Command.CMD_PROCESS_POLL_RESP.value,
             batch,
+            seq,
         )
         return bool(res)
 
@@ -729,6 +786,318 @@ class BridgeService:
     async def _on_mcu_analog_read_resp(self, seq: int, p: pb.AnalogReadResponse) -> None:
         await self._on_pin_resp(p, Topic.ANALOG, self.state.pending_analog_reads)
 
+    async def _on_mcu_pin_event(self, seq: int, p: pb.PinEvent) -> None:
+        if p.dropped:
+            logger.warning("MCU pin event ring overflowed", dropped=p.dropped)
+        for ev in p.events:
+            await self.enqueue_cloud(
+                create_queued_publish(
+                    topic_path(self.state.cloud_topic_prefix, Topic.DIGITAL, str(ev.pin), PinAction.EVENT),
+                    str(ev.level).encode(),
+                    message_expiry_interval=protocol.CLOUD_EXPIRY_PIN,
+                    user_properties=(
+                        ("bridge-pin", str(ev.pin)),
+                        ("bridge-mcu-timestamp-ms", str(ev.timestamp_ms)),
+                    ),
+                )
+            )
+
+    async def _restore_pin_subscriptions(self) -> None:
+        serial = self.serial
+        if not serial:
+            return
+        for sub in list(self.state.pin_subscriptions.values()):
+            await serial.send(Command.CMD_PIN_SUBSCRIBE.value, sub)
+
+    async def _on_mcu_stream_data(self, seq: int, p: pb.StreamData) -> None:
+        # Samples are forwarded still packed; consumers decode them with the
+        # channel layout they requested (see PROTOCOL.md, CMD_STREAM_DATA).
+        await self.enqueue_cloud(
+            create_queued_publish(
+                get_topic_for_message(self.state.cloud_topic_prefix, p) or "",
+                p.SerializeToString(),
+                content_type=PROTOBUF_CONTENT_TYPE,
+                message_expiry_interval=protocol.CLOUD_EXPIRY_PIN,
+            )
+        )
+
+    async def _restore_stream(self) -> None:
+        serial = self.serial
+        if serial and self.state.stream_config is not None:
+            await serial.send(Command.CMD_STREAM_START.value, self.state.stream_config)
+        if serial and self.state.aggregate_config is not None:
+            await serial.send(Command.CMD_AGGREGATE_CONFIG.value, self.state.aggregate_config)
+
+    async def _on_mcu_aggregate_report(self, seq: int, p: pb.AggregateReport) -> None:
+        if p.missed_windows:
+            logger.warning("MCU aggregation windows dropped", channel=p.channel, missed=p.missed_windows)
+        await self.enqueue_cloud(
+            create_queued_publish(
+                get_topic_for_message(self.state.cloud_topic_prefix, p) or "",
+                p.SerializeToString(),
+                content_type=PROTOBUF_CONTENT_TYPE,
+                message_expiry_interval=protocol.CLOUD_EXPIRY_DEFAULT,
+                user_properties=(("bridge-channel", str(p.channel)),),
+            )
+        )
+
+    async def _on_mcu_telemetry_report(self, seq: int, p: pb.TelemetryReport) -> None:
+        for sample in p.samples:
+            tp = Topic.ANALOG if sample.analog else Topic.DIGITAL
+            await self.enqueue_cloud(
+                create_queued_publish(
+                    topic_path(self.state.cloud_topic_prefix, tp, str(sample.pin), "value"),
+                    str(sample.value).encode(),
+                    message_expiry_interval=protocol.CLOUD_EXPIRY_PIN,
+                    user_properties=(
+                        ("bridge-pin", str(sample.pin)),
+                        ("bridge-telemetry-job", str(sample.job_id)),
+                        ("bridge-mcu-timestamp-ms", str(sample.timestamp_ms)),
+                    ),
+                )
+            )
+
+    async def _on_mcu_reflex_fired(self, seq: int, p: pb.ReflexFired) -> None:
+        await self.enqueue_cloud(
+            create_queued_publish(
+                get_topic_for_message(self.state.cloud_topic_prefix, p) or "",
+                p.SerializeToString(),
+                content_type=PROTOBUF_CONTENT_TYPE,
+                message_expiry_interval=protocol.CLOUD_EXPIRY_DEFAULT,
+                user_properties=(
+                    ("bridge-reflex-rule", str(p.rule_id)),
+                    ("bridge-mcu-timestamp-ms", str(p.timestamp_ms)),
+                ),
+            )
+        )
+
+    async def _on_mcu_event_batch(self, seq: int, p: pb.EventBatch) -> None:
+        if p.dropped:
+            logger.warning("MCU event ring overflowed", dropped=p.dropped)
+        for ev in p.events:
+            await self.enqueue_cloud(
+                create_queued_publish(
+                    topic_path(get_topic_for_message(self.state.cloud_topic_prefix, ev) or "", str(ev.id)),
+                    str(ev.value).encode(),
+                    message_expiry_interval=protocol.CLOUD_EXPIRY_DEFAULT,
+                    user_properties=(
+                        ("bridge-event-id", str(ev.id)),
+                        ("bridge-mcu-timestamp-ms", str(ev.timestamp_ms)),
+                    ),
+                )
+            )
+
+    async def _restore_reflex_rules(self) -> None:
+        serial = self.serial
+        if not serial:
+            return
+        for rule in list(self.state.reflex_rules.values()):
+            await serial.send(Command.CMD_REFLEX_RULE.value, rule)
+
+    async def _restore_waveform(self) -> None:
+        serial = self.serial
+        if not serial:
+            return
+        for chunk in list(self.state.waveform_chunks):
+            if not await serial.send(Command.CMD_WAVEFORM_LOAD.value, chunk):
+                return
+        if self.state.waveform_start is not None:
+            await serial.send(Command.CMD_WAVEFORM_START.value, self.state.waveform_start)
+
+    async def _enable_bonding(self) -> int:
+        """Stripe frames over serial_bond_ports too, as far as the MCU can.
+
+        Runs after calibration and clock sync, which only measure the primary
+        link. The extra ports stay at serial_baud.
+        """
+        serial = self.serial
+        caps = self.state.mcu_capabilities
+        ports = self.config.serial_bond_ports
+        if not serial or not ports or not isinstance(caps, pb.Capabilities):
+            return 1
+        if caps.bond_links < 2:
+            logger.warning("MCU cannot bond serial links; serial_bond_ports ignored")
+            return 1
+        links = await serial.enable_bonding(ports[: caps.bond_links - 1])
+        logger.info("Serial bonding over %d links", links)
+        return links
+
+    async def _sync_mcu_clock(self) -> bool:
+        serial = self.serial
+        if not serial:
+            return False
+        samples: list[tuple[int, int, int, int]] = []
+        for _ in range(protocol.CLOCK_SYNC_BURST):
+            t1 = time.monotonic_ns() // 1000
+            res = await serial.send(Command.CMD_CLOCK_SYNC.value, pb.ClockSync(t1_us=t1 & 0xFFFFFFFF))
+            t4 = time.monotonic_ns() // 1000
+            if isinstance(res, bytes):
+                res = pb.ClockSyncResponse.FromString(res)
+            # A late answer to an earlier probe would pair with the wrong t1.
+            if isinstance(res, pb.ClockSyncResponse) and res.t1_us == t1 & 0xFFFFFFFF:
+                samples.append((t1, res.mcu_rx_us, res.mcu_tx_us, t4))
+        clock = self.state.mcu_clock
+        if not clock.add_burst(samples):
+            logger.warning("MCU clock sync produced no usable samples")
+            return False
+        logger.debug("MCU clock synchronized", rtt_us=clock.rtt_us, drift_ppm=round(clock.drift_ppm, 2))
+        return True
+
+    async def run_clock_sync(self) -> None:
+        """Refresh the MCU clock estimate so scheduled commands track drift."""
+        while True:
+            await asyncio.sleep(protocol.CLOCK_SYNC_INTERVAL_MS / 1000.0)
+            if self.state.is_synchronized:
+                await self._sync_mcu_clock()
+
+    async def _refresh_link_stats(self) -> bool:
+        """Read and clear the MCU link counters, adding them to the totals."""
+        return await self._poll_link_stats() is not None
+
+    async def _poll_link_stats(self) -> pb.LinkStats | None:
+        serial = self.serial
+        if not serial:
+            return None
+        res = await serial.send(Command.CMD_GET_LINK_STATS.value, pb.LinkStatsQuery(reset=True))
+        if isinstance(res, bytes):
+            res = pb.LinkStats.FromString(res)
+        if not isinstance(res, pb.LinkStats):
+            return None
+        self.state.record_mcu_link_stats(res)
+        return res
+
+    async def _probe_link(self) -> float | None:
+        """Echo a burst of CMD_LINK_PROBE frames at the current rate.
+
+        Returns the goodput in bytes/s, or None if any probe went unanswered
+        or came back altered, or either end saw a corrupted frame.
+        """
+        serial = self.serial
+        if not serial:
+            return None
+        # Also the first frame at a trial rate: it confirms the rate to the
+        # MCU, and clears the noise counted while both ends switched.
+        if await self._poll_link_stats() is None:
+            return None
+        decode_errors = self.state.serial_decode_errors
+        started = time.monotonic()
+        for _ in range(SERIAL_CALIBRATION_PROBES):
+            try:
+                async with asyncio.timeout(SERIAL_CALIBRATION_PROBE_TIMEOUT):
+                    res = await serial.send(Command.CMD_LINK_PROBE.value, pb.LinkProbe(pattern=_LINK_PROBE_PATTERN))
+            except TimeoutError:
+                return None
+            if isinstance(res, bytes):
+                res = pb.LinkProbe.FromString(res)
+            if not isinstance(res, pb.LinkProbe) or res.pattern != _LINK_PROBE_PATTERN:
+                return None
+        elapsed = time.monotonic() - started
+        stats = await self._poll_link_stats()
+        if stats is None or stats.rx_malformed or self.state.serial_decode_errors != decode_errors:
+            return None
+        return 2 * len(_LINK_PROBE_PATTERN) * SERIAL_CALIBRATION_PROBES / max(elapsed, 1e-6)
+
+    async def _calibrate_baudrate(self) -> int | None:
+        """Try every candidate rate up to serial_baud; keep the best reliable one.
+
+        Rates are tried from the slowest up, each switched to from the last
+        one that worked. The MCU goes back by itself when no valid frame
+        reaches it at a trial rate (SetBaudratePacket.confirm_timeout_ms).
+        """
+        serial = self.serial
+        if not serial:
+            return None
+        self.state.serial_calibration_due = False
+        good = serial.baudrate
+        results: dict[int, float] = {}
+        if (goodput := await self._probe_link()) is not None:
+            results[good] = goodput
+        ceiling = self.config.serial_baud
+        for rate in sorted({*SERIAL_CALIBRATION_BAUDRATES, ceiling}):
+            if rate <= self.config.serial_safe_baud or rate > ceiling or rate == good:
+                continue
+            if not await serial.switch_baudrate(rate, confirm_timeout_ms=SERIAL_CALIBRATION_CONFIRM_MS):
+                continue
+            goodput = await self._probe_link()
+            if goodput is not None:
+                results[rate] = goodput
+                good = rate
+                continue
+            logger.info("Link calibration: %d baud is not reliable", rate)
+            # Frames may have confirmed the rate on the MCU; otherwise it is
+            # already on its way back and only the local UART has to follow.
+            if not await serial.switch_baudrate(good):
+                await serial.revert_baudrate(good, SERIAL_CALIBRATION_CONFIRM_MS)
+        if not results:
+            logger.warning("Link calibration found no reliable rate; staying at %d baud", serial.baudrate)
+            return None
+        best = max(results, key=results.__getitem__)
+        if best != serial.baudrate and not await serial.switch_baudrate(best):
+            return None
+        self.state.serial_calibration = results
+        self.state.serial_calibrated_baud = best
+        logger.info("Link calibrated to %d baud (%.0f B/s)", best, results[best])
+        return best
+
+    def _link_degraded(self, stats: pb.LinkStats, decode_errors: int) -> bool:
+        frames = stats.rx_frames + stats.tx_frames
+        if frames < SERIAL_RECALIBRATION_MIN_FRAMES:
+            return False
+        return (stats.rx_malformed + decode_errors) / frames > SERIAL_RECALIBRATION_ERROR_RATE
+
+    async def _read_frame_trace(self) -> pb.FrameTrace | None:
+        """Read the MCU frame trace ring chunk by chunk, oldest event first."""
+        serial = self.serial
+        if not serial:
+            return None
+        trace: pb.FrameTrace | None = None
+        start = 0
+        while True:
+            res = await serial.send(Command.CMD_GET_FRAME_TRACE.value, pb.FrameTraceQuery(start=start))
+            if isinstance(res, bytes):
+                res = pb.FrameTrace.FromString(res)
+            if not isinstance(res, pb.FrameTrace):
+                return trace  # Trace compiled out or link lost.
+            if trace is None:
+                # Stop at the end seen first: what comes after is this dump.
+                trace = pb.FrameTrace(start=res.start, end=res.end)
+            elif res.start != start:
+                # The ring wrapped past the chunks read so far.
+                trace = pb.FrameTrace(start=res.start, end=trace.end)
+            trace.events += res.events
+            start = res.start + len(res.events) // protocol.FRAME_TRACE_RECORD_SIZE
+            if not res.events or start >= trace.end:
+                break
+        trace.events = trace.events[: (trace.end - trace.start) * protocol.FRAME_TRACE_RECORD_SIZE]
+        return trace
+
+    async def run_link_stats(self) -> None:
+        """Poll the MCU link counters before their 16-bit values can saturate.
+
+        With serial_auto_baud, a poll window whose corrupted frames exceed
+        SERIAL_RECALIBRATION_ERROR_RATE calibrates the link again.
+        """
+        decode_errors = self.state.serial_decode_errors
+        while True:
+            await asyncio.sleep(self.config.status_interval)
+            if not self.state.is_synchronized:
+                continue
+            stats = await self._poll_link_stats()
+            new_errors = self.state.serial_decode_errors - decode_errors
+            if stats is not None and self._link_degraded(stats, new_errors):
+                logger.warning("Link error rate above %.1f%%", SERIAL_RECALIBRATION_ERROR_RATE * 100)
+                self.state.serial_calibration_due = self.config.serial_auto_baud
+            if self.state.serial_calibration_due:
+                await self._calibrate_baudrate()
+            decode_errors = self.state.serial_decode_errors
+
+    async def _restore_telemetry_jobs(self) -> None:
+        serial = self.serial
+        if not serial:
+            return
+        for job in list(self.state.telemetry_jobs.values()):
+            await serial.send(Command.CMD_TELEMETRY_JOB.value, job)
+
     async def _on_mcu_process_kill(self, seq: int, p: pb.ProcessKill) -> None:
         async with self.state.process_lock:
             ctx = self.state.running_processes.get(p.pid)
@@ -1030,10 +1399,341 @@ class BridgeService:
             case _:
                 return
 
+    @staticmethod
+    def _i2c_register_batches(req: pb.I2cReadRegisters) -> list[pb.I2cReadRegisters]:
+        """Split a register batch into CMD_I2C_READ_REGISTERS frames."""
+        batches: list[pb.I2cReadRegisters] = []
+        pending: list[pb.I2cRegisterRead] = []
+        size = 0
+        for read in req.reads:
+            if pending and (
+                len(pending) == protocol.I2C_BATCH_MAX_READS or size + read.len > protocol.I2C_BATCH_MAX_BYTES
+            ):
+                batches.append(pb.I2cReadRegisters(address=req.address, reg_bytes=req.reg_bytes, reads=pending))
+                pending, size = [], 0
+            pending.append(read)
+            size += read.len
+        if pending:
+            batches.append(pb.I2cReadRegisters(address=req.address, reg_bytes=req.reg_bytes, reads=pending))
+        return batches
+
+    async def _i2c_burst(self, burst: pb.I2cBurst) -> pb.I2cTransferResponse:
+        """Read a block larger than one frame as a chain of held transfers."""
+        serial = self.serial
+        result = pb.I2cTransferResponse(status=pb.I2C_OK)
+        write = burst.write
+        remaining = burst.length
+        while serial and (remaining or write):
+            n = min(remaining, protocol.I2C_TRANSFER_MAX_BYTES)
+            remaining -= n
+            res = await serial.send(
+                Command.CMD_I2C_TRANSFER.value,
+                pb.I2cTransfer(address=burst.address, write=write, read_len=n, hold=remaining > 0),
+            )
+            if not isinstance(res, bytes):
+                result.status = pb.I2C_BUS_ERROR
+                break
+            part = pb.I2cTransferResponse.FromString(res)
+            result.data += part.data
+            if part.status != pb.I2C_OK:
+                result.status = part.status
+                break
+            write = b""
+        return result
+
+    async def _handle_i2c(self, route: TopicRoute, inbound: BridgeRequest) -> None:
+        serial = self.serial
+        if not serial:
+            return
+        try:
+            match route.identifier:
+                case I2CAction.BEGIN:
+                    await serial.send(Command.CMD_I2C_BEGIN.value, pb.I2cConfig.FromString(inbound.payload))
+                case I2CAction.END:
+                    await serial.send(Command.CMD_I2C_END.value, b"")
+                case I2CAction.TRANSFER:
+                    res = await serial.send(
+                        Command.CMD_I2C_TRANSFER.value, pb.I2cTransfer.FromString(inbound.payload)
+                    )
+                    if isinstance(res, bytes):
+                        await self._publish_i2c(pb.I2cTransferResponse.FromString(res), inbound)
+                case I2CAction.REGISTERS:
+                    merged = pb.I2cReadRegistersResponse(status=pb.I2C_OK)
+                    for batch in self._i2c_register_batches(pb.I2cReadRegisters.FromString(inbound.payload)):
+                        res = await serial.send(Command.CMD_I2C_READ_REGISTERS.value, batch)
+                        if not isinstance(res, bytes):
+                            merged.status = pb.I2C_BUS_ERROR
+                            break
+                        part = pb.I2cReadRegistersResponse.FromString(res)
+                        merged.completed += part.completed
+                        merged.data += part.data
+                        if part.status != pb.I2C_OK:
+                            merged.status = part.status
+                            break
+                    await self._publish_i2c(merged, inbound)
+                case I2CAction.BURST:
+                    result = await self._i2c_burst(pb.I2cBurst.FromString(inbound.payload))
+                    await self._publish_i2c(
+                        result,
+                        inbound,
+                        topic_path(
+                            self.state.cloud_topic_prefix,
+                            Topic.I2C,
+                            I2CAction.BURST,
+                            protocol.CLOUD_SUFFIX_RESPONSE,
+                        ),
+                    )
+                case _:
+                    return
+        except (ProtobufDecodeError, TypeError, ValueError) as exc:
+            logger.error("I2C request error: %s", exc)
+
+    async def _publish_i2c(self, msg: ProtobufMessage, inbound: BridgeRequest, topic: str | None = None) -> None:
+        await self.enqueue_cloud(
+            create_queued_publish(
+                topic or get_topic_for_message(self.state.cloud_topic_prefix, msg) or "",
+                msg.SerializeToString(),
+                content_type=PROTOBUF_CONTENT_TYPE,
+            ),
+            reply_context=inbound,
+        )
+
+    async def _handle_stream(self, route: TopicRoute, inbound: BridgeRequest) -> None:
+        serial = self.serial
+        if not serial:
+            return
+        match route.identifier:
+            case StreamAction.START:
+                try:
+                    cfg = pb.StreamConfig.FromString(inbound.payload)
+                except (ProtobufDecodeError, TypeError, ValueError) as exc:
+                    logger.error("Stream config error: %s", exc)
+                    return
+                self.state.stream_config = cfg
+                await serial.send(Command.CMD_STREAM_START.value, cfg)
+            case StreamAction.STOP:
+                self.state.stream_config = None
+                await serial.send(Command.CMD_STREAM_STOP.value, b"")
+            case StreamAction.AGGREGATE:
+                try:
+                    agg = pb.AggregateConfig.FromString(inbound.payload)
+                except (ProtobufDecodeError, TypeError, ValueError) as exc:
+                    logger.error("Aggregate config error: %s", exc)
+                    return
+                self.state.aggregate_config = agg if agg.channel_mask else None
+                await serial.send(Command.CMD_AGGREGATE_CONFIG.value, agg)
+            case _:
+                return
+
+    async def _handle_reflex(self, route: TopicRoute, inbound: BridgeRequest) -> None:
+        serial = self.serial
+        if not serial or route.identifier != ReflexAction.RULE:
+            return
+        try:
+            rule = pb.ReflexRule.FromString(inbound.payload)
+        except (ProtobufDecodeError, TypeError, ValueError) as exc:
+            logger.error("Reflex rule error: %s", exc)
+            return
+        if rule.trigger == pb.REFLEX_TRIGGER_NONE:
+            self.state.reflex_rules.pop(rule.rule_id, None)
+        else:
+            self.state.reflex_rules[rule.rule_id] = rule
+        await serial.send(Command.CMD_REFLEX_RULE.value, rule)
+
+    async def _handle_schedule(self, route: TopicRoute, inbound: BridgeRequest) -> None:
+        serial = self.serial
+        if not serial or route.identifier != ScheduleAction.GPIO:
+            return
+        try:
+            req = pb.ScheduleRequest.FromString(inbound.payload)
+        except (ProtobufDecodeError, TypeError, ValueError) as exc:
+            logger.error("Schedule request error: %s", exc)
+            return
+        now_us = time.monotonic_ns() // 1000
+        if req.execute_at_unix_us:
+            at_us = now_us + req.execute_at_unix_us - time.time_ns() // 1000
+        else:
+            at_us = now_us + req.delay_us
+        mcu_at = self.state.mcu_clock.to_mcu(at_us)
+        if mcu_at is None:
+            logger.error("Schedule request dropped: MCU clock not synchronized")
+            return
+        cmd = pb.ScheduleGpio()
+        cmd.CopyFrom(req.command)
+        cmd.execute_at_us = mcu_at
+        await serial.send(Command.CMD_SCHEDULE_GPIO.value, cmd)
+
+    @staticmethod
+    def _waveform_chunks(program: pb.WaveformLoad) -> list[pb.WaveformLoad]:
+        """Split a cloud-side program into CMD_WAVEFORM_LOAD frames."""
+        chunks: list[pb.WaveformLoad] = []
+        offset = 0
+        pending: list[pb.WaveformStep] = []
+        for step in program.steps:
+            candidate = pb.WaveformLoad(offset=offset, steps=[*pending, step])
+            if len(candidate.steps) > protocol.WAVEFORM_LOAD_MAX_STEPS or (
+                candidate.ByteSize() > protocol.MAX_PAYLOAD_SIZE
+            ):
+                chunks.append(pb.WaveformLoad(offset=offset, steps=pending))
+                offset += len(pending)
+                pending = [step]
+            else:
+                pending.append(step)
+        if pending:
+            chunks.append(pb.WaveformLoad(offset=offset, steps=pending))
+            offset += len(pending)
+        duty = program.duty
+        while duty:
+            n = protocol.WAVEFORM_LOAD_MAX_DUTY
+            while True:
+                chunk = pb.WaveformLoad(
+                    offset=offset,
+                    duty_pin=program.duty_pin,
+                    duty_period_us=program.duty_period_us,
+                    duty=duty[:n],
+                )
+                if chunk.ByteSize() <= protocol.MAX_PAYLOAD_SIZE:
+                    break
+                n -= 1
+            chunks.append(chunk)
+            offset += len(chunk.duty)
+            duty = duty[n:]
+        # An empty program still needs one frame to clear the MCU buffer.
+        return chunks or [pb.WaveformLoad()]
+
+    async def _handle_wave(self, route: TopicRoute, inbound: BridgeRequest) -> None:
+        serial = self.serial
+        if not serial:
+            return
+        match route.identifier:
+            case WaveAction.LOAD:
+                try:
+                    program = pb.WaveformLoad.FromString(inbound.payload)
+                except (ProtobufDecodeError, TypeError, ValueError) as exc:
+                    logger.error("Waveform load error: %s", exc)
+                    return
+                # Loading stops playback on the MCU, so nothing is replayed
+                # until the cloud starts the new program.
+                chunks = self._waveform_chunks(program)
+                self.state.waveform_chunks = chunks
+                self.state.waveform_start = None
+                for chunk in chunks:
+                    if not await serial.send(Command.CMD_WAVEFORM_LOAD.value, chunk):
+                        logger.error("Waveform load refused", offset=chunk.offset)
+                        self.state.waveform_chunks = []
+                        return
+            case WaveAction.START:
+                try:
+                    start = pb.WaveformStart.FromString(inbound.payload)
+                except (ProtobufDecodeError, TypeError, ValueError) as exc:
+                    logger.error("Waveform start error: %s", exc)
+                    return
+                # A finite run may already be over when the link comes back,
+                # so only endless playback is restarted after a reconnect.
+                self.state.waveform_start = start if start.loops == 0 else None
+                await serial.send(Command.CMD_WAVEFORM_START.value, start)
+            case WaveAction.STOP:
+                self.state.waveform_start = None
+                await serial.send(Command.CMD_WAVEFORM_STOP.value, b"")
+            case _:
+                return
+
+    async def _handle_telemetry(self, route: TopicRoute, inbound: BridgeRequest) -> None:
+        serial = self.serial
+        if not serial or route.identifier != TelemetryAction.JOB:
+            return
+        try:
+            job = pb.TelemetryJob.FromString(inbound.payload)
+        except (ProtobufDecodeError, TypeError, ValueError) as exc:
+            logger.error("Telemetry job error: %s", exc)
+            return
+        if job.period_ms:
+            self.state.telemetry_jobs[job.job_id] = job
+        else:
+            self.state.telemetry_jobs.pop(job.job_id, None)
+        await serial.send(Command.CMD_TELEMETRY_JOB.value, job)
+
+    async def _handle_pin_port(self, route: TopicRoute, inbound: BridgeRequest) -> None:
+        serial = self.serial
+        if not serial or route.topic != Topic.DIGITAL:
+            return
+        try:
+            if len(route.segments) == 1:
+                await serial.send(
+                    Command.CMD_DIGITAL_WRITE_MASK.value,
+                    pb.DigitalWriteMask.FromString(inbound.payload),
+                )
+            elif route.segments[1] == PinAction.READ:
+                res = await serial.send(
+                    Command.CMD_DIGITAL_READ_PORT.value,
+                    pb.DigitalReadPort.FromString(inbound.payload),
+                )
+                if isinstance(res, bytes):
+                    res = pb.DigitalReadPortResponse.FromString(res)
+                if isinstance(res, pb.DigitalReadPortResponse):
+                    await self.enqueue_cloud(
+                        create_queued_publish(
+                            topic_path(self.state.cloud_topic_prefix, Topic.DIGITAL, PinAction.PORT, "value"),
+                            res.SerializeToString(),
+                            content_type=PROTOBUF_CONTENT_TYPE,
+                            message_expiry_interval=protocol.CLOUD_EXPIRY_PIN,
+                        ),
+                        reply_context=inbound,
+                    )
+        except (ProtobufDecodeError, TypeError, ValueError) as exc:
+            logger.error("Digital port request error: %s", exc)
+
+    async def _handle_pin_batch(self, route: TopicRoute, inbound: BridgeRequest) -> None:
+        serial = self.serial
+        if not serial or route.topic != Topic.DIGITAL:
+            return
+        try:
+            batch = pb.GpioBatch.FromString(inbound.payload)
+        except (ProtobufDecodeError, TypeError, ValueError) as exc:
+            logger.error("GPIO batch error: %s", exc)
+            return
+        # Splitting would break atomicity, so oversized batches are refused.
+        if len(batch.ops) > protocol.GPIO_BATCH_MAX_OPS or batch.ByteSize() > protocol.MAX_PAYLOAD_SIZE:
+            logger.error("GPIO batch too large", ops=len(batch.ops), size=batch.ByteSize())
+            return
+        # The batch is authorized as a digital write; pin-mode ops also need "mode".
+        auth = self.state.topic_authorization
+        if any(op.op == pb.GPIO_OP_PIN_MODE for op in batch.ops) and not (
+            auth and allows_topic(auth, Topic.DIGITAL.value, PinAction.MODE)
+        ):
+            await self._reject_cloud(inbound, Topic.DIGITAL, PinAction.MODE)
+            return
+        await serial.send(Command.CMD_GPIO_BATCH.value, batch)
+
+    async def _handle_pin_subscribe(self, pin: int, pl: str) -> None:
+        serial = self.serial
+        if not serial:
+            return
+        # Payload: "<rising|falling|change|none> [debounce_ms]".
+        parts = pl.split()
+        try:
+            edge = pb.PinEdge.Value(f"PIN_EDGE_{parts[0].upper()}") if parts else pb.PIN_EDGE_CHANGE
+            debounce_ms = int(parts[1]) if len(parts) > 1 else 0
+        except ValueError as exc:
+            logger.error("Invalid pin subscription payload", payload=pl, error=str(exc))
+            return
+        sub = pb.PinSubscribe(pin=pin, edge=edge, debounce_ms=max(0, debounce_ms))
+        if edge == pb.PIN_EDGE_NONE:
+            self.state.pin_subscriptions.pop(pin, None)
+        else:
+            self.state.pin_subscriptions[pin] = sub
+        await serial.send(Command.CMD_PIN_SUBSCRIBE.value, sub)
+
     async def _handle_pin(self, route: TopicRoute, inbound: BridgeRequest) -> None:
         serial = self.serial
         if not serial:
             return
+        if route.segments[0] == PinAction.PORT:
+            await self._handle_pin_port(route, inbound)
+            return
+        if route.segments[0] == PinAction.BATCH:
+            await self._handle_pin_batch(route, inbound)
+            return
         pin = self._parse_pin(route.segments[0])
         if pin < 0:
             return
@@ -1041,6 +1741,8 @@ class BridgeService:
         if len(route.segments) == 2:
             if route.segments[1] == PinAction.MODE:
                 await serial.send(Command.CMD_SET_PIN_MODE.value, pb.PinMode(pin=pin, mode=cast(Any, int(pl))))
+            elif route.segments[1] == PinAction.SUBSCRIBE and route.topic == Topic.DIGITAL:
+                await self._handle_pin_subscribe(pin, pl)
             elif route.segments[1] == PinAction.READ:
                 cmd = Command.CMD_DIGITAL_READ if route.topic == Topic.DIGITAL else Command.CMD_ANALOG_READ
                 q = (
@@ -1096,6 +1798,61 @@ class BridgeService:
                             ),
                             reply_context=inbound,
                         )
+            case SystemAction.MEMORY_PROFILE if "get" in route.segments:
+                res = await serial.send(Command.CMD_GET_MEMORY_PROFILE.value, b"")
+                if isinstance(res, bytes):
+                    res = pb.MemoryProfile.FromString(res)
+                if isinstance(res, pb.MemoryProfile):
+                    await self.enqueue_cloud(
+                        create_queued_publish(
+                            get_topic_for_message(self.state.cloud_topic_prefix, res) or "",
+                            res.SerializeToString(),
+                            content_type=PROTOBUF_CONTENT_TYPE,
+                        ),
+                        reply_context=inbound,
+                    )
+            case SystemAction.LOOP_PROFILE if "get" in route.segments:
+                # One LoopProfile per phase; the phase field tells them apart.
+                # A "reset" payload clears each histogram as it is read.
+                reset = inbound.payload.strip().lower() == b"reset"
+                for phase in pb.LoopPhase.values():
+                    res = await serial.send(
+                        Command.CMD_GET_LOOP_PROFILE.value,
+                        pb.LoopProfileQuery(phase=phase, reset=reset),
+                    )
+                    if not isinstance(res, bytes):
+                        break  # Profiler compiled out or link lost.
+                    prof = pb.LoopProfile.FromString(res)
+                    await self.enqueue_cloud(
+                        create_queued_publish(
+                            get_topic_for_message(self.state.cloud_topic_prefix, prof) or "",
+                            prof.SerializeToString(),
+                            content_type=PROTOBUF_CONTENT_TYPE,
+                        ),
+                        reply_context=inbound,
+                    )
+            case SystemAction.LINK_STATS if "get" in route.segments:
+                await self._refresh_link_stats()
+                totals = self.state.serial_flow_stats.mcu
+                await self.enqueue_cloud(
+                    create_queued_publish(
+                        get_topic_for_message(self.state.cloud_topic_prefix, totals) or "",
+                        totals.SerializeToString(),
+                        content_type=PROTOBUF_CONTENT_TYPE,
+                    ),
+                    reply_context=inbound,
+                )
+            case SystemAction.FRAME_TRACE if "get" in route.segments:
+                trace = await self._read_frame_trace()
+                if trace is not None:
+                    await self.enqueue_cloud(
+                        create_queued_publish(
+                            get_topic_for_message(self.state.cloud_topic_prefix, trace) or "",
+                            trace.SerializeToString(),
+                            content_type=PROTOBUF_CONTENT_TYPE,
+                        ),
+                        reply_context=inbound,
+                    )
             case SystemAction.VERSION if "get" in route.segments:
                 await self._request_mcu_version(inbound)
             case SystemAction.BRIDGE:
@@ -1354,6 +2111,9 @@ class BridgeService:
                     )
                 )
 
+                tg.create_task(self.supervise("clock-sync", self.run_clock_sync))
+                tg.create_task(self.supervise("link-stats", self.run_link_stats))
+
                 # 4. Optional Features
                 if self.config.bridge_summary_interval > 0.0 or self.config.bridge_handshake_interval > 0.0:
                     tg.create_task(
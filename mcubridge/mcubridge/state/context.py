@@ -31,6 +31,7 @@ from ..protocol import protocol
 from ..protocol.protocol import (
     DEFAULT_RETRY_LIMIT,
     Status,
+    response_to_request,
 )
 from ..protocol.structures import (
     PendingPinRequest,
@@ -52,6 +53,7 @@ def _make_cloud_publish_queue(maxsize: int = 0) -> asyncio.Queue[pb.CloudQueuedP
 
 
 __all__: Final[tuple[str, ...]] = (
+    "McuClock",
     "RuntimeState",
     "PendingPinRequest",
     "create_runtime_state",
@@ -68,6 +70,95 @@ class ProcessContext:
         self.exit_code = 0
 
 
+def _command_label(command_id: int) -> str:
+    for enum in (protocol.Command, protocol.Status):
+        try:
+            return enum(command_id).name
+        except ValueError:
+            continue
+    return f"0x{command_id:02X}"
+
+
+def _wrapped_us(delta: int) -> int:
+    """Signed difference of two ``micros()`` values across the 32-bit wrap."""
+    return (delta + (1 << 31)) % (1 << 32) - (1 << 31)
+
+
+class McuClock:
+    """Maps daemon monotonic time onto the MCU ``micros()`` clock.
+
+    Each CMD_CLOCK_SYNC burst yields NTP-style samples (t1 sent, MCU receive,
+    MCU transmit, t4 received); the one with the smallest round trip gives the
+    offset. Offsets from successive bursts are fitted linearly to estimate the
+    drift of the MCU oscillator, so deadlines between bursts stay accurate.
+    """
+
+    __slots__ = ("_points", "offset_us", "drift_ppm", "rtt_us")
+
+    _WRAP: Final = 1 << 32
+    _POINTS: Final = 8
+
+    def __init__(self) -> None:
+        # (host monotonic us, unwrapped offset us) per accepted burst.
+        self._points: collections.deque[tuple[int, float]] = collections.deque(maxlen=self._POINTS)
+        self.offset_us: float = 0.0
+        self.drift_ppm: float = 0.0
+        self.rtt_us: int = 0
+
+    @property
+    def synced(self) -> bool:
+        return bool(self._points)
+
+    def reset(self) -> None:
+        """Forget the estimate; the MCU clock restarts with every reset."""
+        self._points.clear()
+        self.offset_us, self.drift_ppm, self.rtt_us = 0.0, 0.0, 0
+
+    def add_burst(self, samples: list[tuple[int, int, int, int]]) -> bool:
+        """Fold one burst of ``(t1_us, mcu_rx_us, mcu_tx_us, t4_us)`` samples in."""
+        best: tuple[int, float, int] | None = None
+        for t1, rx, tx, t4 in samples:
+            turnaround = (tx - rx) % self._WRAP
+            rtt = (t4 - t1) - turnaround
+            if rtt < 0:
+                continue
+            # Midpoints of both clocks coincide if the link is symmetric.
+            offset = (rx + turnaround / 2 - (t1 + t4) / 2) % self._WRAP
+            if best is None or rtt < best[0]:
+                best = (rtt, offset, (t1 + t4) // 2)
+        if best is None:
+            return False
+        rtt, offset, host_mid = best
+        if self._points:
+            # Keep offsets continuous across the 71-minute micros() wrap.
+            prev = self._points[-1][1]
+            offset = prev + ((offset - prev + self._WRAP / 2) % self._WRAP - self._WRAP / 2)
+        self._points.append((host_mid, offset))
+        self.rtt_us, self.offset_us = rtt, offset
+        self.drift_ppm = self._fit_drift()
+        return True
+
+    def _fit_drift(self) -> float:
+        if len(self._points) < 2:
+            return 0.0
+        n = len(self._points)
+        mean_t = sum(t for t, _ in self._points) / n
+        mean_o = sum(o for _, o in self._points) / n
+        var = sum((t - mean_t) ** 2 for t, _ in self._points)
+        if var <= 0:
+            return 0.0
+        cov = sum((t - mean_t) * (o - mean_o) for t, o in self._points)
+        return cov / var * 1e6
+
+    def to_mcu(self, host_us: int) -> int | None:
+        """MCU ``micros()`` value expected at daemon monotonic time ``host_us``."""
+        if not self._points:
+            return None
+        t_ref, offset = self._points[-1]
+        offset += (host_us - t_ref) * self.drift_ppm / 1e6
+        return int(round(host_us + offset)) % self._WRAP
+
+
 class RuntimeState:
     """Aggregated mutable state shared across the daemon layers. [SIL-2]"""
 
@@ -122,6 +213,20 @@ class RuntimeState:
         self.pending_analog_reads: collections.deque[PendingPinRequest] = (
             kwargs.get("pending_analog_reads") or collections.deque()
         )
+        # Pin-change subscriptions requested by the cloud, keyed by pin. The MCU
+        # forgets them on link loss, so they are replayed after every handshake.
+        self.pin_subscriptions: dict[int, pb.PinSubscribe] = kwargs.get("pin_subscriptions") or {}
+        # Active sampling stream, restarted on the MCU after every handshake.
+        self.stream_config: pb.StreamConfig | None = kwargs.get("stream_config")
+        self.aggregate_config: pb.AggregateConfig | None = kwargs.get("aggregate_config")
+        # Telemetry job table mirrored by slot id, replayed like the above.
+        self.telemetry_jobs: dict[int, pb.TelemetryJob] = kwargs.get("telemetry_jobs") or {}
+        self.reflex_rules: dict[int, pb.ReflexRule] = kwargs.get("reflex_rules") or {}
+        # Waveform program as the CMD_WAVEFORM_LOAD chunks last sent, and the
+        # endless playback (if any) to restart with it.
+        self.waveform_chunks: list[pb.WaveformLoad] = kwargs.get("waveform_chunks") or []
+        self.waveform_start: pb.WaveformStart | None = kwargs.get("waveform_start")
+        self.mcu_clock: McuClock = kwargs.get("mcu_clock") or McuClock()
 
         self.mailbox_queue_limit: int = kwargs.get("mailbox_queue_limit", DEFAULT_MAILBOX_QUEUE_LIMIT)
         self.mailbox_queue_bytes_limit: int = kwargs.get("mailbox_queue_bytes_limit", DEFAULT_MAILBOX_QUEUE_BYTES_LIMIT)
@@ -178,6 +283,12 @@ class RuntimeState:
 
         self.cloud_dropped_messages: int = kwargs.get("cloud_dropped_messages", 0)
         self.serial_decode_errors: int = kwargs.get("serial_decode_errors", 0)
+        # Link calibration (serial_auto_baud): the rate picked last, the
+        # goodput in bytes/s of every rate that passed, and whether the link
+        # has degraded enough to look again.
+        self.serial_calibrated_baud: int = kwargs.get("serial_calibrated_baud", 0)
+        self.serial_calibration: dict[int, float] = kwargs.get("serial_calibration") or {}
+        self.serial_calibration_due: bool = kwargs.get("serial_calibration_due", False)
         self.handshake_attempts: int = kwargs.get("handshake_attempts", 0)
         self.handshake_successes: int = kwargs.get("handshake_successes", 0)
         self.watchdog_beats: int = kwargs.get("watchdog_beats", 0)
@@ -237,6 +348,59 @@ class RuntimeState:
         """Return the current allowed command list from policy."""
         return tuple(self.allowed_policy.entries)
 
+    def record_mcu_link_stats(self, delta: pb.LinkStats) -> None:
+        """Fold a reset-on-read LinkStats snapshot into the running totals.
+
+        The MCU keeps 16-bit counters and clears them on every poll, so the
+        daemon owns the long-running sums. High-water marks are not reset on
+        the MCU and are kept as maxima instead.
+        """
+        totals = self.serial_flow_stats.mcu
+        for field, value in delta.ListFields():
+            current = getattr(totals, field.name)
+            if field.name.endswith("_peak"):
+                setattr(totals, field.name, max(current, value))
+            else:
+                setattr(totals, field.name, current + value)
+        self.serial_throughput_stats.mcu_frames_sent = totals.tx_frames
+        self.serial_throughput_stats.mcu_frames_received = totals.rx_frames
+
+    @property
+    def frame_timestamps(self) -> bool:
+        """Whether the MCU echoes the timestamps of stamped frames."""
+        caps = self.mcu_capabilities
+        return isinstance(caps, pb.Capabilities) and caps.frame_timestamps
+
+    def record_frame_timing(self, command_id: int, envelope: pb.RpcEnvelope, host_rx_us: int) -> None:
+        """Split the latency of a stamped MCU frame into its one-way legs.
+
+        ``sent_us`` is the MCU clock as the frame left. A reply also echoes
+        the daemon stamp of its request (``echo_us``) and the MCU clock when
+        that request arrived (``echo_rx_us``). The time the request spent on
+        the MCU needs only the MCU clock; the wire legs go through
+        ``mcu_clock`` and wait for the first CMD_CLOCK_SYNC burst.
+        """
+        if not envelope.sent_us:
+            return
+        metrics = self.metrics
+        label = _command_label(response_to_request(command_id) or command_id)
+        if envelope.echo_us:
+            queued = _wrapped_us(envelope.sent_us - envelope.echo_rx_us)
+            metrics.mcu_queue_ms.labels(command=label).observe(max(queued, 0) / 1000)
+        if not self.mcu_clock.synced:
+            return
+        mcu_rx = self.mcu_clock.to_mcu(host_rx_us)
+        if mcu_rx is not None:
+            uplink = _wrapped_us(mcu_rx - envelope.sent_us)
+            metrics.serial_uplink_latency_ms.labels(command=label).observe(max(uplink, 0) / 1000)
+        if envelope.echo_us:
+            # echo_us is our own clock truncated to 32 bits: rebuild the full value.
+            host_tx = host_rx_us - (host_rx_us - envelope.echo_us) % (1 << 32)
+            mcu_tx = self.mcu_clock.to_mcu(host_tx)
+            if mcu_tx is not None:
+                downlink = _wrapped_us(envelope.echo_rx_us - mcu_tx)
+                metrics.serial_downlink_latency_ms.labels(command=label).observe(max(downlink, 0) / 1000)
+
     def record_supervisor_failure(self, name: str, backoff: float, exc: BaseException | None) -> None:
         """Record an internal service task failure."""
         stats = self.supervisor_stats.setdefault(name, pb.SupervisorSnapshot())
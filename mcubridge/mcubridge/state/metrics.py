@@ -10,6 +10,10 @@ from prometheus_client import (
     Info,
 )
 
+# Single serial frames take well under a millisecond at 1 Mbaud and tens of
+# milliseconds at 9600 baud.
+_ONE_WAY_BUCKETS_MS = (0.1, 0.25, 0.5, 1, 2.5, 5, 10, 25, 50, 100)
+
 
 class DaemonMetrics:
     """Formal metrics container using prometheus_client primitives."""
@@ -85,6 +89,30 @@ class DaemonMetrics:
             buckets=(5, 10, 25, 50, 100, 250, 500, 1000, 2500, 5000),
             registry=self.registry,
         )
+        # One-way legs of a stamped frame (Capabilities.frame_timestamps). The
+        # uplink/downlink split relies on the CMD_CLOCK_SYNC offset; the MCU
+        # queue time is measured on the MCU clock alone.
+        self.serial_uplink_latency_ms = Histogram(
+            "mcubridge_serial_uplink_latency_ms",
+            "MCU -> daemon frame latency in milliseconds",
+            labelnames=["command"],
+            buckets=_ONE_WAY_BUCKETS_MS,
+            registry=self.registry,
+        )
+        self.serial_downlink_latency_ms = Histogram(
+            "mcubridge_serial_downlink_latency_ms",
+            "Daemon -> MCU frame latency in milliseconds",
+            labelnames=["command"],
+            buckets=_ONE_WAY_BUCKETS_MS,
+            registry=self.registry,
+        )
+        self.mcu_queue_ms = Histogram(
+            "mcubridge_mcu_queue_ms",
+            "Time from MCU frame receipt to the stamped reply, in milliseconds",
+            labelnames=["command"],
+            buckets=_ONE_WAY_BUCKETS_MS,
+            registry=self.registry,
+        )
         self.rpc_latency_ms = Histogram(
             "mcubridge_rpc_latency_ms",
             "CLOUD -> MCU command round-trip latency in milliseconds",
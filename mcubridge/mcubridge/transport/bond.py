@@ -0,0 +1,96 @@
+"""Frame reordering for bonded serial links.
+
+With serial_bond_ports, the daemon and the MCU stripe frames over several
+UARTs. Every frame carries RpcEnvelope.bond_seq: the low 16 bits of a frame
+counter shared by all links, plus one, so 0 still means "not bonded". A frame
+can overtake the one before it on a less busy link; BondReorder puts them back
+in order before the anti-replay check sees them. It mirrors
+bridge::BondReorder on the MCU.
+"""
+
+from __future__ import annotations
+
+from typing import Generic, TypeVar
+
+from mcubridge.protocol import protocol
+
+T = TypeVar("T")
+
+# Further behind than this, a frame means the sender started over.
+_RESYNC_DISTANCE = 256
+
+
+def _distance(seq: int, base: int) -> int:
+    """How far ``seq`` is ahead of ``base`` (negative: behind), mod 2**16."""
+    delta = (seq - base) & protocol.UINT16_MAX
+    return delta - (protocol.UINT16_MAX + 1) if delta > protocol.UINT16_MAX // 2 else delta
+
+
+class BondReorder(Generic[T]):
+    """Releases items pushed with their bond sequence in sequence order.
+
+    An item that is next in order comes back from push() at once, followed by
+    any held items it unblocks. One that is up to ``window`` items early is
+    held; one already passed is dropped. A gap is given up, and the items
+    after it released, when an item lands past the window or when expire()
+    finds the held items have waited ``gap_timeout`` seconds: the frame was
+    lost on its link and the reliable layer resends it under a new number.
+    """
+
+    def __init__(self, window: int, gap_timeout: float) -> None:
+        self._window = window
+        self._gap_timeout = gap_timeout
+        self._held: dict[int, T] = {}
+        self._next = 0
+        self._wait_since = 0.0
+        self.dropped = 0
+
+    def reset(self) -> None:
+        """Expect bond_seq 1 next, as after a link reset on both ends."""
+        self._held.clear()
+        self._next = 0
+
+    @property
+    def held(self) -> int:
+        return len(self._held)
+
+    def push(self, bond_seq: int, item: T, now: float) -> list[T]:
+        seq = (bond_seq - 1) & protocol.UINT16_MAX
+        ahead = _distance(seq, self._next)
+        if -_RESYNC_DISTANCE < ahead < 0 or (ahead > 0 and seq in self._held):
+            self.dropped += 1
+            return []
+        ready: list[T] = []
+        if ahead < 0 or ahead >= self._window:
+            ready.extend(self._flush())
+            self._next = seq
+        elif ahead > 0:
+            if not self._held:
+                self._wait_since = now
+            self._held[seq] = item
+            return []
+        ready.append(item)
+        self._next = (self._next + 1) & protocol.UINT16_MAX
+        ready.extend(self._release())
+        return ready
+
+    def expire(self, now: float) -> list[T]:
+        """Skip a gap the held items have waited on for too long."""
+        if not self._held or now - self._wait_since < self._gap_timeout:
+            return []
+        while self._next not in self._held:
+            self._next = (self._next + 1) & protocol.UINT16_MAX
+        self._wait_since = now
+        return self._release()
+
+    def _release(self) -> list[T]:
+        ready: list[T] = []
+        while self._next in self._held:
+            ready.append(self._held.pop(self._next))
+            self._next = (self._next + 1) & protocol.UINT16_MAX
+        return ready
+
+    def _flush(self) -> list[T]:
+        ready = [self._held[seq] for seq in sorted(self._held, key=lambda s: _distance(s, self._next))]
+        self._held.clear()
+        return ready
@@ -15,7 +15,10 @@ from __future__ import annotations
 from mcubridge.protocol import mcubridge_pb2 as pb
 
 import asyncio
+import contextlib
 import logging
+import time
+from collections.abc import Sequence
 from typing import TYPE_CHECKING, Any
 
 from cobs import cobsr
@@ -26,6 +29,9 @@ from google.protobuf.message import Message as ProtobufMessage, DecodeError as P
 
 from mcubridge.config.const import (
     SERIAL_BAUDRATE_NEGOTIATION_TIMEOUT,
+    SERIAL_BAUDRATE_SETTLE_SECONDS,
+    SERIAL_BOND_GAP_TIMEOUT,
+    SERIAL_BOND_REORDER_WINDOW,
     SERIAL_HANDSHAKE_BACKOFF_BASE,
     SERIAL_HANDSHAKE_BACKOFF_MAX,
     SERIAL_FAILURE_STATUS_CODES,
@@ -40,7 +46,7 @@ from mcubridge.protocol.protocol import (
     expected_responses,
     response_to_request,
 )
-from mcubridge.protocol.frame import build_frame, parse_frame
+from mcubridge.protocol.frame import DecodedFrame, build_frame, parse_frame
 from mcubridge.protocol.structures import (
     PendingCommand,
 )
@@ -49,6 +55,7 @@ from mcubridge.security.security import (
     validate_nonce_counter,
 )
 from mcubridge.services.handshake import SerialHandshakeFatal
+from mcubridge.transport.bond import BondReorder
 
 if TYPE_CHECKING:
     from mcubridge.config.settings import RuntimeConfig
@@ -58,6 +65,11 @@ if TYPE_CHECKING:
 logger = structlog.get_logger("mcubridge.serial")
 
 
+def _host_stamp_us() -> int:
+    """Monotonic clock for RpcEnvelope.sent_us; 0 would mean "not stamped"."""
+    return ((time.monotonic_ns() // 1000) & 0xFFFFFFFF) or 1
+
+
 class SerialTransport:
     """High-performance asyncio serial transport with flattened pipeline. [SIL-2]"""
 
@@ -75,12 +87,27 @@ class SerialTransport:
         self._stop_event = asyncio.Event()
         self._negotiating = False
         self._negotiation_future: asyncio.Future[bool] | None = None
+        self._negotiation_baud = 0
+        self._baudrate = 0
         self._consecutive_crc_errors = 0
         self._tx_sequence_id = 0
 
         self._current: PendingCommand | None = None
         self._flow_lock = asyncio.Lock()
 
+        # Bonded links (serial_bond_ports), besides self.serial. Frames go
+        # out round-robin numbered by _bond_tx_seq; MCU frames come back
+        # through _bond_rx as (frame, encoded size, host rx time).
+        self._read_task: asyncio.Task[None] | None = None
+        self._bond_stack: contextlib.AsyncExitStack | None = None
+        self._bond_links: list[serialx.AsyncSerial] = []
+        self._bond_read_tasks: list[asyncio.Task[None]] = []
+        self._bond_tx_seq = 0
+        self._bond_rx: BondReorder[tuple[DecodedFrame, int, int]] = BondReorder(
+            SERIAL_BOND_REORDER_WINDOW, SERIAL_BOND_GAP_TIMEOUT
+        )
+        self._bond_expiry: asyncio.Task[None] | None = None
+
         self._ack_timeout = max(self.config.serial_retry_timeout or 0, SERIAL_MIN_ACK_TIMEOUT)
         self._response_timeout = max(self.config.serial_response_timeout or 0, self._ack_timeout)
         self._max_attempts = max(1, self.config.serial_retry_attempts or 1)
@@ -95,10 +122,21 @@ class SerialTransport:
             super().__init__(status)
             self.status = status
 
+    @property
+    def baudrate(self) -> int:
+        """Rate both ends of the link currently run at."""
+        return self._baudrate
+
+    @property
+    def bond_links(self) -> int:
+        """UARTs frames are striped over; 1 when not bonded."""
+        return 1 + len(self._bond_links)
+
     def _switch_local_baudrate(self, target_baud: int) -> None:
         try:
             if self.serial:
                 self.serial.transport.serial.baudrate = target_baud
+            self._baudrate = target_baud
             logger.info("Local UART switched to %d baud", target_baud)
         except (AttributeError, OSError, ValueError, serialx.SerialException) as e:
             raise RuntimeError(f"UART access failed: {e}") from e
@@ -127,6 +165,9 @@ class SerialTransport:
     async def _connect_and_run(self) -> None:
         logger.info("Connecting to MCU on %s...", self.config.serial_port)
         connect_baud = self.config.serial_safe_baud or protocol.DEFAULT_SAFE_BAUDRATE
+        # A rate picked by calibration outlives reconnects.
+        target_baud = self.state.serial_calibrated_baud or self.config.serial_baud
+        self._baudrate = connect_baud
         try:
             async with serialx.AsyncSerial(
                 url=self.config.serial_port, baudrate=connect_baud, xonxoff=False
@@ -134,10 +175,9 @@ class SerialTransport:
                 self.state.serial_writer = self.serial.transport
                 await self._toggle_dtr()
                 read_task = asyncio.get_running_loop().create_task(self._read_loop(self.serial))
+                self._read_task = read_task
                 try:
-                    if self.config.serial_baud != connect_baud and not await self._negotiate_baudrate(
-                        self.config.serial_baud
-                    ):
+                    if target_baud != connect_baud and not await self._negotiate_baudrate(target_baud):
                         raise ConnectionError("Baudrate negotiation failed")
                     if self.service:
                         await self.service.on_serial_connected()
@@ -152,11 +192,13 @@ class SerialTransport:
                     if read_task in done:
                         raise ConnectionError("Serial connection lost")
                 finally:
+                    await self.disable_bonding()
                     read_task.cancel()
                     try:
                         await read_task
                     except (asyncio.IncompleteReadError, asyncio.CancelledError):
                         logger.debug("Serial read task cancelled or incomplete during cleanup")
+                    self._read_task = None
                     if self.service:
                         try:
                             await self.service.on_serial_disconnected()
@@ -179,6 +221,64 @@ class SerialTransport:
         if self.serial:
             await self.serial.close()
 
+    async def enable_bonding(self, ports: Sequence[str]) -> int:
+        """Stripe frames over ``ports`` as well as serial_port.
+
+        Each port is opened at serial_baud and read like the main one; the MCU
+        starts striping back over a link once a numbered frame arrives on it.
+        A port that does not open is left out. Returns the number of links,
+        1 if none opened. Losing a bonded port later drops the whole
+        connection, and the next handshake bonds again.
+        """
+        await self.disable_bonding()
+        stack = contextlib.AsyncExitStack()
+        loop = asyncio.get_running_loop()
+        for url in ports:
+            try:
+                link = await stack.enter_async_context(
+                    serialx.AsyncSerial(url=url, baudrate=self.config.serial_baud, xonxoff=False)
+                )
+            except (OSError, ValueError, serialx.SerialException) as exc:
+                logger.error("Unable to open bonded port %s: %s", url, exc)
+                continue
+            task = loop.create_task(self._read_loop(link))
+            task.add_done_callback(self._on_bond_link_lost)
+            self._bond_links.append(link)
+            self._bond_read_tasks.append(task)
+        self._bond_stack = stack
+        self._bond_tx_seq = 0
+        self._bond_rx.reset()
+        return self.bond_links
+
+    async def disable_bonding(self) -> None:
+        """Go back to serial_port alone and close the bonded ports."""
+        links, tasks, stack = self._bond_links, self._bond_read_tasks, self._bond_stack
+        self._bond_links, self._bond_read_tasks, self._bond_stack = [], [], None
+        for task in tasks:
+            task.cancel()
+        for task in tasks:
+            with contextlib.suppress(asyncio.CancelledError, asyncio.IncompleteReadError):
+                await task
+        if self._bond_expiry:
+            self._bond_expiry.cancel()
+            self._bond_expiry = None
+        self._bond_rx.reset()
+        if stack:
+            try:
+                await stack.aclose()
+            except (OSError, RuntimeError, serialx.SerialException) as exc:
+                logger.debug("Error closing bonded ports: %s", exc)
+        if links:
+            logger.info("Serial bonding disabled")
+
+    def _on_bond_link_lost(self, task: asyncio.Task[None]) -> None:
+        # Frames striped to a dead link would be lost one in N: reconnect.
+        if task.cancelled() or task not in self._bond_read_tasks:
+            return
+        logger.error("Bonded serial link lost")
+        if self._read_task:
+            self._read_task.cancel()
+
     async def _read_loop(self, serial: serialx.AsyncSerial) -> None:
         while not self._stop_event.is_set():
             try:
@@ -197,6 +297,7 @@ class SerialTransport:
 
     async def _process_packet(self, encoded_packet: bytes | memoryview) -> None:
         """Processes a packet from the serial stream. [FLATTENED] [SIL-2]"""
+        host_rx_us = time.monotonic_ns() // 1000
         try:
             raw_bytes = encoded_packet.tobytes() if isinstance(encoded_packet, memoryview) else encoded_packet
             decoded = cobsr.decode(raw_bytes)
@@ -207,13 +308,35 @@ class SerialTransport:
             await self._check_baudrate_fallback()
             return
 
+        bond_seq = decoded_frame.envelope.bond_seq
+        if bond_seq and self._bond_links:
+            # Striped frames can overtake each other: restore their order
+            # before the anti-replay check sees them.
+            item = (decoded_frame, len(encoded_packet), host_rx_us)
+            for frame, size, rx_us in self._bond_rx.push(bond_seq, item, time.monotonic()):
+                await self._handle_frame(frame, size, rx_us)
+            if self._bond_rx.held and self._bond_expiry is None:
+                self._bond_expiry = asyncio.get_running_loop().create_task(self._expire_bond_gap())
+            return
+        await self._handle_frame(decoded_frame, len(encoded_packet), host_rx_us)
+
+    async def _expire_bond_gap(self) -> None:
+        try:
+            while self._bond_rx.held:
+                await asyncio.sleep(SERIAL_BOND_GAP_TIMEOUT)
+                for frame, size, rx_us in self._bond_rx.expire(time.monotonic()):
+                    await self._handle_frame(frame, size, rx_us)
+        finally:
+            self._bond_expiry = None
+
+    async def _handle_frame(self, decoded_frame: DecodedFrame, encoded_size: int, host_rx_us: int) -> None:
         envelope = decoded_frame.envelope
         payload = decoded_frame.payload
         cmd_id, seq_id = envelope.command_id, envelope.sequence_id
 
         if self._negotiating and self._negotiation_future and not self._negotiation_future.done():
             if cmd_id == protocol.Command.CMD_SET_BAUDRATE_RESP.value:
-                self._switch_local_baudrate(self.config.serial_baud)
+                self._switch_local_baudrate(self._negotiation_baud)
                 self._negotiation_future.set_result(True)
                 return
 
@@ -228,12 +351,14 @@ class SerialTransport:
                 return
             self.state.link_last_nonce_counter = new_counter
 
+        self.state.record_frame_timing(cmd_id, envelope, host_rx_us)
+
         # Correlation and Service dispatch
         self._correlate_frame(cmd_id, payload)
         if self.service:
             await self.service.handle_mcu_frame(cmd_id, seq_id, payload)
 
-        self.state.metrics.serial_bytes_received.inc(len(encoded_packet))
+        self.state.metrics.serial_bytes_received.inc(encoded_size)
         self.state.metrics.serial_frames_received.inc()
 
     def _correlate_frame(self, command_id: int, payload: bytes | ProtobufMessage) -> None:
@@ -293,8 +418,10 @@ class SerialTransport:
         if self._consecutive_crc_errors >= self.config.serial_fallback_threshold:
             logger.error("Fallback to %d baud", self.config.serial_safe_baud)
             self._consecutive_crc_errors = 0
-            if self.config.serial_baud != self.config.serial_safe_baud:
+            if self._baudrate != self.config.serial_safe_baud:
                 await self._negotiate_baudrate(self.config.serial_safe_baud)
+                # Let the next link-stats poll look for a rate that holds up.
+                self.state.serial_calibration_due = self.config.serial_auto_baud
 
     async def send(
         self, command_id: int, payload: bytes | ProtobufMessage, seq_id: int | None = None
@@ -327,7 +454,7 @@ class SerialTransport:
                     pending.ack_received = False
                     pending.success = None
 
-                    if not await self.send_raw(command_id, payload):
+                    if not await self.send_raw(command_id, payload, seq_id):
                         raise self._FatalSerialError(None)
 
                     try:
@@ -368,6 +495,14 @@ class SerialTransport:
             self._tx_sequence_id = (self._tx_sequence_id + 1) & protocol.UINT16_MAX
             seq_id = self._tx_sequence_id
 
+        writer = self.serial
+        bond_seq = 0
+        if self._bond_links:
+            links = (self.serial, *self._bond_links)
+            writer = links[self._bond_tx_seq % len(links)]
+            bond_seq = self._bond_tx_seq + 1
+            self._bond_tx_seq = (self._bond_tx_seq + 1) & protocol.UINT16_MAX
+
         is_excluded = is_system_command(command_id)
         nonce = b"\x00" * protocol.AEAD_NONCE_SIZE
         if self.state.is_synchronized and not is_excluded:
@@ -381,6 +516,8 @@ class SerialTransport:
                 payload=payload,
                 nonce=nonce,
                 session_key=self.state.link_session_key if self.state.is_synchronized else None,
+                sent_us=_host_stamp_us() if self.state.frame_timestamps else 0,
+                bond_seq=bond_seq,
             )
         )
 
@@ -393,9 +530,9 @@ class SerialTransport:
             )
 
         try:
-            await self.serial.write(encoded)
-            await self.serial.write(protocol.FRAME_DELIMITER)
-            await self.serial.drain()
+            await writer.write(encoded)
+            await writer.write(protocol.FRAME_DELIMITER)
+            await writer.drain()
             self.state.metrics.serial_bytes_sent.inc(len(encoded) + len(protocol.FRAME_DELIMITER))
             self.state.metrics.serial_frames_sent.inc()
             return True
@@ -403,8 +540,9 @@ class SerialTransport:
             logger.error("Serial write failed: %s", exc)
             return False
 
-    async def _negotiate_baudrate(self, target_baud: int) -> bool:
-        payload = pb.SetBaudratePacket(baudrate=target_baud)
+    async def _negotiate_baudrate(self, target_baud: int, confirm_timeout_ms: int = 0) -> bool:
+        payload = pb.SetBaudratePacket(baudrate=target_baud, confirm_timeout_ms=confirm_timeout_ms)
+        self._negotiation_baud = target_baud
         self._negotiating = True
         try:
             self._negotiation_future = asyncio.get_running_loop().create_future()
@@ -420,5 +558,23 @@ class SerialTransport:
         finally:
             self._negotiating = False
 
+    async def switch_baudrate(self, target_baud: int, *, confirm_timeout_ms: int = 0) -> bool:
+        """Move both ends of the link to ``target_baud``.
+
+        With ``confirm_timeout_ms`` the MCU goes back to the current rate
+        unless a valid frame reaches it at the new one in time; see
+        revert_baudrate().
+        """
+        if not await self._negotiate_baudrate(target_baud, confirm_timeout_ms):
+            return False
+        # The MCU switches BAUDRATE_CHANGE_DELAY_MS after its reply.
+        await asyncio.sleep(SERIAL_BAUDRATE_SETTLE_SECONDS)
+        return True
+
+    async def revert_baudrate(self, previous_baud: int, confirm_timeout_ms: int) -> None:
+        """Follow the MCU back to ``previous_baud`` after an unconfirmed switch."""
+        await asyncio.sleep(confirm_timeout_ms / 1000.0 + SERIAL_BAUDRATE_SETTLE_SECONDS)
+        self._switch_local_baudrate(previous_baud)
+
     async def acknowledge(self, command_id: int, seq_id: int, *, status: Status = Status.ACK) -> None:
         await self.send_raw(status.value, pb.AckPacket(command_id=command_id), seq_id)
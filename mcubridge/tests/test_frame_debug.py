@@ -2,7 +2,10 @@
 
 from __future__ import annotations
 
+import struct
+
 import pytest
+from mcubridge.protocol import mcubridge_pb2 as pb
 from mcubridge.protocol.protocol import Command, Status, UINT8_MASK
 from tests.test_constants import TEST_BROKEN_CRC
 
@@ -72,3 +75,27 @@ def test_snapshot_render() -> None:
     assert "CMD_GET_VERSION (0x40)" in rendered
     assert "Payload Length: 5 bytes" in rendered
     assert f"CRC32: 0x{TEST_BROKEN_CRC:08X}" in rendered
+
+
+def test_decode_trace() -> None:
+    def record(t_us: int, cmd: int, seq: int, length: int, direction: int, result: int, state: int) -> bytes:
+        return struct.pack("<IHHBBB", t_us, cmd, seq, length, (direction << 6) | result, state)
+
+    trace = pb.FrameTrace(
+        start=40,
+        end=43,
+        events=record(1000, 0, 0, 0, pb.FRAME_TRACE_EVENT, pb.FRAME_TRACE_BOOT, 0)
+        + record(1500, Command.CMD_GET_VERSION.value, 9, 0, pb.FRAME_TRACE_RX, pb.FRAME_TRACE_OK, 3)
+        + record(1720, 0, 0, 0, pb.FRAME_TRACE_EVENT, pb.FRAME_TRACE_SAFE_STATE, 5),
+    )
+    events = frame_debug.decode_trace(trace)
+    assert [e.index for e in events] == [40, 41, 42]
+    assert events[1].command_id == Command.CMD_GET_VERSION.value
+    assert events[1].sequence_id == 9
+    assert events[1].direction == pb.FRAME_TRACE_RX
+
+    lines = frame_debug.render_trace(trace).splitlines()
+    assert "BOOT" in lines[1]
+    assert "RX CMD_GET_VERSION seq=9" in lines[2]
+    assert "+500us" in lines[2]
+    assert "SAFE_STATE [FAULT]" in lines[3]
@@ -116,8 +116,16 @@ class TestTopicAuthorization:
             ({"digital_write": False}, Topic.DIGITAL.value, "write"),
             ({"digital_read": False}, Topic.DIGITAL.value, "read"),
             ({"digital_mode": False}, Topic.DIGITAL.value, "mode"),
+            ({"digital_subscribe": False}, Topic.DIGITAL.value, "subscribe"),
             ({"analog_write": False}, Topic.ANALOG.value, "write"),
             ({"analog_read": False}, Topic.ANALOG.value, "read"),
+            ({"stream_start": False}, Topic.STREAM.value, "start"),
+            ({"telemetry_job": False}, Topic.TELEMETRY.value, "job"),
+            ({"stream_aggregate": False}, Topic.STREAM.value, "aggregate"),
+            ({"reflex_rule": False}, Topic.REFLEX.value, "rule"),
+            ({"schedule_gpio": False}, Topic.SCHEDULE.value, "gpio"),
+            ({"wave_load": False}, Topic.WAVE.value, "load"),
+            ({"i2c_transfer": False}, Topic.I2C.value, "transfer"),
         ],
     )
     def test_console_and_pin_toggles_respected(self, kwargs: dict[str, bool], topic: str, action: str) -> None:
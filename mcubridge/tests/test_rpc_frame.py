@@ -34,6 +34,12 @@ def test_max_payload_round_trip() -> None:
     assert decoded.payload == payload
 
 
+def test_sent_us_round_trip() -> None:
+    decoded = parse_frame(build_frame(command_id=TEST_CMD_ID, sequence_id=3, payload=b"", sent_us=0xCAFE0001))
+    assert decoded.envelope.sent_us == 0xCAFE0001
+    assert parse_frame(build_frame(command_id=TEST_CMD_ID, sequence_id=3)).envelope.sent_us == 0
+
+
 def test_build_rejects_large_payload() -> None:
     payload = b"a" * (protocol.MAX_PAYLOAD_SIZE + 1)
 
@@ -86,6 +86,8 @@ async def test_mcu_file_read_handler_asserts_state(
     resp = serial.send.call_args[0][1]
     assert isinstance(resp, pb.FileReadResponse)
     assert resp.content == b"file_data"
+    # The MCU matches the response to its request by sequence id.
+    assert serial.send.call_args[0][2] == 1
 
 
 @pytest.mark.asyncio
@@ -218,6 +220,7 @@ async def test_mcu_process_run_asserts_exec(
             resp = serial.send.call_args[0][1]
             assert isinstance(resp, pb.ProcessRunAsyncResponse)
             assert resp.pid == 1234
+            assert serial.send.call_args[0][2] == 1
 
 
 @pytest.mark.asyncio
@@ -5,7 +5,9 @@ from __future__ import annotations
 import time
 
 from mcubridge.config.settings import RuntimeConfig
-from mcubridge.state.context import create_runtime_state
+from mcubridge.protocol import mcubridge_pb2 as pb
+from mcubridge.protocol import protocol
+from mcubridge.state.context import McuClock, create_runtime_state
 
 
 def test_create_runtime_state_initializes_queues(runtime_config: RuntimeConfig) -> None:
@@ -108,3 +110,68 @@ def test_build_metrics_snapshot_includes_spool_state(runtime_config: RuntimeConf
         assert snapshot.cloud_spool_pending_messages == 3
     finally:
         state.cleanup()
+
+
+def test_mcu_clock_offset_drift_and_wrap() -> None:
+    clock = McuClock()
+    assert clock.to_mcu(0) is None
+
+    # MCU runs 1000 us ahead and 50 ppm fast; 400 us symmetric link delay.
+    def mcu(t: int) -> int:
+        return int(t + 1000 + t * 50e-6) % (1 << 32)
+
+    for t in (1_000_000, 11_000_000, 21_000_000):
+        slow = (t, mcu(t + 900), mcu(t + 950), t + 2500)
+        fast = (t, mcu(t + 200), mcu(t + 250), t + 450)
+        assert clock.add_burst([slow, fast])
+    assert clock.rtt_us == 400
+    assert abs(clock.drift_ppm - 50.0) < 1.0
+    target = 31_000_000
+    assert abs(clock.to_mcu(target) - mcu(target)) <= 2  # type: ignore[operator]
+
+    # The estimate stays continuous when micros() wraps.
+    t = (1 << 32) - 1000
+    assert clock.add_burst([(t, mcu(t + 200), mcu(t + 250), t + 450)])
+    assert abs(clock.drift_ppm - 50.0) < 1.0
+
+    clock.reset()
+    assert not clock.synced
+    assert not clock.add_burst([(10, 0, 0, 5)])  # negative RTT is rejected
+
+
+def test_record_frame_timing_splits_one_way_legs(runtime_config: RuntimeConfig) -> None:
+    state = create_runtime_state(runtime_config)
+    try:
+        registry = state.metrics.registry
+        # Replies answer their request: the labels use the request name.
+        labels = {"command": protocol.Command.CMD_GET_LINK_STATS.name}
+        reply = pb.RpcEnvelope(
+            command_id=protocol.Command.CMD_GET_LINK_STATS_RESP.value,
+            sent_us=5_000_300,
+            echo_us=3_999_000,
+            echo_rx_us=5_000_000,
+        )
+
+        # Without a clock estimate only the MCU-side queue time is known.
+        state.record_frame_timing(reply.command_id, reply, 4_001_000)
+        assert registry.get_sample_value("mcubridge_mcu_queue_ms_sum", labels) == 0.3
+        assert registry.get_sample_value("mcubridge_serial_uplink_latency_ms_count", labels) is None
+
+        # MCU clock 1 s ahead: the request took 1 ms, the reply 0.7 ms.
+        assert state.mcu_clock.add_burst([(2_000_000, 3_000_100, 3_000_100, 2_000_200)])
+        state.record_frame_timing(reply.command_id, reply, 4_001_000)
+        assert registry.get_sample_value("mcubridge_serial_downlink_latency_ms_sum", labels) == 1.0
+        assert registry.get_sample_value("mcubridge_serial_uplink_latency_ms_sum", labels) == 0.7
+
+        # echo_us is 32 bits of a host clock that has run past the wrap.
+        wrapped = 1 << 32
+        state.mcu_clock.reset()
+        assert state.mcu_clock.add_burst([(wrapped + 2_000_000, 3_000_100, 3_000_100, wrapped + 2_000_200)])
+        state.record_frame_timing(reply.command_id, reply, wrapped + 4_001_000)
+        assert registry.get_sample_value("mcubridge_serial_downlink_latency_ms_sum", labels) == 2.0
+
+        # Unstamped frames are ignored.
+        state.record_frame_timing(reply.command_id, pb.RpcEnvelope(), 4_001_000)
+        assert registry.get_sample_value("mcubridge_mcu_queue_ms_count", labels) == 3
+    finally:
+        state.cleanup()
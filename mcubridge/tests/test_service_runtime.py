@@ -4,7 +4,9 @@ from __future__ import annotations
 from mcubridge.transport.serial import SerialTransport
 
 import time
-from unittest.mock import AsyncMock, MagicMock
+from collections.abc import Iterator
+from typing import Any
+from unittest.mock import AsyncMock, MagicMock, patch
 
 import pytest
 from mcubridge.config.settings import RuntimeConfig
@@ -198,3 +200,496 @@ async def test_handle_cloud_pin_overflow_reports_error() -> None:
             service.cleanup()
         else:
             state.cleanup()
+
+
+class _PublishPacket:
+    def __init__(self, topic: str, payload: bytes) -> None:
+        self.topic = topic
+        self.payload = payload
+        self.properties = None
+
+
+ServiceWithCapture = tuple[BridgeService, list[pb.CloudQueuedPublish]]
+
+
+@pytest.fixture
+def runtime_service() -> Iterator[ServiceWithCapture]:
+    """A synchronized BridgeService on a mock serial link, with cloud publishes captured."""
+    service = None
+    config = _make_config()
+    state = create_runtime_state(config)
+    captured: list[pb.CloudQueuedPublish] = []
+
+    async def capture_enqueue(message: pb.CloudQueuedPublish, *, reply_context: object | None = None) -> None:
+        del reply_context
+        captured.append(message)
+
+    try:
+        mock_serial = AsyncMock(spec=SerialTransport)
+        mock_serial.send.return_value = True
+        service = BridgeService(config, state, mock_serial)
+        state.state = "synchronized"
+        state.link_sync_event.set()
+        with patch.object(service, "enqueue_cloud", side_effect=capture_enqueue):
+            yield service, captured
+    finally:
+        if service is not None:
+            service.cleanup()
+        else:
+            state.cleanup()
+
+
+def _mock_serial(service: BridgeService) -> AsyncMock:
+    assert isinstance(service.serial, AsyncMock)
+    return service.serial
+
+
+@pytest.mark.asyncio
+async def test_handle_cloud_digital_port_read_publishes_snapshot(runtime_service: ServiceWithCapture) -> None:
+    service, captured = runtime_service
+    mock_serial = _mock_serial(service)
+    mock_serial.send.return_value = pb.DigitalReadPortResponse(mask=0x0F, value=0x05).SerializeToString()
+
+    payload = pb.DigitalReadPort(mask=0x0F).SerializeToString()
+    await service.handle_request(_PublishPacket("br/d/port/read", payload))
+
+    mock_serial.send.assert_called_once()
+    assert mock_serial.send.call_args.args[0] == protocol.Command.CMD_DIGITAL_READ_PORT.value
+    assert captured
+    assert captured[0].topic_name == "br/d/port/value"
+    assert pb.DigitalReadPortResponse.FromString(captured[0].payload).value == 0x05
+
+
+@pytest.mark.asyncio
+async def test_pin_subscription_and_event_fanout(runtime_service: ServiceWithCapture) -> None:
+    service, captured = runtime_service
+    mock_serial = _mock_serial(service)
+
+    await service.handle_request(_PublishPacket("br/d/2/subscribe", b"rising 20"))
+
+    mock_serial.send.assert_called_once()
+    assert mock_serial.send.call_args.args[0] == protocol.Command.CMD_PIN_SUBSCRIBE.value
+    assert service.state.pin_subscriptions[2] == pb.PinSubscribe(pin=2, edge=pb.PIN_EDGE_RISING, debounce_ms=20)
+
+    event = pb.PinEvent(
+        events=[
+            pb.PinEdgeEvent(pin=2, level=1, timestamp_ms=1000),
+            pb.PinEdgeEvent(pin=2, level=0, timestamp_ms=1040),
+        ]
+    )
+    await service.handle_mcu_frame(protocol.Command.CMD_PIN_EVENT.value, 0, event.SerializeToString())
+
+    assert [m.topic_name for m in captured] == ["br/d/2/event", "br/d/2/event"]
+    assert [m.payload for m in captured] == [b"1", b"0"]
+    assert any(prop.key == "bridge-mcu-timestamp-ms" and prop.value == "1040" for prop in captured[1].user_properties)
+
+
+@pytest.mark.asyncio
+async def test_stream_start_stop_and_data_forwarding(runtime_service: ServiceWithCapture) -> None:
+    service, captured = runtime_service
+    mock_serial = _mock_serial(service)
+
+    cfg = pb.StreamConfig(channel_mask=0x3, period_us=1000, batch_scans=8, delta=True)
+    await service.handle_request(_PublishPacket("br/stream/start", cfg.SerializeToString()))
+    assert mock_serial.send.call_args.args[0] == protocol.Command.CMD_STREAM_START.value
+    assert service.state.stream_config == cfg
+
+    data = pb.StreamData(seq=3, start_us=5000, scans=2, samples=b"\x10\x02\x20\x01\x01\xff")
+    await service.handle_mcu_frame(protocol.Command.CMD_STREAM_DATA.value, 0, data.SerializeToString())
+
+    await service.handle_request(_PublishPacket("br/stream/stop", b""))
+    assert mock_serial.send.call_args.args[0] == protocol.Command.CMD_STREAM_STOP.value
+    assert service.state.stream_config is None
+
+    assert [m.topic_name for m in captured] == ["br/stream/data"]
+    assert pb.StreamData.FromString(captured[0].payload) == data
+
+
+@pytest.mark.asyncio
+async def test_aggregate_config_and_report_forwarding(runtime_service: ServiceWithCapture) -> None:
+    service, captured = runtime_service
+    mock_serial = _mock_serial(service)
+
+    agg = pb.AggregateConfig(channel_mask=0x5, sample_period_ms=10, window_ms=1000)
+    await service.handle_request(_PublishPacket("br/stream/aggregate", agg.SerializeToString()))
+    assert mock_serial.send.call_args.args[0] == protocol.Command.CMD_AGGREGATE_CONFIG.value
+    assert service.state.aggregate_config == agg
+
+    report = pb.AggregateReport(
+        channel=2, window_start_ms=4000, count=100, min=480, max=530, mean=505.5, variance=42.25
+    )
+    await service.handle_mcu_frame(protocol.Command.CMD_AGGREGATE_REPORT.value, 0, report.SerializeToString())
+
+    await service.handle_request(_PublishPacket("br/stream/aggregate", pb.AggregateConfig().SerializeToString()))
+    assert service.state.aggregate_config is None
+
+    assert [m.topic_name for m in captured] == ["br/stream/aggregate/value"]
+    assert pb.AggregateReport.FromString(captured[0].payload) == report
+
+
+@pytest.mark.asyncio
+async def test_telemetry_job_config_and_report_fanout(runtime_service: ServiceWithCapture) -> None:
+    service, captured = runtime_service
+    mock_serial = _mock_serial(service)
+
+    job = pb.TelemetryJob(job_id=1, pin=0, analog=True, period_ms=500, deadband=8, heartbeat_ms=60000)
+    await service.handle_request(_PublishPacket("br/telemetry/job", job.SerializeToString()))
+    assert mock_serial.send.call_args.args[0] == protocol.Command.CMD_TELEMETRY_JOB.value
+    assert service.state.telemetry_jobs[1] == job
+
+    report = pb.TelemetryReport(
+        samples=[
+            pb.TelemetrySample(job_id=1, pin=0, analog=True, value=612, timestamp_ms=2000),
+            pb.TelemetrySample(job_id=2, pin=7, analog=False, value=1, timestamp_ms=2010),
+        ]
+    )
+    await service.handle_mcu_frame(protocol.Command.CMD_TELEMETRY_REPORT.value, 0, report.SerializeToString())
+
+    cleared = pb.TelemetryJob(job_id=1)
+    await service.handle_request(_PublishPacket("br/telemetry/job", cleared.SerializeToString()))
+    assert 1 not in service.state.telemetry_jobs
+
+    assert [m.topic_name for m in captured] == ["br/a/0/value", "br/d/7/value"]
+    assert [m.payload for m in captured] == [b"612", b"1"]
+    assert any(prop.key == "bridge-telemetry-job" and prop.value == "2" for prop in captured[1].user_properties)
+
+
+@pytest.mark.asyncio
+async def test_reflex_rule_upload_and_fired_forwarding(runtime_service: ServiceWithCapture) -> None:
+    service, captured = runtime_service
+    mock_serial = _mock_serial(service)
+
+    rule = pb.ReflexRule(
+        rule_id=0,
+        trigger=pb.REFLEX_TRIGGER_PIN_HIGH,
+        pin=2,
+        action=pb.REFLEX_ACTION_DIGITAL_WRITE,
+        out_pin=13,
+        value=0,
+        notify=True,
+    )
+    await service.handle_request(_PublishPacket("br/reflex/rule", rule.SerializeToString()))
+    assert mock_serial.send.call_args.args[0] == protocol.Command.CMD_REFLEX_RULE.value
+    assert service.state.reflex_rules[0] == rule
+
+    fired = pb.ReflexFired(rule_id=0, active=True, timestamp_ms=1234)
+    await service.handle_mcu_frame(protocol.Command.CMD_REFLEX_FIRED.value, 0, fired.SerializeToString())
+
+    removal = pb.ReflexRule(rule_id=0, trigger=pb.REFLEX_TRIGGER_NONE)
+    await service.handle_request(_PublishPacket("br/reflex/rule", removal.SerializeToString()))
+    assert 0 not in service.state.reflex_rules
+
+    assert [m.topic_name for m in captured] == ["br/reflex/fired"]
+    assert pb.ReflexFired.FromString(captured[0].payload) == fired
+
+
+@pytest.mark.asyncio
+async def test_event_batch_fanout(runtime_service: ServiceWithCapture) -> None:
+    service, captured = runtime_service
+
+    batch = pb.EventBatch(
+        events=[
+            pb.SketchEvent(id=3, value=17, timestamp_ms=500),
+            pb.SketchEvent(id=4, value=0, timestamp_ms=501),
+        ],
+        dropped=2,
+    )
+    await service.handle_mcu_frame(protocol.Command.CMD_EVENT_BATCH.value, 0, batch.SerializeToString())
+
+    assert [m.topic_name for m in captured] == ["br/event/3", "br/event/4"]
+    assert [m.payload for m in captured] == [b"17", b"0"]
+    assert any(prop.key == "bridge-mcu-timestamp-ms" and prop.value == "501" for prop in captured[1].user_properties)
+
+
+@pytest.mark.asyncio
+async def test_clock_sync_and_scheduled_gpio(runtime_service: ServiceWithCapture) -> None:
+    service, _ = runtime_service
+    state = service.state
+    mcu_ahead_us = 5_000_000
+
+    async def fake_send(command_id: int, payload: object) -> object:
+        if command_id == protocol.Command.CMD_CLOCK_SYNC.value:
+            assert isinstance(payload, pb.ClockSync)
+            now = (time.monotonic_ns() // 1000 + mcu_ahead_us) & 0xFFFFFFFF
+            return pb.ClockSyncResponse(t1_us=payload.t1_us, mcu_rx_us=now, mcu_tx_us=now).SerializeToString()
+        return True
+
+    mock_serial = _mock_serial(service)
+    mock_serial.send.side_effect = fake_send
+
+    gpio = pb.ScheduleGpio(op=pb.SCHEDULE_OP_DIGITAL_WRITE, pin=13, value=1)
+    request = pb.ScheduleRequest(delay_us=250_000, command=gpio)
+
+    # Without a clock estimate the request cannot be mapped and is dropped.
+    await service.handle_request(_PublishPacket("br/schedule/gpio", request.SerializeToString()))
+    assert mock_serial.send.await_count == 0
+
+    assert await service._sync_mcu_clock()  # pyright: ignore[reportPrivateUsage]
+    assert state.mcu_clock.synced
+    assert mock_serial.send.await_count == protocol.CLOCK_SYNC_BURST
+
+    with patch("time.monotonic_ns", return_value=10_000_000_000):
+        await service.handle_request(_PublishPacket("br/schedule/gpio", request.SerializeToString()))
+    cmd_id, sent = mock_serial.send.call_args.args
+    assert cmd_id == protocol.Command.CMD_SCHEDULE_GPIO.value
+    expected = (10_000_000 + 250_000 + mcu_ahead_us) & 0xFFFFFFFF
+    assert abs(sent.execute_at_us - expected) < 5_000
+    assert sent.pin == 13 and sent.value == 1
+
+    await service.on_serial_disconnected()
+    assert not state.mcu_clock.synced
+
+
+@pytest.mark.asyncio
+async def test_gpio_batch_forwarded_whole_or_refused(runtime_service: ServiceWithCapture) -> None:
+    service, captured = runtime_service
+    mock_serial = _mock_serial(service)
+
+    batch = pb.GpioBatch(
+        ops=[
+            pb.GpioOp(op=pb.GPIO_OP_PIN_MODE, pin=13, value=pb.PIN_OUTPUT),
+            pb.GpioOp(op=pb.GPIO_OP_DIGITAL_WRITE, pin=13, value=1),
+            pb.GpioOp(op=pb.GPIO_OP_ANALOG_WRITE, pin=9, value=128),
+        ]
+    )
+    await service.handle_request(_PublishPacket("br/d/batch", batch.SerializeToString()))
+    mock_serial.send.assert_called_once()
+    cmd_id, sent = mock_serial.send.call_args.args
+    assert cmd_id == protocol.Command.CMD_GPIO_BATCH.value
+    assert sent == batch
+
+    # More ops than the MCU can hold in one frame are not split.
+    mock_serial.send.reset_mock()
+    big = pb.GpioBatch(
+        ops=[pb.GpioOp(op=pb.GPIO_OP_DIGITAL_WRITE, pin=2, value=1)] * (protocol.GPIO_BATCH_MAX_OPS + 1)
+    )
+    await service.handle_request(_PublishPacket("br/d/batch", big.SerializeToString()))
+    mock_serial.send.assert_not_called()
+
+    # Pin-mode ops need the digital "mode" permission on top of "write".
+    assert service.state.topic_authorization is not None
+    service.state.topic_authorization.digital_mode = False
+    captured.clear()
+    await service.handle_request(_PublishPacket("br/d/batch", batch.SerializeToString()))
+    mock_serial.send.assert_not_called()
+    assert pb.StatusReport.FromString(captured[0].payload).status == 403
+
+
+@pytest.mark.asyncio
+async def test_waveform_program_chunked_and_replayed(runtime_service: ServiceWithCapture) -> None:
+    service, _ = runtime_service
+    mock_serial = _mock_serial(service)
+
+    program = pb.WaveformLoad(
+        steps=[pb.WaveformStep(pin=13, value=i & 1, delay_us=1000) for i in range(6)],
+        duty_pin=9,
+        duty_period_us=2000,
+        duty=bytes(range(0, 250, 2)),
+    )
+    await service.handle_request(_PublishPacket("br/wave/load", program.SerializeToString()))
+    sent = [c.args for c in mock_serial.send.call_args_list]
+    assert all(cmd == protocol.Command.CMD_WAVEFORM_LOAD.value for cmd, _ in sent)
+    chunks = [chunk for _, chunk in sent]
+    # Every frame fits the MCU limits and offsets chain without gaps.
+    offset = 0
+    for chunk in chunks:
+        assert chunk.ByteSize() <= protocol.MAX_PAYLOAD_SIZE
+        assert len(chunk.steps) <= protocol.WAVEFORM_LOAD_MAX_STEPS
+        assert len(chunk.duty) <= protocol.WAVEFORM_LOAD_MAX_DUTY
+        assert chunk.offset == offset
+        offset += len(chunk.steps) + len(chunk.duty)
+    assert offset == len(program.steps) + len(program.duty)
+    assert b"".join(c.duty for c in chunks) == program.duty
+
+    mock_serial.send.reset_mock()
+    await service.handle_request(_PublishPacket("br/wave/start", pb.WaveformStart(loops=0).SerializeToString()))
+    mock_serial.send.assert_called_once_with(protocol.Command.CMD_WAVEFORM_START.value, pb.WaveformStart(loops=0))
+
+    # The program and endless playback come back after a reconnect.
+    mock_serial.send.reset_mock()
+    await service._restore_waveform()
+    replayed = [c.args[0] for c in mock_serial.send.call_args_list]
+    assert replayed == [protocol.Command.CMD_WAVEFORM_LOAD.value] * len(chunks) + [
+        protocol.Command.CMD_WAVEFORM_START.value
+    ]
+
+    mock_serial.send.reset_mock()
+    await service.handle_request(_PublishPacket("br/wave/stop", b""))
+    mock_serial.send.assert_called_once_with(protocol.Command.CMD_WAVEFORM_STOP.value, b"")
+    assert service.state.waveform_start is None
+
+
+@pytest.mark.asyncio
+async def test_memory_profile_published_as_protobuf(runtime_service: ServiceWithCapture) -> None:
+    service, published = runtime_service
+    profile = pb.MemoryProfile(ram_size=2048, bss_size=900, stack_peak=412, stack_headroom=180, tx_queue_peak=3)
+    mock_serial = _mock_serial(service)
+    mock_serial.send.return_value = profile.SerializeToString()
+
+    await service.handle_request(_PublishPacket("br/system/memory_profile/get", b""))
+    mock_serial.send.assert_called_once_with(protocol.Command.CMD_GET_MEMORY_PROFILE.value, b"")
+    assert published[0].topic_name.endswith("system/memory_profile/value")
+    assert pb.MemoryProfile.FromString(published[0].payload) == profile
+
+
+@pytest.mark.asyncio
+async def test_loop_profile_reads_every_phase(runtime_service: ServiceWithCapture) -> None:
+    service, published = runtime_service
+    buckets = [0] * protocol.LOOP_PROFILE_BUCKETS
+    buckets[3] = 7
+
+    async def reply(command_id: int, query: pb.LoopProfileQuery) -> bytes:
+        assert command_id == protocol.Command.CMD_GET_LOOP_PROFILE.value
+        assert query.reset
+        return pb.LoopProfile(phase=query.phase, samples=7, max_us=12, buckets=buckets).SerializeToString()
+
+    _mock_serial(service).send.side_effect = reply
+
+    await service.handle_request(_PublishPacket("br/system/loop_profile/get", b"reset"))
+    assert len(published) == len(pb.LoopPhase.values())
+    assert all(p.topic_name.endswith("system/loop_profile/value") for p in published)
+    phases = [pb.LoopProfile.FromString(p.payload).phase for p in published]
+    assert phases == list(pb.LoopPhase.values())
+    assert list(pb.LoopProfile.FromString(published[0].payload).buckets) == buckets
+
+
+@pytest.mark.asyncio
+async def test_link_stats_accumulated_across_polls(runtime_service: ServiceWithCapture) -> None:
+    service, published = runtime_service
+    polls = [
+        pb.LinkStats(rx_frames=100, tx_frames=90, rx_malformed=2, tx_queue_peak=3, serial_rx_peak=40),
+        pb.LinkStats(rx_frames=50, tx_frames=60, tx_retransmits=1, tx_queue_peak=2, serial_rx_peak=55),
+    ]
+
+    async def reply(command_id: int, query: pb.LinkStatsQuery) -> bytes:
+        assert command_id == protocol.Command.CMD_GET_LINK_STATS.value
+        assert query.reset
+        return polls.pop(0).SerializeToString()
+
+    _mock_serial(service).send.side_effect = reply
+
+    assert await service._refresh_link_stats()
+    await service.handle_request(_PublishPacket("br/system/link_stats/get", b""))
+
+    totals = pb.LinkStats.FromString(published[0].payload)
+    assert published[0].topic_name.endswith("system/link_stats/value")
+    assert totals.rx_frames == 150
+    assert totals.tx_frames == 150
+    assert totals.rx_malformed == 2
+    assert totals.tx_retransmits == 1
+    # High-water marks keep the maximum instead of summing.
+    assert totals.tx_queue_peak == 3
+    assert totals.serial_rx_peak == 55
+    assert service.state.serial_throughput_stats.mcu_frames_received == 150
+    assert service.state.serial_throughput_stats.mcu_frames_sent == 150
+
+
+@pytest.mark.asyncio
+async def test_frame_trace_read_in_chunks(runtime_service: ServiceWithCapture) -> None:
+    service, published = runtime_service
+    size = protocol.FRAME_TRACE_RECORD_SIZE
+    chunk = protocol.FRAME_TRACE_CHUNK_RECORDS
+    # Events 20..29 kept; every query adds two (its RX and TX).
+    ring = {"start": 20, "end": 30}
+
+    async def reply(command_id: int, query: pb.FrameTraceQuery) -> bytes:
+        assert command_id == protocol.Command.CMD_GET_FRAME_TRACE.value
+        first = max(query.start, ring["start"])
+        last = min(first + chunk, ring["end"])
+        resp = pb.FrameTrace(
+            start=first,
+            end=ring["end"],
+            events=b"".join(bytes([n]) * size for n in range(first, last)),
+        )
+        ring["start"] += 2
+        ring["end"] += 2
+        return resp.SerializeToString()
+
+    _mock_serial(service).send.side_effect = reply
+
+    await service.handle_request(_PublishPacket("br/system/frame_trace/get", b""))
+
+    assert published[0].topic_name.endswith("system/frame_trace/value")
+    trace = pb.FrameTrace.FromString(published[0].payload)
+    # The dump's own frames, recorded after the first reply, are left out.
+    assert (trace.start, trace.end) == (20, 30)
+    assert trace.events == b"".join(bytes([n]) * size for n in range(20, 30))
+
+
+@pytest.mark.asyncio
+async def test_baudrate_calibration_keeps_fastest_reliable_rate(runtime_service: ServiceWithCapture) -> None:
+    from types import SimpleNamespace
+    from unittest.mock import PropertyMock
+
+    import mcubridge.services.runtime as runtime_module
+
+    service, _ = runtime_service
+    state = service.state
+    service.config.serial_baud = 500000
+    service.config.serial_safe_baud = 115200
+
+    link = {"baud": 115200, "now": 0.0}
+    reliable = {115200, 230400, 250000, 500000}
+    switches: list[tuple[int, int]] = []
+    mock_serial = _mock_serial(service)
+    type(mock_serial).baudrate = PropertyMock(side_effect=lambda: link["baud"])
+
+    async def switch(target: int, *, confirm_timeout_ms: int = 0) -> bool:
+        switches.append((target, confirm_timeout_ms))
+        link["baud"] = target
+        return True
+
+    async def reply(command_id: int, msg: Any) -> bytes | bool:
+        if command_id == protocol.Command.CMD_GET_LINK_STATS.value:
+            return pb.LinkStats(rx_frames=17).SerializeToString()
+        assert command_id == protocol.Command.CMD_LINK_PROBE.value
+        link["now"] += 100.0 / link["baud"]
+        if link["baud"] not in reliable:
+            return False
+        return pb.LinkProbe(pattern=msg.pattern).SerializeToString()
+
+    mock_serial.switch_baudrate.side_effect = switch
+    mock_serial.send.side_effect = reply
+
+    fake_time = SimpleNamespace(monotonic=lambda: link["now"])
+    with patch.object(runtime_module, "time", fake_time):
+        assert await service._calibrate_baudrate() == 500000
+
+    # 460800 fails and the link steps back to the last good rate before
+    # 500000 is tried; rates above serial_baud are never touched.
+    assert switches == [(230400, 1000), (250000, 1000), (460800, 1000), (250000, 0), (500000, 1000)]
+    assert sorted(state.serial_calibration) == [115200, 230400, 250000, 500000]
+    assert state.serial_calibrated_baud == 500000
+    assert not state.serial_calibration_due
+
+    # Error rates only count once a poll window has enough frames.
+    assert service._link_degraded(pb.LinkStats(rx_frames=90, tx_frames=60, rx_malformed=1), 1)
+    assert not service._link_degraded(pb.LinkStats(rx_frames=90, tx_frames=60, rx_malformed=1), 0)
+    assert not service._link_degraded(pb.LinkStats(rx_frames=20, tx_frames=20, rx_malformed=5), 0)
+
+
+@pytest.mark.asyncio
+async def test_i2c_register_batch_split_and_merged(runtime_service: ServiceWithCapture) -> None:
+    service, published = runtime_service
+    sent: list[pb.I2cReadRegisters] = []
+
+    async def reply(command_id: int, batch: pb.I2cReadRegisters) -> bytes:
+        assert command_id == protocol.Command.CMD_I2C_READ_REGISTERS.value
+        sent.append(batch)
+        data = b"".join(bytes([r.reg]) * r.len for r in batch.reads)
+        return pb.I2cReadRegistersResponse(completed=len(batch.reads), data=data).SerializeToString()
+
+    _mock_serial(service).send.side_effect = reply
+
+    reads = [pb.I2cRegisterRead(reg=r, len=protocol.I2C_BATCH_MAX_BYTES // 2) for r in (1, 2, 3)]
+    request = pb.I2cReadRegisters(address=0x68, reads=reads)
+    await service.handle_request(_PublishPacket("br/i2c/registers", request.SerializeToString()))
+    # Two blocks fill a frame, so the third goes in a second request.
+    assert [len(b.reads) for b in sent] == [2, 1]
+    assert all(b.address == 0x68 for b in sent)
+    merged = pb.I2cReadRegistersResponse.FromString(published[0].payload)
+    assert published[0].topic_name.endswith("i2c/registers/resp")
+    assert merged.status == pb.I2C_OK
+    assert merged.completed == 3
+    assert merged.data[-1:] == b"\x03"
+    assert len(merged.data) == 3 * (protocol.I2C_BATCH_MAX_BYTES // 2)
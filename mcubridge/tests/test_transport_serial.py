@@ -98,6 +98,7 @@ async def test_process_packet_negotiation_ack_switches_local_baudrate() -> None:
         transport.serial = mock_serial
 
         setattr(transport, "_negotiating", True)
+        setattr(transport, "_negotiation_baud", config.serial_baud)
         setattr(transport, "_negotiation_future", asyncio.get_running_loop().create_future())
 
         encoded = cobsr.encode(
@@ -111,6 +112,7 @@ async def test_process_packet_negotiation_ack_switches_local_baudrate() -> None:
 
         assert await getattr(transport, "_negotiation_future")
         assert mock_serial.transport.serial.baudrate == config.serial_baud
+        assert transport.baudrate == config.serial_baud
     finally:
         state.cleanup()
 
@@ -225,3 +227,49 @@ async def test_process_packet_fallback_triggers_negotiation(
         getattr(transport, "_negotiate_baudrate").assert_awaited_once_with(57600)
     finally:
         state.cleanup()
+
+
+def test_bond_reorder_releases_in_order() -> None:
+    from mcubridge.transport.bond import BondReorder
+
+    bond: BondReorder[str] = BondReorder(4, 0.05)
+    assert bond.push(1, "a", 0.0) == ["a"]
+    assert bond.push(3, "c", 0.0) == []
+    assert bond.push(4, "d", 0.0) == []
+    assert bond.held == 2
+    assert bond.push(2, "b", 0.0) == ["b", "c", "d"]
+    # Already passed, and already held: both dropped.
+    assert bond.push(2, "b", 0.0) == []
+    assert bond.push(6, "f", 0.0) == []
+    assert bond.push(6, "f", 0.0) == []
+    assert bond.dropped == 2
+
+
+def test_bond_reorder_gives_up_on_gaps() -> None:
+    from mcubridge.transport.bond import BondReorder
+
+    bond: BondReorder[int] = BondReorder(4, 0.05)
+    assert bond.push(2, 2, 0.0) == []
+    assert bond.expire(0.01) == []
+    assert bond.expire(0.06) == [2]
+    # Past the window: held frames go first, then the window restarts.
+    assert bond.push(5, 5, 1.0) == []
+    assert bond.push(9, 9, 1.0) == [5, 9]
+    assert bond.push(1000, 1000, 2.0) == [1000]
+    # Close behind is a duplicate; far behind, the sender started over.
+    assert bond.push(900, 900, 2.0) == []
+    assert bond.push(1, 1, 2.0) == [1]
+    bond.reset()
+    assert bond.push(1, 1, 3.0) == [1]
+
+
+def test_bond_reorder_wraps_sequence() -> None:
+    from mcubridge.transport.bond import BondReorder
+
+    # bond_seq runs 1..65536: counter 65535 goes out as 65536, then 0 as 1.
+    bond: BondReorder[int] = BondReorder(4, 0.05)
+    assert bond.push(60000, -1, 0.0) == [-1]
+    assert bond.push(protocol.UINT16_MAX, 0, 0.0) == [0]
+    assert bond.push(1, 2, 0.0) == []
+    assert bond.push(protocol.UINT16_MAX + 1, 1, 0.0) == [1, 2]
+    assert bond.held == 0
@@ -1,8 +1,10 @@
 #include "SPI.h"
+#include "Wire.h"
 #include "Arduino.h"
 #include "BridgeFaultInjection.h"
 
 SPIClass SPI;
+TwoWire Wire;
 HardwareSerial Serial __attribute__((weak));
 HardwareSerial Serial1 __attribute__((weak));
 
@@ -14,6 +16,11 @@ unsigned long millis() {
     return bridge::test::fault::clock_ms();
 }
 
+unsigned long micros() __attribute__((weak));
+unsigned long micros() {
+    return millis() * 1000UL;
+}
+
 void delay(unsigned long ms) __attribute__((weak));
 void delay(unsigned long ms) {
     bridge::test::fault::advance_clock_ms(static_cast<uint32_t>(ms));
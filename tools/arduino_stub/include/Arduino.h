@@ -58,20 +58,33 @@ inline long round(T x) {
 // ARDUINO_STUB_CUSTOM_MILLIS before including Arduino headers.
 #ifdef ARDUINO_STUB_CUSTOM_MILLIS
 unsigned long millis();
+unsigned long micros();
 void delay(unsigned long);
 #else
 inline unsigned long millis() { return 0; }
+inline unsigned long micros() { return 0; }
 inline void delay(unsigned long) {}
 #endif
 // Fix: Comment out unused parameter name to avoid compiler warning
 inline void delayMicroseconds(unsigned int /*us*/) {}
 inline void yield() {}
+// Pin writes made while interrupts were enabled, for tests that check a
+// critical section covers its writes.
+inline bool interruptsEnabled();
+inline unsigned long& stubUnmaskedPinWrites() {
+  static unsigned long writes = 0;
+  return writes;
+}
 inline void pinMode(uint8_t, uint8_t) {}
-inline void digitalWrite(uint8_t, uint8_t) {}
+inline void digitalWrite(uint8_t, uint8_t) {
+  if (interruptsEnabled()) ++stubUnmaskedPinWrites();
+}
 inline int digitalRead(uint8_t) { return LOW; }
 
 // --- FIXED: Missing Analog Stubs ---
-inline void analogWrite(uint8_t, int) {}
+inline void analogWrite(uint8_t, int) {
+  if (interruptsEnabled()) ++stubUnmaskedPinWrites();
+}
 inline int analogRead(uint8_t) { return 0; }
 // -----------------------------------
 
@@ -252,8 +265,14 @@ constexpr T constrain(T value, T minimum, T maximum) {
   (bitvalue ? bitSet(value, bit) : bitClear(value, bit))
 
 // Interrupts (Stubs for host tests)
-// In a host test environment, we generally run single-threaded logic tests,
-// so disabling/enabling interrupts can be treated as no-ops.
-// These are required because Bridge.cpp uses them for atomic state access.
-inline void noInterrupts() {}
-inline void interrupts() {}
+// Nothing interrupts host code, but the mask is tracked (per thread, like a
+// core's) so tests can check that critical sections stay closed.
+// interruptsEnabled() is host-only: real cores have no such Arduino call.
+inline bool& _stubInterruptMask() {
+  static thread_local bool enabled = true;
+  return enabled;
+}
+inline void noInterrupts() { _stubInterruptMask() = false; }
+inline void interrupts() { _stubInterruptMask() = true; }
+inline bool interruptsEnabled() { return _stubInterruptMask(); }
+#define ARDUINO_STUB_INTERRUPT_MASK 1
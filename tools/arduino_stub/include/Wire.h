@@ -0,0 +1,82 @@
+#ifndef WIRE_STUB_H
+#define WIRE_STUB_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#define WIRE_HAS_TIMEOUT 1
+
+// Host stand-in for the Arduino Wire library: a single register-file device
+// (256 bytes, auto-incrementing pointer) answers at kDeviceAddress; every
+// other address NACKs. The first byte written in a transmission sets the
+// register pointer, the rest are stored from there.
+class TwoWire {
+public:
+    static constexpr uint8_t kDeviceAddress = 0x50;
+    static constexpr size_t kBufferLength = 32;
+
+    void begin() { _running = true; }
+    void end() { _running = false; }
+    void setClock(uint32_t clock) { _clock = clock; }
+    void setWireTimeout(uint32_t timeout_us = 25000, bool reset = false) {
+        (void)timeout_us; (void)reset;
+    }
+    bool getWireTimeoutFlag() { return false; }
+    void clearWireTimeoutFlag() {}
+
+    void beginTransmission(uint8_t address) {
+        _tx_address = address;
+        _tx_len = 0;
+    }
+    size_t write(uint8_t data) {
+        if (_tx_len >= kBufferLength) return 0;
+        _tx[_tx_len++] = data;
+        return 1;
+    }
+    size_t write(const uint8_t* data, size_t len) {
+        size_t n = 0;
+        while (n < len && write(data[n]) == 1) ++n;
+        return n;
+    }
+    uint8_t endTransmission(uint8_t sendStop = 1) {
+        (void)sendStop;
+        if (!_running) return 4;
+        if (_tx_address != kDeviceAddress) return 2;
+        if (_tx_len > 0) _pointer = _tx[0];
+        for (size_t i = 1; i < _tx_len; ++i) registers[_pointer++] = _tx[i];
+        return 0;
+    }
+    uint8_t requestFrom(uint8_t address, uint8_t quantity,
+                        uint8_t sendStop = 1) {
+        (void)sendStop;
+        _rx_len = 0;
+        _rx_pos = 0;
+        if (!_running || address != kDeviceAddress) return 0;
+        if (quantity > kBufferLength) quantity = kBufferLength;
+        for (uint8_t i = 0; i < quantity; ++i) _rx[_rx_len++] = registers[_pointer++];
+        return quantity;
+    }
+    int available() { return static_cast<int>(_rx_len - _rx_pos); }
+    int read() { return _rx_pos < _rx_len ? _rx[_rx_pos++] : -1; }
+
+    bool running() const { return _running; }
+    uint32_t clock() const { return _clock; }
+
+    uint8_t registers[256] = {};
+
+private:
+    bool _running = false;
+    uint32_t _clock = 100000;
+    uint8_t _tx_address = 0;
+    uint8_t _tx[kBufferLength] = {};
+    size_t _tx_len = 0;
+    uint8_t _rx[kBufferLength] = {};
+    size_t _rx_len = 0;
+    size_t _rx_pos = 0;
+    uint8_t _pointer = 0;
+};
+
+extern TwoWire Wire;
+
+#endif
@@ -79,9 +79,21 @@ SOURCES=(
     "${SRC_DIR}/services/Console.cpp"
     "${SRC_DIR}/services/DataStore.cpp"
     "${SRC_DIR}/services/Mailbox.cpp"
+    "${SRC_DIR}/services/PinEvents.cpp"
+    "${SRC_DIR}/services/Events.cpp"
+    "${SRC_DIR}/services/Sampler.cpp"
+    "${SRC_DIR}/services/Telemetry.cpp"
+    "${SRC_DIR}/services/Aggregator.cpp"
+    "${SRC_DIR}/services/Reflex.cpp"
+    "${SRC_DIR}/services/Timeline.cpp"
+    "${SRC_DIR}/services/Waveform.cpp"
+    "${SRC_DIR}/services/LoopProfiler.cpp"
     "${SRC_DIR}/services/FileSystem.cpp"
     "${SRC_DIR}/services/Process.cpp"
     "${SRC_DIR}/services/SPIService.cpp"
+    "${SRC_DIR}/services/I2CService.cpp"
+    "${SRC_DIR}/services/KVStore.cpp"
+    "${SRC_DIR}/services/FrameTrace.cpp"
     "${ROOT_DIR}/tools/arduino_stub/BridgeFaultInjection.cpp"
     "${TEST_DIR}/test_host_filesystem_mock.cpp"
     "${ROOT_DIR}/tools/arduino_stub/ArduinoStubs.cpp"
@@ -106,6 +118,13 @@ BASE_FLAGS=(
     -Werror
     -Wno-unused-parameter
     -DBRIDGE_FAULT_INJECTION=1
+    -DBRIDGE_ENABLE_LOOP_PROFILER=1
+    -DBRIDGE_ENABLE_I2C=1
+    -DBRIDGE_ENABLE_EEPROM=1
+    -DBRIDGE_ENABLE_FRAME_TRACE=1
+    -DBRIDGE_BOND_MAX_LINKS=2
+    -DBRIDGE_ENABLE_THREADED=1
+    -pthread
     -DARDUINO_STUB_CUSTOM_MILLIS=1
     -DWOLFSSL_USER_SETTINGS
     -DETL_NO_STL
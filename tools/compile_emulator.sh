@@ -66,7 +66,11 @@ NANOPB_SOURCES=(
 )
 
 echo "[emulator] Compiling native bridge emulator (Base)..."
+# The base emulator doubles as the process() benchmark: it prints the loop
+# profiler histograms to stderr when it exits. Its KV store lives in
+# /tmp/mcubridge-host-eeprom.bin and survives restarts like a real EEPROM.
 g++ -std=c++17 -O2 -g -Wall -Wextra -Werror -DBRIDGE_HOST_TEST=1 -DARDUINO=100 -DARDUINO_STUB_CUSTOM_MILLIS=1 -DARDUINO_STUB_CUSTOM_SERIAL=1 \
+    -DBRIDGE_ENABLE_LOOP_PROFILER=1 -DBRIDGE_ENABLE_EEPROM=1 -DBRIDGE_ENABLE_FRAME_TRACE=1 \
     -DNUM_DIGITAL_PINS=20 -DNUM_ANALOG_INPUTS=6  -DWOLFSSL_USER_SETTINGS -DETL_NO_STL \
     -I"${SRC_DIR}" \
     -I"${SRC_DIR}/config" \
@@ -90,9 +94,21 @@ g++ -std=c++17 -O2 -g -Wall -Wextra -Werror -DBRIDGE_HOST_TEST=1 -DARDUINO=100 -
     "${SRC_DIR}/services/Console.cpp" \
     "${SRC_DIR}/services/DataStore.cpp" \
     "${SRC_DIR}/services/Mailbox.cpp" \
+    "${SRC_DIR}/services/PinEvents.cpp" \
+    "${SRC_DIR}/services/Events.cpp" \
+    "${SRC_DIR}/services/Sampler.cpp" \
+    "${SRC_DIR}/services/Telemetry.cpp" \
+    "${SRC_DIR}/services/Aggregator.cpp" \
+    "${SRC_DIR}/services/Reflex.cpp" \
+    "${SRC_DIR}/services/Timeline.cpp" \
+    "${SRC_DIR}/services/Waveform.cpp" \
+    "${SRC_DIR}/services/LoopProfiler.cpp" \
     "${SRC_DIR}/services/FileSystem.cpp" \
     "${LIB_DIR}/src/services/Process.cpp" \
     "${LIB_DIR}/src/services/SPIService.cpp" \
+    "${LIB_DIR}/src/services/I2CService.cpp" \
+    "${LIB_DIR}/src/services/KVStore.cpp" \
+    "${LIB_DIR}/src/services/FrameTrace.cpp" \
     "${TEST_DIR}/test_host_filesystem_mock.cpp" \
     "${ROOT_DIR}/tools/arduino_stub/BridgeFaultInjection.cpp" \
     "${ROOT_DIR}/tools/arduino_stub/ArduinoStubs.cpp" \
@@ -124,9 +140,21 @@ g++ -std=c++17 -O2 -g -Wall -Wextra -Werror -DBRIDGE_HOST_TEST=1 -DARDUINO=100 -
     "${SRC_DIR}/services/Console.cpp" \
     "${SRC_DIR}/services/DataStore.cpp" \
     "${SRC_DIR}/services/Mailbox.cpp" \
+    "${SRC_DIR}/services/PinEvents.cpp" \
+    "${SRC_DIR}/services/Events.cpp" \
+    "${SRC_DIR}/services/Sampler.cpp" \
+    "${SRC_DIR}/services/Telemetry.cpp" \
+    "${SRC_DIR}/services/Aggregator.cpp" \
+    "${SRC_DIR}/services/Reflex.cpp" \
+    "${SRC_DIR}/services/Timeline.cpp" \
+    "${SRC_DIR}/services/Waveform.cpp" \
+    "${SRC_DIR}/services/LoopProfiler.cpp" \
     "${SRC_DIR}/services/FileSystem.cpp" \
     "${LIB_DIR}/src/services/Process.cpp" \
     "${LIB_DIR}/src/services/SPIService.cpp" \
+    "${LIB_DIR}/src/services/I2CService.cpp" \
+    "${LIB_DIR}/src/services/KVStore.cpp" \
+    "${LIB_DIR}/src/services/FrameTrace.cpp" \
     "${TEST_DIR}/test_host_filesystem_mock.cpp" \
     "${ROOT_DIR}/tools/arduino_stub/BridgeFaultInjection.cpp" \
     "${ROOT_DIR}/tools/arduino_stub/ArduinoStubs.cpp" \
@@ -42,9 +42,21 @@ BRIDGE_SOURCES=(
     "${SRC_ROOT}/services/Console.cpp"
     "${SRC_ROOT}/services/DataStore.cpp"
     "${SRC_ROOT}/services/Mailbox.cpp"
+    "${SRC_ROOT}/services/PinEvents.cpp"
+    "${SRC_ROOT}/services/Events.cpp"
+    "${SRC_ROOT}/services/Sampler.cpp"
+    "${SRC_ROOT}/services/Telemetry.cpp"
+    "${SRC_ROOT}/services/Aggregator.cpp"
+    "${SRC_ROOT}/services/Reflex.cpp"
+    "${SRC_ROOT}/services/Timeline.cpp"
+    "${SRC_ROOT}/services/Waveform.cpp"
+    "${SRC_ROOT}/services/LoopProfiler.cpp"
     "${SRC_ROOT}/services/FileSystem.cpp"
     "${SRC_ROOT}/services/Process.cpp"
     "${SRC_ROOT}/services/SPIService.cpp"
+    "${SRC_ROOT}/services/I2CService.cpp"
+    "${SRC_ROOT}/services/KVStore.cpp"
+    "${SRC_ROOT}/services/FrameTrace.cpp"
     "${ROOT_DIR}/tools/arduino_stub/BridgeFaultInjection.cpp"
     "${ROOT_DIR}/tools/arduino_stub/ArduinoStubs.cpp"
 )
@@ -78,6 +90,9 @@ BASE_FLAGS=(
     "-DBRIDGE_ENABLE_CONSOLE=1" "-DBRIDGE_ENABLE_DATASTORE=1"
     "-DBRIDGE_ENABLE_MAILBOX=1" "-DBRIDGE_ENABLE_FILESYSTEM=1"
     "-DBRIDGE_ENABLE_PROCESS=1" "-DBRIDGE_ENABLE_SPI=1"
+    "-DBRIDGE_ENABLE_LOOP_PROFILER=1" "-DBRIDGE_ENABLE_I2C=1" "-DBRIDGE_ENABLE_EEPROM=1"
+    "-DBRIDGE_ENABLE_FRAME_TRACE=1" "-DBRIDGE_BOND_MAX_LINKS=2"
+    "-DBRIDGE_ENABLE_THREADED=1" "-pthread"
     "-DUNITY_INCLUDE_DOUBLE"
     "-I${SRC_ROOT}" "-I${SRC_ROOT}/config" "-I${SRC_ROOT}/protocol"
     "-I${STUB_INCLUDE}" "-I${TEST_ROOT}"
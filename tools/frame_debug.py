@@ -4,15 +4,18 @@ from __future__ import annotations
 
 import argparse
 import binascii
+import struct
 import sys
 from collections.abc import Iterable
 from dataclasses import dataclass
 
 import serialx
+from google.protobuf.message import DecodeError as ProtobufDecodeError
 from google.protobuf.message import Message as ProtobufMessage
 
 # [SIL-2] Use direct library functions for framing
 from cobs import cobs
+from mcubridge.protocol import mcubridge_pb2 as pb
 from mcubridge.protocol import protocol
 from mcubridge.protocol.frame import build_frame, parse_frame, DecodedFrame
 from mcubridge.protocol.protocol import DEFAULT_BAUDRATE, FRAME_DELIMITER
@@ -142,6 +145,94 @@ def _print_response(decoded: DecodedFrame) -> None:
     )
 
 
+# One CMD_GET_FRAME_TRACE record: t_us, command, sequence, length,
+# direction << 6 | result, FSM state (see FrameTrace in mcubridge.proto).
+_TRACE_RECORD = struct.Struct("<IHHBBB")
+# bridge::fsm::StateId on the MCU.
+_FSM_STATES = ("STARTUP", "UNSYNCHRONIZED", "HANDSHAKE", "SYNCHRONIZED", "AWAITING_ACK", "FAULT")
+
+
+@dataclass(frozen=True)
+class TraceEvent:
+    index: int
+    t_us: int
+    command_id: int
+    sequence_id: int
+    length: int
+    direction: int
+    result: int
+    state: int
+
+    def render(self, prev_t_us: int | None = None) -> str:
+        """Renders the event as one line, with the time since prev_t_us."""
+        delta = "" if prev_t_us is None else f"+{(self.t_us - prev_t_us) & 0xFFFFFFFF}us"
+        direction = {
+            pb.FRAME_TRACE_RX: "RX",
+            pb.FRAME_TRACE_TX: "TX",
+            pb.FRAME_TRACE_EVENT: "--",
+        }.get(self.direction, "??")
+        try:
+            result = pb.FrameTraceResult.Name(self.result).removeprefix("FRAME_TRACE_")
+        except ValueError:
+            result = f"RESULT({self.result})"
+        state = _FSM_STATES[self.state] if self.state < len(_FSM_STATES) else f"STATE({self.state})"
+        what = "" if self.direction == pb.FRAME_TRACE_EVENT else f"{name_for_command(self.command_id)} "
+        return (
+            f"#{self.index:<6} {self.t_us:>10}us {delta:>10} {direction} {what}"
+            f"seq={self.sequence_id} len={self.length} {result} [{state}]"
+        )
+
+
+def decode_trace(trace: pb.FrameTrace) -> list[TraceEvent]:
+    """Decodes the packed records of a FrameTrace, oldest first."""
+    size = _TRACE_RECORD.size
+    if size != protocol.FRAME_TRACE_RECORD_SIZE:
+        raise ValueError("FrameTrace record layout does not match the protocol")
+    events: list[TraceEvent] = []
+    for n, offset in enumerate(range(0, len(trace.events) - size + 1, size)):
+        t_us, command, sequence, length, flags, state = _TRACE_RECORD.unpack_from(trace.events, offset)
+        events.append(
+            TraceEvent(
+                index=trace.start + n,
+                t_us=t_us,
+                command_id=command,
+                sequence_id=sequence,
+                length=length,
+                direction=flags >> 6,
+                result=flags & 0x3F,
+                state=state,
+            )
+        )
+    return events
+
+
+def render_trace(trace: pb.FrameTrace) -> str:
+    """Renders a FrameTrace as a table, with gaps between events."""
+    lines = [f"[FrameDebug] Frame trace: events {trace.start}..{trace.end}"]
+    prev: int | None = None
+    for event in decode_trace(trace):
+        # Timestamps restart on every boot, so a delta across it means nothing.
+        if event.result == pb.FRAME_TRACE_BOOT:
+            prev = None
+        lines.append(event.render(prev))
+        prev = event.t_us
+    return "\n".join(lines)
+
+
+def run_decode_trace(path: str) -> None:
+    try:
+        if path == "-":
+            data = sys.stdin.buffer.read()
+        else:
+            with open(path, "rb") as fh:
+                data = fh.read()
+        trace = pb.FrameTrace.FromString(data)
+    except (OSError, ProtobufDecodeError) as e:
+        sys.stderr.write(f"Error: {e}\n")
+        sys.exit(1)
+    sys.stdout.write(f"{render_trace(trace)}\n")
+
+
 def _iter_counts(count: int) -> Iterable[int]:
     if count == 0:
         iteration = 0
@@ -215,14 +306,25 @@ def main() -> None:
     parser = argparse.ArgumentParser(description="MCU Bridge Frame Debugger")
     parser.add_argument("--port", help="Serial port device (e.g. /dev/ttyATH0)")
     parser.add_argument("--baudrate", type=int, default=DEFAULT_BAUDRATE, help="Baudrate")
-    parser.add_argument("--command", required=True, help="Command ID (hex, int, or name)")
+    parser.add_argument("--command", help="Command ID (hex, int, or name)")
     parser.add_argument("--payload", default="", help="Payload hex string")
     parser.add_argument("--interval", type=float, default=1.0, help="Interval between frames")
     parser.add_argument("--count", type=int, default=1, help="Number of frames (0 for infinite)")
     parser.add_argument("--generate", action="store_true", help="Only generate and print frame")
+    parser.add_argument(
+        "--decode-trace",
+        metavar="FILE",
+        help="Decode a FrameTrace published on system/frame_trace/value ('-' for stdin)",
+    )
 
     args = parser.parse_args()
 
+    if args.decode_trace:
+        run_decode_trace(args.decode_trace)
+        return
+    if not args.command:
+        parser.error("--command is required")
+
     if args.generate:
         asyncio.run(run_generate_only(args.command, args.payload))
     elif args.port: